@@ -0,0 +1,123 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Text.Encodings.Web;
+using System.Text.Json;
+using Foster.Framework;
+
+namespace Foster.Benchmarks;
+
+/// <summary>
+/// Times Benchmarks with a Stopwatch and collects their results, which can be written as JSON
+/// </summary>
+public class BenchmarkRunner(int iterations, int warmup, string? filter)
+{
+	public readonly record struct Result(
+		string Name,
+		int Operations,
+		int Iterations,
+		double MeanMs,
+		double MedianMs,
+		double MinMs,
+		double MaxMs,
+		double StdDevMs,
+		long AllocatedBytes
+	)
+	{
+		public double OpsPerSecond => MeanMs > 0 ? Operations * 1000.0 / MeanMs : 0;
+	}
+
+	public readonly List<Result> Results = [];
+
+	/// <summary>
+	/// If any Benchmark whose name starts with the given prefix passes the filter,
+	/// so that setup for Benchmarks that won't run can be skipped
+	/// </summary>
+	public bool Includes(string prefix)
+		=> filter == null || prefix.Contains(filter, StringComparison.OrdinalIgnoreCase) || filter.StartsWith(prefix, StringComparison.OrdinalIgnoreCase);
+
+	/// <summary>
+	/// Runs the Action a number of times and records how long each run took.
+	/// The Operations are how much work a single run does, to derive a throughput.
+	/// </summary>
+	public void Run(string name, int operations, Action action)
+	{
+		if (!Includes(name))
+			return;
+
+		for (int i = 0; i < warmup; i ++)
+			action();
+
+		// don't let garbage from setup or warmup get collected during the timed runs
+		GC.Collect();
+		GC.WaitForPendingFinalizers();
+		GC.Collect();
+
+		var samples = new double[iterations];
+		var allocated = GC.GetAllocatedBytesForCurrentThread();
+
+		for (int i = 0; i < iterations; i ++)
+		{
+			var start = Stopwatch.GetTimestamp();
+			action();
+			samples[i] = Stopwatch.GetElapsedTime(start).TotalMilliseconds;
+		}
+
+		allocated = GC.GetAllocatedBytesForCurrentThread() - allocated;
+
+		Array.Sort(samples);
+		var mean = samples.Average();
+		var variance = samples.Sum(it => (it - mean) * (it - mean)) / samples.Length;
+
+		var result = new Result(
+			Name: name,
+			Operations: operations,
+			Iterations: iterations,
+			MeanMs: mean,
+			MedianMs: samples[samples.Length / 2],
+			MinMs: samples[0],
+			MaxMs: samples[^1],
+			StdDevMs: Math.Sqrt(variance),
+			AllocatedBytes: allocated / iterations
+		);
+
+		Results.Add(result);
+		Console.Error.WriteLine($"{name,-36} {result.MeanMs,10:F3} ms  ±{result.StdDevMs:F3}  {result.OpsPerSecond,14:N0} ops/s");
+	}
+
+	/// <summary>
+	/// Writes the results, along with what they were run on
+	/// </summary>
+	public void Write(Stream stream, string renderer)
+	{
+		using var json = new Utf8JsonWriter(stream, new JsonWriterOptions { Indented = true, Encoder = JavaScriptEncoder.UnsafeRelaxedJsonEscaping });
+
+		json.WriteStartObject();
+		json.WriteString("suite", "Foster.Framework");
+		json.WriteString("version", App.Version.ToString());
+		json.WriteString("runtime", RuntimeInformation.FrameworkDescription);
+		json.WriteString("os", RuntimeInformation.OSDescription);
+		json.WriteString("architecture", RuntimeInformation.ProcessArchitecture.ToString());
+		json.WriteString("renderer", renderer);
+		json.WriteString("timestamp", DateTime.UtcNow.ToString("O"));
+
+		json.WriteStartArray("results");
+		foreach (var it in Results)
+		{
+			json.WriteStartObject();
+			json.WriteString("name", it.Name);
+			json.WriteNumber("operations", it.Operations);
+			json.WriteNumber("iterations", it.Iterations);
+			json.WriteNumber("meanMs", it.MeanMs);
+			json.WriteNumber("medianMs", it.MedianMs);
+			json.WriteNumber("minMs", it.MinMs);
+			json.WriteNumber("maxMs", it.MaxMs);
+			json.WriteNumber("stdDevMs", it.StdDevMs);
+			json.WriteNumber("opsPerSecond", it.OpsPerSecond);
+			json.WriteNumber("allocatedBytes", it.AllocatedBytes);
+			json.WriteEndObject();
+		}
+		json.WriteEndArray();
+
+		json.WriteEndObject();
+	}
+}
@@ -0,0 +1,96 @@
+using Foster.Framework;
+
+namespace Foster.Benchmarks;
+
+/// <summary>
+/// Benchmarks that don't need a window or renderer, and so also run headless
+/// </summary>
+public static class CpuBenchmarks
+{
+	public const int SpriteCount = 10000;
+	public const int ImageSize = 512;
+
+	public static void Run(BenchmarkRunner runner)
+	{
+		RunPacker(runner);
+		RunImages(runner);
+		RunAseprite(runner);
+	}
+
+	private static void RunPacker(BenchmarkRunner runner)
+	{
+		if (!runner.Includes("Packer."))
+			return;
+
+		var sprites = SyntheticAssets.Sprites(SpriteCount);
+
+		foreach (var method in Enum.GetValues<Packer.PackingMethod>())
+		{
+			runner.Run($"Packer.Pack/{method}", SpriteCount, () =>
+			{
+				var packer = new Packer { Method = method, CombineDuplicates = true };
+				packer.AddRange(sprites);
+				var output = packer.Pack();
+				foreach (var page in output.Pages)
+					page.Dispose();
+			});
+		}
+
+		foreach (var (_, image) in sprites)
+			image.Dispose();
+	}
+
+	private static void RunImages(BenchmarkRunner runner)
+	{
+		if (!runner.Includes("Image."))
+			return;
+
+		using var image = SyntheticAssets.Gradient(ImageSize, ImageSize);
+		var png = SyntheticAssets.Png(image);
+		var qoi = SyntheticAssets.Qoi(image);
+
+		runner.Run("Image.Load/PNG", 1, () =>
+		{
+			using var loaded = new Image(new MemoryStream(png));
+		});
+
+		runner.Run("Image.Load/QOI", 1, () =>
+		{
+			using var loaded = new Image(new MemoryStream(qoi));
+		});
+
+		runner.Run("Image.LoadParallel/PNG x64", 64, () =>
+		{
+			foreach (var loaded in Image.LoadParallel(Enumerable.Repeat(png, 64).ToArray()))
+				loaded.Dispose();
+		});
+	}
+
+	private static void RunAseprite(BenchmarkRunner runner)
+	{
+		if (!runner.Includes("Aseprite."))
+			return;
+
+		const int Frames = 16;
+		const int Layers = 4;
+		var data = SyntheticAssets.Aseprite(256, 256, Frames, Layers);
+
+		runner.Run("Aseprite.Parse", Frames * Layers, () =>
+		{
+			_ = new Aseprite(new MemoryStream(data));
+		});
+
+		runner.Run("Aseprite.Open+DecodeAsync", Frames * Layers, () =>
+		{
+			using var ase = Aseprite.Open(new MappedFile(new MemoryStream(data)));
+			ase.DecodeAsync().Wait();
+		});
+
+		var parsed = new Aseprite(new MemoryStream(data));
+		runner.Run("Aseprite.RenderFrames", Frames, () =>
+		{
+			foreach (var frame in parsed.RenderFrames(0, Frames - 1))
+				frame.Dispose();
+		});
+	}
+}
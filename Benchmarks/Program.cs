@@ -0,0 +1,66 @@
+using Foster.Framework;
+
+namespace Foster.Benchmarks;
+
+/// <summary>
+/// Runs the Foster Benchmarks and writes their results as JSON, to stdout or the given file.
+/// Usage: Foster.Benchmarks [--headless] [--output &lt;file&gt;] [--filter &lt;name&gt;] [--iterations &lt;count&gt;] [--renderer &lt;name&gt;]
+/// </summary>
+public static class Program
+{
+	public static int Main(string[] args)
+	{
+		var headless = false;
+		var iterations = 20;
+		var renderer = Renderers.None;
+		string? output = null;
+		string? filter = null;
+
+		for (int i = 0; i < args.Length; i ++)
+		{
+			var arg = args[i];
+			var hasValue = i + 1 < args.Length;
+
+			if (arg == "--headless")
+				headless = true;
+			else if (arg == "--output" && hasValue)
+				output = args[++i];
+			else if (arg == "--filter" && hasValue)
+				filter = args[++i];
+			else if (arg == "--iterations" && hasValue && int.TryParse(args[++i], out var count) && count > 0)
+				iterations = count;
+			else if (arg == "--renderer" && hasValue && Enum.TryParse(args[++i], true, out Renderers value))
+				renderer = value;
+			else
+			{
+				Console.Error.WriteLine("Usage: Foster.Benchmarks [--headless] [--output <file>] [--filter <name>] [--iterations <count>] [--renderer <name>]");
+				return 1;
+			}
+		}
+
+		var runner = new BenchmarkRunner(iterations, warmup: 3, filter);
+
+		CpuBenchmarks.Run(runner);
+
+		if (!headless)
+		{
+			RenderBenchmarks.Runner = runner;
+			App.Run<RenderBenchmarks>("Foster Benchmarks", 1280, 720, false, renderer);
+		}
+
+		var rendererName = RenderBenchmarks.Renderer.ToString();
+		if (output != null)
+		{
+			using var file = File.Create(output);
+			runner.Write(file, rendererName);
+		}
+		else
+		{
+			using var stdout = Console.OpenStandardOutput();
+			runner.Write(stdout, rendererName);
+			Console.WriteLine();
+		}
+
+		return 0;
+	}
+}
@@ -0,0 +1,166 @@
+using System.Numerics;
+using Foster.Framework;
+
+namespace Foster.Benchmarks;
+
+/// <summary>
+/// Benchmarks that need a renderer. They run once the App has started, draw into an
+/// offscreen Target, and then exit the App. The times are how long the CPU takes to
+/// build and submit the draws, not how long the GPU takes to execute them.
+/// </summary>
+public class RenderBenchmarks : Module
+{
+	public const int QuadCount = 100000;
+	public const int DrawCount = 10000;
+
+	/// <summary>
+	/// Where the results are recorded, assigned before the App is run
+	/// </summary>
+	public static BenchmarkRunner? Runner;
+
+	/// <summary>
+	/// The Renderer the benchmarks ran on
+	/// </summary>
+	public static Renderers Renderer { get; private set; } = Renderers.None;
+
+	public override void Render()
+	{
+		if (App.Exiting || Runner == null)
+			return;
+
+		Renderer = Graphics.Renderer;
+		using var target = new Target(1280, 720);
+		Batcher.CreateShaders();
+
+		RunBatcher(Runner, target);
+		RunText(Runner, target);
+		RunDraw(Runner, target);
+
+		App.Exit();
+	}
+
+	private static void RunBatcher(BenchmarkRunner runner, Target target)
+	{
+		var batch = new Batcher();
+		var rng = new Rng(1);
+		var rects = new Rect[QuadCount];
+		var colors = new Color[QuadCount];
+		for (int i = 0; i < QuadCount; i ++)
+		{
+			rects[i] = new Rect(rng.Float(target.Width), rng.Float(target.Height), 4 + rng.Float(28), 4 + rng.Float(28));
+			colors[i] = new Color(rng.U8(), rng.U8(), rng.U8(), 255);
+		}
+
+		runner.Run("Batcher.Rect", QuadCount, () =>
+		{
+			batch.Clear();
+			for (int i = 0; i < QuadCount; i ++)
+				batch.Rect(rects[i], colors[i]);
+		});
+
+		runner.Run("Batcher.Rect+Render", QuadCount, () =>
+		{
+			batch.Clear();
+			for (int i = 0; i < QuadCount; i ++)
+				batch.Rect(rects[i], colors[i]);
+			batch.Render(target);
+		});
+
+		using var image = SyntheticAssets.Gradient(64, 64);
+		using var texture = new Texture(image);
+		runner.Run("Batcher.Image+Render", QuadCount, () =>
+		{
+			batch.Clear();
+			for (int i = 0; i < QuadCount; i ++)
+				batch.Image(texture, rects[i].Position, colors[i]);
+			batch.Render(target);
+		});
+
+		batch.Dispose();
+	}
+
+	private static void RunText(BenchmarkRunner runner, Target target)
+	{
+		using var texture = new Texture(128, 128, Enumerable.Repeat(Color.White, 128 * 128).ToArray());
+		var font = new SpriteFont(12) { Ascent = 10, Descent = -2 };
+		for (int cp = 32; cp < 127; cp ++)
+		{
+			var index = cp - 32;
+			var clip = new Rect(index % 16 * 8, index / 16 * 12, 8, 12);
+			font.AddCharacter(cp, 8, Vector2.Zero, new Subtexture(texture, clip));
+		}
+
+		var text = string.Concat(Enumerable.Repeat("The quick brown fox jumps over the lazy dog. 0123456789\n", 32));
+		var glyphs = text.Count(it => it != '\n');
+		var batch = new Batcher();
+
+		runner.Run("SpriteFont.RenderText", glyphs, () =>
+		{
+			batch.Clear();
+			font.RenderText(batch, text, Vector2.Zero, Color.White);
+			batch.Render(target);
+		});
+
+		var layout = new TextLayout(font, text);
+		runner.Run("TextLayout.Render", glyphs, () =>
+		{
+			batch.Clear();
+			layout.Render(batch, Vector2.Zero, Color.White);
+			batch.Render(target);
+		});
+
+		batch.Dispose();
+	}
+
+	private static void RunDraw(BenchmarkRunner runner, Target target)
+	{
+		// the shader here is GLSL, so only the OpenGL renderer can run this
+		if (Graphics.Renderer != Renderers.OpenGL)
+			return;
+
+		using var shader = new Shader(new ShaderCreateInfo(
+			vertexShader:
+				@"#version 330
+				uniform mat4 u_matrix;
+				layout(location=0) in vec2 a_position;
+				layout(location=2) in vec4 a_color;
+				out vec4 v_col;
+				void main(void)
+				{
+					gl_Position = u_matrix * vec4(a_position.xy, 0, 1);
+					v_col = a_color;
+				}",
+			fragmentShader:
+				@"#version 330
+				in vec4 v_col;
+				out vec4 o_color;
+				void main(void)
+				{
+					o_color = v_col;
+				}"
+		));
+		using var mesh = new Mesh();
+
+		mesh.SetVertices<Batcher.Vertex>([
+			new(new(0, 0), new(0, 0), Color.White, new(0, 0, 255, 0)),
+			new(new(16, 0), new(1, 0), Color.White, new(0, 0, 255, 0)),
+			new(new(16, 16), new(1, 1), Color.White, new(0, 0, 255, 0)),
+			new(new(0, 16), new(0, 1), Color.White, new(0, 0, 255, 0)),
+		]);
+		mesh.SetIndices<int>([0, 1, 2, 0, 2, 3]);
+
+		var material = new Material(shader);
+		material.Set("u_matrix", Matrix4x4.CreateOrthographicOffCenter(0, target.Width, target.Height, 0, 0, float.MaxValue));
+
+		runner.Run("Graphics.Submit", DrawCount, () =>
+		{
+			var command = new DrawCommand(target, mesh, material);
+			for (int i = 0; i < DrawCount; i ++)
+			{
+				// alternate the scissor so consecutive draws can't be merged into one
+				command.Scissor = (i & 1) == 0 ? null : new RectInt(0, 0, 64, 64);
+				command.Submit();
+			}
+		});
+	}
+}
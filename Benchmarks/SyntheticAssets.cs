@@ -0,0 +1,188 @@
+using System.IO.Compression;
+using System.Text;
+using Foster.Framework;
+
+namespace Foster.Benchmarks;
+
+/// <summary>
+/// Generates the data the Benchmarks run on, so they don't depend on any files
+/// and give the same results from one run to the next
+/// </summary>
+public static class SyntheticAssets
+{
+	/// <summary>
+	/// Sprites of varied sizes with transparent borders to trim, where every
+	/// tenth one repeats an earlier sprite so there are duplicates to combine
+	/// </summary>
+	public static List<(string Name, Image Image)> Sprites(int count, int seed = 1)
+	{
+		var rng = new Rng(seed);
+		var sprites = new List<(string Name, Image Image)>(count);
+
+		for (int i = 0; i < count; i ++)
+		{
+			if (i >= 10 && i % 10 == 0)
+			{
+				var repeat = sprites[rng.Int(i)].Image;
+				var copy = new Image(repeat.Width, repeat.Height);
+				copy.CopyPixels(repeat, Point2.Zero);
+				sprites.Add(($"sprite{i}", copy));
+				continue;
+			}
+
+			var image = new Image(rng.Int(4, 48), rng.Int(4, 48));
+			var border = rng.Int(0, Math.Min(image.Width, image.Height) / 4);
+			var color = new Color(rng.U8(), rng.U8(), rng.U8(), 255);
+
+			for (int y = border; y < image.Height - border; y ++)
+			for (int x = border; x < image.Width - border; x ++)
+				image[x, y] = (x + y) % 3 == 0 ? Color.White : color;
+
+			sprites.Add(($"sprite{i}", image));
+		}
+
+		return sprites;
+	}
+
+	/// <summary>
+	/// A noisy gradient, so encoders can't collapse it into a few runs
+	/// </summary>
+	public static Image Gradient(int width, int height, int seed = 1)
+	{
+		var rng = new Rng(seed);
+		var image = new Image(width, height);
+
+		for (int y = 0; y < height; y ++)
+		for (int x = 0; x < width; x ++)
+			image[x, y] = new Color((byte)(x * 255 / width), (byte)(y * 255 / height), rng.U8(64), 255);
+
+		return image;
+	}
+
+	/// <summary>
+	/// Encodes the Image as a PNG
+	/// </summary>
+	public static byte[] Png(Image image)
+	{
+		using var stream = new MemoryStream();
+		image.WritePng(stream);
+		return stream.ToArray();
+	}
+
+	/// <summary>
+	/// Encodes the Image as a QOI
+	/// </summary>
+	public static byte[] Qoi(Image image)
+	{
+		using var stream = new MemoryStream();
+		image.WriteQoi(stream);
+		return stream.ToArray();
+	}
+
+	/// <summary>
+	/// Writes an RGBA Aseprite file with a compressed Cel for every Layer on every Frame
+	/// </summary>
+	public static byte[] Aseprite(int width, int height, int frameCount, int layerCount, int seed = 1)
+	{
+		using var stream = new MemoryStream();
+		using var bin = new BinaryWriter(stream);
+
+		// Aseprite sizes come before their contents, so they're written once the contents are known
+		long BeginSized() { var at = stream.Position; bin.Write(0u); return at; }
+		void EndSized(long at) { var end = stream.Position; stream.Position = at; bin.Write((uint)(end - at)); stream.Position = end; }
+		void WriteString(string value) { var bytes = Encoding.UTF8.GetBytes(value); bin.Write((ushort)bytes.Length); bin.Write(bytes); }
+
+		// File header
+		var file = BeginSized();
+		bin.Write((ushort)0xA5E0);
+		bin.Write((ushort)frameCount);
+		bin.Write((ushort)width);
+		bin.Write((ushort)height);
+		bin.Write((ushort)32); // Color depth
+		bin.Write(1u); // Flags
+		bin.Write((ushort)100); // Speed
+		bin.Write(0u);
+		bin.Write(0u);
+		bin.Write((byte)0); // Transparent Color Index
+		bin.Write(new byte[3]);
+		bin.Write((ushort)0); // Color Count
+		bin.Write((byte)1); // Pixel width
+		bin.Write((byte)1); // Pixel height
+		bin.Write((short)0); // Grid X
+		bin.Write((short)0); // Grid Y
+		bin.Write((ushort)16); // Grid width
+		bin.Write((ushort)16); // Grid height
+		bin.Write(new byte[84]);
+
+		var gradient = Gradient(width, height, seed);
+		var pixels = new byte[width * height * 4];
+
+		for (int f = 0; f < frameCount; f ++)
+		{
+			var chunkCount = layerCount + (f == 0 ? layerCount : 0);
+
+			// Frame header
+			var frame = BeginSized();
+			bin.Write((ushort)0xF1FA);
+			bin.Write((ushort)chunkCount);
+			bin.Write((ushort)100); // Duration
+			bin.Write(new byte[2]);
+			bin.Write((uint)chunkCount);
+
+			// Layers are defined in the first Frame
+			if (f == 0)
+			{
+				for (int l = 0; l < layerCount; l ++)
+				{
+					var chunk = BeginSized();
+					bin.Write((ushort)0x2004);
+					bin.Write((ushort)1); // Flags (Visible)
+					bin.Write((ushort)0); // Type (Normal)
+					bin.Write((ushort)0); // Child Level
+					bin.Write((ushort)0); // Default Width
+					bin.Write((ushort)0); // Default Height
+					bin.Write((ushort)0); // Blend Mode
+					bin.Write((byte)255); // Opacity
+					bin.Write(new byte[3]);
+					WriteString($"layer{l}");
+					EndSized(chunk);
+				}
+			}
+
+			for (int l = 0; l < layerCount; l ++)
+			{
+				// shift the gradient so each Cel's contents differ
+				for (int i = 0, offset = (f * layerCount + l) * 7; i < width * height; i ++)
+				{
+					var color = gradient.Data[(i + offset) % gradient.Data.Length];
+					pixels[i * 4 + 0] = color.R;
+					pixels[i * 4 + 1] = color.G;
+					pixels[i * 4 + 2] = color.B;
+					pixels[i * 4 + 3] = color.A;
+				}
+
+				var chunk = BeginSized();
+				bin.Write((ushort)0x2005);
+				bin.Write((ushort)l); // Layer Index
+				bin.Write((short)0); // X
+				bin.Write((short)0); // Y
+				bin.Write((byte)255); // Opacity
+				bin.Write((ushort)Framework.Aseprite.CelType.CompressedImage);
+				bin.Write((short)0); // Z-Index
+				bin.Write(new byte[5]);
+				bin.Write((ushort)width);
+				bin.Write((ushort)height);
+				bin.Flush();
+				using (var zip = new ZLibStream(stream, CompressionLevel.Fastest, true))
+					zip.Write(pixels);
+				EndSized(chunk);
+			}
+
+			EndSized(frame);
+		}
+
+		EndSized(file);
+		bin.Flush();
+		return stream.ToArray();
+	}
+}
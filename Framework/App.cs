@@ -12,6 +12,9 @@ public static class App
 	private static bool started = false;
 	private static TimeSpan lastTime;
 	private static TimeSpan accumulator;
+	private static int maxQueuedFrames;
+	private static readonly Platform.FosterEvent[] events = new Platform.FosterEvent[64];
+	private static readonly TimeSpan waitSpinThreshold = TimeSpan.FromMilliseconds(0.25);
 	private static string title = string.Empty;
 	private static Platform.FosterFlags flags = 
 		Platform.FosterFlags.Resizable |
@@ -232,6 +235,38 @@ public static class App
 		}
 	}
 
+	/// <summary>
+	/// If V-Sync is adaptive, which doesn't wait for the next refresh when a frame is late.
+	/// This avoids stuttering down to half the refresh rate, at the cost of tearing.
+	/// Only used when <see cref="VSync"/> is enabled, and falls back to regular V-Sync if unsupported.
+	/// </summary>
+	public static bool VSyncAdaptive
+	{
+		get => flags.Has(Platform.FosterFlags.VsyncAdaptive);
+		set
+		{
+			if (value) flags |= Platform.FosterFlags.VsyncAdaptive;
+			else flags &= ~Platform.FosterFlags.VsyncAdaptive;
+			Platform.FosterSetFlags(flags);
+		}
+	}
+
+	/// <summary>
+	/// The maximum number of frames that can be queued on the GPU before the Application waits
+	/// for them to finish, between 1 and 3. Lower values reduce input latency at the cost of
+	/// throughput. 0 leaves it up to the driver, which is the default.
+	/// </summary>
+	public static int MaxQueuedFrames
+	{
+		get => maxQueuedFrames;
+		set
+		{
+			maxQueuedFrames = Math.Clamp(value, 0, 3);
+			if (Running)
+				Platform.FosterSetMaxQueuedFrames(maxQueuedFrames);
+		}
+	}
+
 	/// <summary>
 	/// If the Mouse is Hidden when over the Window
 	/// </summary>
@@ -333,6 +368,7 @@ public static class App
 
 		Running = true;
 		UserPath = Platform.ParseUTF8(Platform.FosterGetUserPath());
+		Platform.FosterSetMaxQueuedFrames(maxQueuedFrames);
 		Graphics.Initialize();
 
 		// load default input mappings if they exist
@@ -406,8 +442,10 @@ public static class App
 			PollEvents();
 			FramePool.NextFrame();
 
+			Tracing.Begin("Update");
 			for (int i = 0; i < modules.Count; i ++)
 				modules[i].Update();
+			Tracing.End();
 		}
 		
 		Platform.FosterBeginFrame();
@@ -423,8 +461,7 @@ public static class App
 			// Do not let us run too fast
 			while (accumulator < Time.FixedStepTarget)
 			{
-				int milliseconds = (int)(Time.FixedStepTarget - accumulator).TotalMilliseconds;
-				Thread.Sleep(milliseconds);
+				Wait(Time.FixedStepTarget - accumulator);
 
 				currentTime = timer.Elapsed;
 				deltaTime = currentTime - lastTime;
@@ -453,41 +490,78 @@ public static class App
 			Update(deltaTime);
 		}
 
+		Tracing.Begin("Render");
 		for (int i = 0; i < modules.Count; i ++)
 			modules[i].Render();
+		Tracing.End();
 
 		Platform.FosterEndFrame();
 	}
 
-	private static void PollEvents()
+	/// <summary>
+	/// Waits for the given duration. The Platform sleeps until shortly before it ends,
+	/// using a high resolution waitable timer on Windows 10 1803+ and nanosleep elsewhere,
+	/// and the last fraction of a millisecond is spun to absorb a late wake-up.
+	/// Older versions of Windows fall back to a regular waitable timer, which is only as
+	/// precise as the 1ms timer period SDL requests, so the wait can end up to 1ms late.
+	/// </summary>
+	private static void Wait(TimeSpan duration)
 	{
-		while (Platform.FosterPollEvents(out var ev) != 0)
+		var until = timer.Elapsed + duration;
+		while (true)
 		{
-			switch (ev.EventType)
-			{
-			case Platform.FosterEventType.None:
-				break;
-			case Platform.FosterEventType.ExitRequested:
-				if (started)
-				{
-					if (OnExitRequested != null)
-						OnExitRequested();
-					else
-						Exit();
-				}
-				break;
-			case Platform.FosterEventType.KeyboardInput:
-			case Platform.FosterEventType.KeyboardKey:
-			case Platform.FosterEventType.MouseButton:
-			case Platform.FosterEventType.MouseMove:
-			case Platform.FosterEventType.MouseWheel:
-			case Platform.FosterEventType.ControllerConnect:
-			case Platform.FosterEventType.ControllerDisconnect:
-			case Platform.FosterEventType.ControllerButton:
-			case Platform.FosterEventType.ControllerAxis:
-				Input.OnFosterEvent(ev);
+			var remaining = until - timer.Elapsed;
+			if (remaining <= TimeSpan.Zero)
 				break;
+
+			if (remaining > waitSpinThreshold)
+				Platform.FosterSleep((remaining - waitSpinThreshold).TotalSeconds);
+			else
+				Thread.SpinWait(16);
+		}
+	}
+
+	private static unsafe void PollEvents()
+	{
+		// events are drained in batches, rather than one call into the Platform per event
+		int count;
+		do
+		{
+			fixed (Platform.FosterEvent* ptr = events)
+				count = Platform.FosterPollEventsBatch(ptr, events.Length);
+
+			for (int i = 0; i < count; i ++)
+				OnFosterEvent(events[i]);
+		}
+		while (count >= events.Length);
+	}
+
+	private static void OnFosterEvent(in Platform.FosterEvent ev)
+	{
+		switch (ev.EventType)
+		{
+		case Platform.FosterEventType.None:
+			break;
+		case Platform.FosterEventType.ExitRequested:
+			if (started)
+			{
+				if (OnExitRequested != null)
+					OnExitRequested();
+				else
+					Exit();
 			}
+			break;
+		case Platform.FosterEventType.KeyboardInput:
+		case Platform.FosterEventType.KeyboardKey:
+		case Platform.FosterEventType.MouseButton:
+		case Platform.FosterEventType.MouseMove:
+		case Platform.FosterEventType.MouseWheel:
+		case Platform.FosterEventType.ControllerConnect:
+		case Platform.FosterEventType.ControllerDisconnect:
+		case Platform.FosterEventType.ControllerButton:
+		case Platform.FosterEventType.ControllerAxis:
+			Input.OnFosterEvent(ev);
+			break;
 		}
 	}
 }
@@ -26,16 +26,61 @@ public class Batcher : IDisposable
 		public Vector2 Pos = position;
 		public Vector2 Tex = texcoord;
 		public Color Col = color;
-		public Color Mode = mode;  // R = Multiply, G = Wash, B = Fill, A = Padding
+		public Color Mode = mode;  // R = Multiply, G = Wash, B = Fill, A = Texture Array Layer (when drawing a Texture Array)
 
 		public readonly VertexFormat Format => VertexFormat;
 	}
 
+	/// <summary>
+	/// Vertex Format of a unit quad corner in the instanced sprite Mesh
+	/// </summary>
+	private static readonly VertexFormat CornerFormat = VertexFormat.Create<Vector2>(
+		new VertexFormat.Element(0, VertexType.Float2, false)
+	);
+
+	/// <summary>
+	/// Instance Format of Batcher.Instance
+	/// </summary>
+	private static readonly VertexFormat InstanceFormat = VertexFormat.Create<Instance>(
+		new VertexFormat.Element(1, VertexType.Float2, false),
+		new VertexFormat.Element(2, VertexType.Float2, false),
+		new VertexFormat.Element(3, VertexType.Float2, false),
+		new VertexFormat.Element(4, VertexType.Float4, false),
+		new VertexFormat.Element(5, VertexType.UByte4, true),
+		new VertexFormat.Element(6, VertexType.UByte4, true)
+	);
+
+	/// <summary>
+	/// The Instance Layout used for instanced Sprite Batching.
+	/// Each Instance is a parallelogram spanning Origin + AxisX * u + AxisY * v.
+	/// </summary>
+	[StructLayout(LayoutKind.Sequential, Pack = 1)]
+	private struct Instance
+	{
+		public Vector2 Origin;
+		public Vector2 AxisX;
+		public Vector2 AxisY;
+		public Vector4 Tex;		// XY = top-left UV, ZW = bottom-right UV
+		public Color Col;
+		public Color Mode;
+	}
+
 	/// <summary>
 	/// The Default shader used by the Batcher.
 	/// </summary>
 	private static Shader? DefaultShader;
 
+	/// <summary>
+	/// The shader used by the Batcher for instanced sprites.
+	/// </summary>
+	private static Shader? InstancedShader;
+
+	/// <summary>
+	/// The shaders used by the Batcher for Texture Arrays.
+	/// </summary>
+	private static Shader? ArrayShader;
+	private static Shader? InstancedArrayShader;
+
 	/// <summary>
 	/// The current Matrix Value of the Batcher
 	/// </summary>
@@ -66,6 +111,23 @@ public class Batcher : IDisposable
 	/// </summary>
 	public int BatchCount => batches.Count + (currentBatch.Elements > 0 ? 1 : 0);
 
+	/// <summary>
+	/// If the Batcher should write vertices straight into its Mesh's GPU memory,
+	/// instead of building them in its own buffer and copying them over during Render.
+	/// This falls back to the regular behavior if the Renderer doesn't support it,
+	/// and changes to it take effect after the Batcher is cleared.
+	/// </summary>
+	public bool DirectVertexWrites { get; set; }
+
+	/// <summary>
+	/// If the Batcher should draw simple sprites and rectangles as GPU instances,
+	/// uploading a single record per sprite instead of four vertices.
+	/// This only applies while the default Material is used, falls back to the
+	/// regular behavior if the Renderer doesn't support it, and changes to it take
+	/// effect after the Batcher is cleared.
+	/// </summary>
+	public bool InstancedSprites { get; set; }
+
 	private readonly MaterialState defaultMaterialState = new();
 	private readonly Material defaultMaterial = new();
 	private readonly Stack<Matrix3x2> matrixStack = new();
@@ -75,24 +137,72 @@ public class Batcher : IDisposable
 	private readonly Stack<MaterialState> materialStack = new();
 	private readonly Stack<int> layerStack = new();
 	private readonly Stack<Color> modeStack = new();
+	private readonly Stack<bool> unorderedStack = new();
 	private readonly List<Batch> batches = new();
-	private readonly Mesh mesh = new();
+	private readonly Mesh mesh = new(streaming: true);
 	private Batch currentBatch;
 	private int currentBatchInsert;
 	private Color mode = new(255, 0, 0, 0);
+	private Color pushedMode = new(255, 0, 0, 0);
+	private int? modeLayer;
 	private bool dirty;
 
 	private readonly List<Material> materialPool = new();
 	private int materialPoolIndex;
 
+	private Platform.FosterDrawCommand[] drawCommands = [];
+	private int drawCommandCount;
+	private readonly Dictionary<(Shader Shader, BlendMode Blend, bool Instanced), Pipeline> pipelines = new();
+	private MaterialState? appliedMaterialState;
+	private Material? appliedMaterial;
+	private Texture? appliedTexture;
+	private TextureSampler appliedSampler;
+
 	private IntPtr vertexPtr = IntPtr.Zero;
 	private int vertexCount = 0;
 	private int vertexCapacity = 0;
 
+	// when verticesInMesh is true, vertexPtr points into the mapped Mesh memory instead
+	private bool vertexMapped;
+	private bool verticesInMesh;
+	private bool vertexMappingUnsupported;
+	private int mappedVertexCapacity = 0;
+
+	// instanced sprites are drawn from their own Mesh, made of a single unit quad
+	private Mesh? instanceMesh;
+	private readonly Material instancedMaterial = new();
+	private readonly Material arrayMaterial = new();
+	private readonly Material instancedArrayMaterial = new();
+	private IntPtr instancePtr = IntPtr.Zero;
+	private int instanceCount = 0;
+	private int instanceCapacity = 0;
+	private bool instancing;
+
 	private IntPtr indexPtr = IntPtr.Zero;
 	private int indexCount = 0;
 	private int indexCapacity = 0;
 
+	// while only quads have been pushed, indices aren't written and the Mesh
+	// uses the Renderer's shared quad indices instead
+	private bool quadsOnly = true;
+
+	// when any Unordered batches exist, they're sorted by state into this list
+	// and drawn from their own copy of the indices
+	private readonly List<Batch> sortedBatches = new();
+	private bool useSortedBatches;
+	private IntPtr sortedIndexPtr = IntPtr.Zero;
+	private int sortedIndexCapacity = 0;
+	private SortItem[] sortItems = [];
+	private SortItem[] sortItemsSwap = [];
+	private Batch[] sortScratch = [];
+	private readonly List<MaterialState> sortMaterials = new();
+	private readonly List<Texture?> sortTextures = new();
+	private readonly List<BlendMode> sortBlends = new();
+	private readonly List<TextureSampler> sortSamplers = new();
+	private readonly List<RectInt?> sortScissors = new();
+
+	private readonly record struct SortItem(ulong Key, int Index);
+
 	private readonly record struct MaterialState(
 		Material Material,
 		string MatrixUniform,
@@ -110,6 +220,8 @@ public class Batcher : IDisposable
 		public TextureSampler Sampler = sampler;
 		public int Offset = offset;
 		public int Elements = elements;
+		public bool Unordered = false;
+		public bool Instanced = false;
 		public bool FlipVerticalUV = (texture?.IsTargetAttachment ?? false) && Graphics.OriginBottomLeft;
 	}
 
@@ -119,6 +231,25 @@ public class Batcher : IDisposable
 		Clear();
 	}
 
+	/// <summary>
+	/// Creates the Batcher's default Shaders if they don't exist yet. Shaders can only be
+	/// created on the Main Thread, and are otherwise created the first time they're needed,
+	/// so call this before recording Batchers into Command Buffers from other threads.
+	/// </summary>
+	public static void CreateShaders()
+	{
+		if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+			throw new Exception("The Batcher's Shaders can only be created on the Main Thread");
+
+		CreateShader(ref DefaultShader, ShaderDefaults.Batcher);
+		if (ShaderDefaults.BatcherInstanced.ContainsKey(Graphics.Renderer))
+			CreateShader(ref InstancedShader, ShaderDefaults.BatcherInstanced);
+		if (ShaderDefaults.BatcherArray.ContainsKey(Graphics.Renderer))
+			CreateShader(ref ArrayShader, ShaderDefaults.BatcherArray);
+		if (ShaderDefaults.BatcherInstancedArray.ContainsKey(Graphics.Renderer))
+			CreateShader(ref InstancedArrayShader, ShaderDefaults.BatcherInstancedArray);
+	}
+
 	~Batcher()
 	{
 		Dispose();
@@ -126,6 +257,15 @@ public class Batcher : IDisposable
 
 	public void Dispose()
 	{
+		// mapped memory belongs to the Mesh
+		if (verticesInMesh)
+		{
+			vertexPtr = IntPtr.Zero;
+			vertexCapacity = 0;
+			vertexMapped = false;
+			verticesInMesh = false;
+		}
+
 		if (vertexPtr != IntPtr.Zero)
 		{
 			Marshal.FreeHGlobal(vertexPtr);
@@ -140,8 +280,26 @@ public class Batcher : IDisposable
 			indexCapacity = 0;
 		}
 
+		if (sortedIndexPtr != IntPtr.Zero)
+		{
+			Marshal.FreeHGlobal(sortedIndexPtr);
+			sortedIndexPtr = IntPtr.Zero;
+			sortedIndexCapacity = 0;
+		}
+
+		if (instancePtr != IntPtr.Zero)
+		{
+			Marshal.FreeHGlobal(instancePtr);
+			instancePtr = IntPtr.Zero;
+			instanceCapacity = 0;
+		}
+
 		materialPool.Clear();
 		materialPoolIndex = 0;
+
+		foreach (var pipeline in pipelines.Values)
+			pipeline.Dispose();
+		pipelines.Clear();
 	}
 
 	/// <summary>
@@ -149,13 +307,37 @@ public class Batcher : IDisposable
 	/// </summary>
 	public void Clear()
 	{
+		if (verticesInMesh)
+		{
+			UnmapVertices();
+			verticesInMesh = false;
+		}
+
 		vertexCount = 0;
 		indexCount = 0;
+		instanceCount = 0;
+		instancing = InstancedSprites && ShaderDefaults.BatcherInstanced.ContainsKey(Graphics.Renderer);
+
+		// the instance Mesh can only be created on the Main Thread
+		if (instancing && instanceMesh == null)
+		{
+			if (Thread.CurrentThread.ManagedThreadId == App.MainThreadID)
+			{
+				instanceMesh = new(streaming: true);
+				instanceMesh.SetQuadIndices(1);
+			}
+			else
+				instancing = false;
+		}
+		quadsOnly = true;
 		currentBatchInsert = 0;
 		materialPoolIndex = 0;
 		currentBatch = new Batch(defaultMaterialState, BlendMode.Premultiply, null, new(), 0, 0);
-		mode = new Color(255, 0, 0, 0);
+		mode = pushedMode = new Color(255, 0, 0, 0);
+		modeLayer = null;
 		batches.Clear();
+		sortedBatches.Clear();
+		useSortedBatches = false;
 		matrixStack.Clear();
 		scissorStack.Clear();
 		blendStack.Clear();
@@ -163,6 +345,7 @@ public class Batcher : IDisposable
 		layerStack.Clear();
 		samplerStack.Clear();
 		modeStack.Clear();
+		unorderedStack.Clear();
 		Matrix = Matrix3x2.Identity;
 	}
 
@@ -175,6 +358,54 @@ public class Batcher : IDisposable
 	/// <param name="viewport">Optional Viewport Rectangle</param>
 	/// <param name="scissor">Optional Scissor Rectangle, which will clip any Scissor rectangles pushed to the Batcher.</param>
 	public void Render(Target? target = null, RectInt? viewport = null, RectInt? scissor = null)
+	{
+		Render(target, GetRenderMatrix(target, viewport), viewport, scissor);
+	}
+
+	/// <summary>
+	/// Draws the Batcher to the given Target with the given Matrix Transformation
+	/// </summary>
+	/// <param name="target">What Target to Draw to, or null for the Window's backbuffer</param>
+	/// <param name="matrix">Transforms the entire Batch</param>
+	/// <param name="viewport">Optional Viewport Rectangle</param>
+	/// <param name="scissor">Optional Scissor Rectangle, which will clip any Scissor rectangles pushed to the Batcher.</param>
+	public void Render(Target? target, Matrix4x4 matrix, RectInt? viewport = null, RectInt? scissor = null)
+	{
+		RenderInto(null, target, matrix, viewport, scissor);
+	}
+
+	/// <summary>
+	/// Records drawing the Batcher into a Command Buffer.
+	/// See <see cref="Record(CommandBuffer, Target?, Matrix4x4, RectInt?, RectInt?)"/>
+	/// </summary>
+	/// <param name="commands">The Command Buffer to record into</param>
+	/// <param name="target">What Target to Draw to, or null for the Window's backbuffer</param>
+	/// <param name="viewport">Optional Viewport Rectangle</param>
+	/// <param name="scissor">Optional Scissor Rectangle, which will clip any Scissor rectangles pushed to the Batcher.</param>
+	public void Record(CommandBuffer commands, Target? target = null, RectInt? viewport = null, RectInt? scissor = null)
+	{
+		Record(commands, target, GetRenderMatrix(target, viewport), viewport, scissor);
+	}
+
+	/// <summary>
+	/// Records drawing the Batcher into a Command Buffer, which can be done from any thread
+	/// as long as nothing else is using the Batcher at the same time. Sprites are only drawn as
+	/// instances if the Batcher was last cleared on the Main Thread, and vertices are only
+	/// written directly into the Mesh on the Main Thread. Off the Main Thread, the default Shaders
+	/// must already have been created, see <see cref="CreateShaders"/>.
+	/// </summary>
+	/// <param name="commands">The Command Buffer to record into</param>
+	/// <param name="target">What Target to Draw to, or null for the Window's backbuffer</param>
+	/// <param name="matrix">Transforms the entire Batch</param>
+	/// <param name="viewport">Optional Viewport Rectangle</param>
+	/// <param name="scissor">Optional Scissor Rectangle, which will clip any Scissor rectangles pushed to the Batcher.</param>
+	public void Record(CommandBuffer commands, Target? target, Matrix4x4 matrix, RectInt? viewport = null, RectInt? scissor = null)
+	{
+		ArgumentNullException.ThrowIfNull(commands);
+		RenderInto(commands, target, matrix, viewport, scissor);
+	}
+
+	private static Matrix4x4 GetRenderMatrix(Target? target, RectInt? viewport)
 	{
 		Point2 size;
 
@@ -185,58 +416,85 @@ public class Batcher : IDisposable
 		else
 			size = new Point2(App.WidthInPixels, App.HeightInPixels);
 
-		var matrix = Matrix4x4.CreateOrthographicOffCenter(0, size.X, size.Y, 0, 0, float.MaxValue);
-		Render(target, matrix, viewport, scissor);
+		return Matrix4x4.CreateOrthographicOffCenter(0, size.X, size.Y, 0, 0, float.MaxValue);
 	}
 
-	/// <summary>
-	/// Draws the Batcher to the given Target with the given Matrix Transformation
-	/// </summary>
-	/// <param name="target">What Target to Draw to, or null for the Window's backbuffer</param>
-	/// <param name="matrix">Transforms the entire Batch</param>
-	/// <param name="viewport">Optional Viewport Rectangle</param>
-	/// <param name="scissor">Optional Scissor Rectangle, which will clip any Scissor rectangles pushed to the Batcher.</param>
-	public void Render(Target? target, Matrix4x4 matrix, RectInt? viewport = null, RectInt? scissor = null)
+	private void RenderInto(CommandBuffer? commands, Target? target, Matrix4x4 matrix, RectInt? viewport, RectInt? scissor)
 	{
 		if (target != null && target.IsDisposed)
 			throw new Exception("Target is disposed");
 
-		if (indexPtr == IntPtr.Zero || vertexPtr == IntPtr.Zero)
+		if ((indexCount <= 0 || vertexCount <= 0) && instanceCount <= 0)
 			return;
 
 		if (batches.Count <= 0 && currentBatch.Elements <= 0)
 			return;
 
-		// upload our data if we've been modified since the last time we rendered
-		if (dirty)
+		// vertices written directly into the Mesh only need to be unmapped
+		if (verticesInMesh)
 		{
-			mesh.SetIndices(indexPtr, indexCount, IndexFormat.ThirtyTwo);
-			mesh.SetVertices(vertexPtr, vertexCount, VertexFormat);
-			dirty = false;
+			if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+				throw new Exception("Batcher vertices written directly into the Mesh can only be rendered on the Main Thread");
+			UnmapVertices();
+		}
+
+		// upload our data if we've been modified since the last time we rendered.
+		// recorded uploads don't happen until they're executed, so they're always
+		// recorded, and the next regular Render uploads again
+		if (dirty || commands != null)
+		{
+			useSortedBatches = SortBatches();
+			if (indexCount > 0)
+			{
+				if (useSortedBatches)
+					mesh.SetIndices(commands, sortedIndexPtr, indexCount, IndexFormat.ThirtyTwo);
+				else if (quadsOnly)
+					mesh.SetQuadIndices(commands, indexCount / 6);
+				else
+					mesh.SetIndices(commands, indexPtr, indexCount, IndexFormat.ThirtyTwo);
+				if (!verticesInMesh)
+					mesh.SetVertices(commands, vertexPtr, vertexCount, VertexFormat);
+			}
+			if (instanceCount > 0)
+				UploadInstances(commands);
+			dirty = commands != null;
 		}
 
 		// make sure default shader and material are valid
-		if (DefaultShader == null || DefaultShader.IsDisposed)
-			DefaultShader = new Shader(ShaderDefaults.Batcher[Graphics.Renderer]);
-		defaultMaterial.SetShader(DefaultShader);
+		PrepareMaterial(defaultMaterial, ref DefaultShader, ShaderDefaults.Batcher);
 
 		// render batches
-		for (int i = 0; i < batches.Count; i++)
+		appliedMaterialState = null;
+		if (useSortedBatches)
 		{
-			// remaining elements in the current batch
-			if (currentBatchInsert == i && currentBatch.Elements > 0)
-				RenderBatch(target, currentBatch, matrix, viewport, scissor);
+			for (int i = 0; i < sortedBatches.Count; i++)
+				RenderBatch(commands, target, sortedBatches[i], matrix, viewport, scissor);
+		}
+		else
+		{
+			for (int i = 0; i < batches.Count; i++)
+			{
+				// remaining elements in the current batch
+				if (currentBatchInsert == i && currentBatch.Elements > 0)
+					RenderBatch(commands, target, currentBatch, matrix, viewport, scissor);
 
-			// render the batch
-			RenderBatch(target, batches[i], matrix, viewport, scissor);
+				// render the batch
+				RenderBatch(commands, target, batches[i], matrix, viewport, scissor);
+			}
+
+			// remaining elements in the current batch
+			if (currentBatchInsert == batches.Count && currentBatch.Elements > 0)
+				RenderBatch(commands, target, currentBatch, matrix, viewport, scissor);
 		}
 
-		// remaining elements in the current batch
-		if (currentBatchInsert == batches.Count && currentBatch.Elements > 0)
-			RenderBatch(target, currentBatch, matrix, viewport, scissor);
+		// submit whatever is left
+		FlushDrawCommands(commands);
+		appliedMaterialState = null;
+		appliedMaterial = null;
+		appliedTexture = null;
 	}
 
-	private void RenderBatch(Target? target, in Batch batch, in Matrix4x4 matrix, in RectInt? viewport, in RectInt? scissor)
+	private void RenderBatch(CommandBuffer? commands, Target? target, in Batch batch, in Matrix4x4 matrix, in RectInt? viewport, in RectInt? scissor)
 	{
 		var trimmed = scissor;
 		if (batch.Scissor.HasValue && trimmed.HasValue)
@@ -245,24 +503,355 @@ public class Batcher : IDisposable
 			trimmed = batch.Scissor;
 
 		var texture = batch.Texture != null && !batch.Texture.IsDisposed ? batch.Texture : null;
+		var mat = GetBatchMaterial(batch, texture);
 
-		var mat = batch.MaterialState.Material;
-		mat.Set(batch.MaterialState.MatrixUniform, matrix);
-		mat.Set(batch.MaterialState.TextureUniform, texture);
-		mat.Set(batch.MaterialState.SamplerUniform, batch.Sampler);
+		// Material values are stored on the Shader, so they can only change between
+		// submissions. If this batch needs different values, submit what we have first.
+		if (appliedMaterialState != batch.MaterialState || appliedMaterial != mat || appliedTexture != texture || appliedSampler != batch.Sampler)
+		{
+			FlushDrawCommands(commands);
 
-		DrawCommand command = new(target, mesh, mat)
+			mat.Set(batch.MaterialState.MatrixUniform, matrix);
+			mat.Set(batch.MaterialState.TextureUniform, texture);
+			mat.Set(batch.MaterialState.SamplerUniform, batch.Sampler);
+			if (commands != null)
+				mat.Apply(commands);
+			else
+				mat.Apply();
+
+			appliedMaterialState = batch.MaterialState;
+			appliedMaterial = mat;
+			appliedTexture = texture;
+			appliedSampler = batch.Sampler;
+		}
+
+		DrawCommand command = new(target, batch.Instanced ? instanceMesh! : mesh, mat)
 		{
 			Viewport = viewport,
 			Scissor = trimmed,
 			BlendMode = batch.Blend,
+			Pipeline = GetPipeline(mat.Shader, batch.Blend, batch.Instanced),
 			MeshIndexStart = batch.Offset * 3,
 			MeshIndexCount = batch.Elements * 3,
 			DepthMask = false,
 			DepthCompare = DepthCompare.None,
 			CullMode = CullMode.None
 		};
-		command.Submit();
+
+		// instanced batches draw the unit quad once for each of their instances
+		if (batch.Instanced)
+		{
+			command.MeshIndexStart = 0;
+			command.MeshIndexCount = 6;
+			command.InstanceStart = batch.Offset;
+			command.InstanceCount = batch.Elements;
+		}
+
+		if (drawCommandCount >= drawCommands.Length)
+			Array.Resize(ref drawCommands, Math.Max(32, drawCommands.Length * 2));
+		drawCommands[drawCommandCount++] = Graphics.GetPlatformCommand(command);
+
+		if (commands != null)
+		{
+			commands.Keep(command.Target);
+			commands.Keep(command.Mesh);
+			commands.Keep(command.Pipeline);
+		}
+	}
+
+	/// <summary>
+	/// Gets the Pipeline for the batch's Render State, so the Renderer doesn't
+	/// have to resolve it again every time the same state is drawn.
+	/// </summary>
+	private Pipeline? GetPipeline(Shader? shader, in BlendMode blend, bool instanced)
+	{
+		// invalid Shaders are reported when the Draw Command is validated
+		if (shader == null || shader.IsDisposed)
+			return null;
+
+		var key = (shader, blend, instanced);
+		if (!pipelines.TryGetValue(key, out var pipeline) || pipeline.IsDisposed)
+		{
+			// Pipelines can only be created on the Main Thread, and are optional
+			if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+				return null;
+
+			// drop Pipelines whose Shaders have since been disposed
+			foreach (var (k, it) in pipelines)
+			{
+				if (k.Shader.IsDisposed)
+				{
+					it.Dispose();
+					pipelines.Remove(k);
+				}
+			}
+
+			pipeline = instanced ?
+				new Pipeline(shader, CornerFormat, InstanceFormat, blend) :
+				new Pipeline(shader, VertexFormat, null, blend);
+			pipelines[key] = pipeline;
+		}
+
+		return pipeline;
+	}
+
+	/// <summary>
+	/// Gets the Material to draw the batch with. Batches using the default Material
+	/// switch to a variant of it for instanced sprites and Texture Arrays.
+	/// </summary>
+	private Material GetBatchMaterial(in Batch batch, Texture? texture)
+	{
+		if (batch.MaterialState != defaultMaterialState)
+			return batch.MaterialState.Material;
+
+		var array = texture != null && texture.IsArray;
+		if (batch.Instanced && array)
+			return PrepareMaterial(instancedArrayMaterial, ref InstancedArrayShader, ShaderDefaults.BatcherInstancedArray);
+		if (batch.Instanced)
+			return PrepareMaterial(instancedMaterial, ref InstancedShader, ShaderDefaults.BatcherInstanced);
+		if (array)
+			return PrepareMaterial(arrayMaterial, ref ArrayShader, ShaderDefaults.BatcherArray);
+		return defaultMaterial;
+	}
+
+	private static Material PrepareMaterial(Material material, ref Shader? shader, Dictionary<Renderers, ShaderCreateInfo> shaders)
+	{
+		if (shader == null || shader.IsDisposed)
+		{
+			if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+				throw new Exception("The Batcher's Shaders haven't been created yet. Call Batcher.CreateShaders on the Main Thread before recording from other threads");
+			CreateShader(ref shader, shaders);
+		}
+
+		material.SetShader(shader);
+		return material;
+	}
+
+	private static void CreateShader(ref Shader? shader, Dictionary<Renderers, ShaderCreateInfo> shaders)
+	{
+		if (shader != null && !shader.IsDisposed)
+			return;
+
+		if (!shaders.TryGetValue(Graphics.Renderer, out var info))
+			throw new Exception($"The Batcher has no default shader for {Graphics.Renderer}");
+		shader = new Shader(info);
+	}
+
+	private unsafe void FlushDrawCommands(CommandBuffer? commands)
+	{
+		if (drawCommandCount <= 0)
+			return;
+
+		if (commands != null)
+			commands.SubmitBatch(drawCommands.AsSpan(0, drawCommandCount));
+		else
+		{
+			fixed (Platform.FosterDrawCommand* ptr = drawCommands)
+				Platform.FosterDrawBatch(ptr, drawCommandCount);
+		}
+
+		drawCommandCount = 0;
+	}
+
+	/// <summary>
+	/// Builds the sorted batch list if there are any Unordered batches.
+	/// Returns false if the batches should be drawn as they are.
+	/// </summary>
+	private unsafe bool SortBatches()
+	{
+		sortedBatches.Clear();
+
+		// gather batches in the order they would be drawn
+		var anyUnordered = false;
+		for (int i = 0; i <= batches.Count; i++)
+		{
+			if (currentBatchInsert == i && currentBatch.Elements > 0)
+			{
+				sortedBatches.Add(currentBatch);
+				anyUnordered |= currentBatch.Unordered;
+			}
+
+			if (i < batches.Count && batches[i].Elements > 0)
+			{
+				sortedBatches.Add(batches[i]);
+				anyUnordered |= batches[i].Unordered;
+			}
+		}
+
+		if (!anyUnordered)
+		{
+			sortedBatches.Clear();
+			return false;
+		}
+
+		// sort each run of Unordered batches that are on the same layer
+		for (int start = 0, end; start < sortedBatches.Count; start = end)
+		{
+			end = start + 1;
+			if (!sortedBatches[start].Unordered)
+				continue;
+
+			while (end < sortedBatches.Count && sortedBatches[end].Unordered && sortedBatches[end].Layer == sortedBatches[start].Layer)
+				end++;
+
+			if (end - start > 1)
+				SortBatchRange(start, end - start);
+		}
+
+		// lay the indices of the sorted batches out one after another, so that
+		// neighbouring batches with the same state can be merged into one draw
+		if (quadsOnly)
+			ExpandQuadIndices();
+
+		if (indexCount > sortedIndexCapacity)
+		{
+			if (sortedIndexPtr != IntPtr.Zero)
+				Marshal.FreeHGlobal(sortedIndexPtr);
+			sortedIndexCapacity = indexCapacity;
+			sortedIndexPtr = Marshal.AllocHGlobal(sizeof(int) * sortedIndexCapacity);
+		}
+
+		var src = (int*)indexPtr;
+		var dst = (int*)sortedIndexPtr;
+		var offset = 0;
+		var count = 0;
+
+		for (int i = 0; i < sortedBatches.Count; i++)
+		{
+			var batch = sortedBatches[i];
+
+			// instances aren't indexed, so they keep their place in the instance buffer
+			// and can only be merged with the batch that was written right before them
+			if (!batch.Instanced)
+			{
+				Buffer.MemoryCopy(src + batch.Offset * 3, dst + offset * 3, (sortedIndexCapacity - offset * 3) * sizeof(int), batch.Elements * 3 * sizeof(int));
+				batch.Offset = offset;
+				offset += batch.Elements;
+			}
+
+			if (count > 0 && IsSameState(sortedBatches[count - 1], batch) &&
+				(!batch.Instanced || sortedBatches[count - 1].Offset + sortedBatches[count - 1].Elements == batch.Offset))
+			{
+				var last = sortedBatches[count - 1];
+				last.Elements += batch.Elements;
+				sortedBatches[count - 1] = last;
+			}
+			else
+			{
+				sortedBatches[count++] = batch;
+			}
+		}
+
+		sortedBatches.RemoveRange(count, sortedBatches.Count - count);
+		return true;
+	}
+
+	/// <summary>
+	/// Sorts a range of the sorted batch list by a key made from its state.
+	/// The sort is stable, so batches with the same state keep their order.
+	/// </summary>
+	private void SortBatchRange(int start, int count)
+	{
+		sortMaterials.Clear();
+		sortTextures.Clear();
+		sortBlends.Clear();
+		sortSamplers.Clear();
+		sortScissors.Clear();
+
+		if (sortItems.Length < count)
+		{
+			Array.Resize(ref sortItems, count);
+			Array.Resize(ref sortItemsSwap, count);
+			Array.Resize(ref sortScratch, count);
+		}
+
+		// key layout: material (16) | texture (20) | blend (8) | sampler (8) | scissor (12)
+		for (int i = 0; i < count; i++)
+		{
+			var batch = sortedBatches[start + i];
+			var material = SortId(sortMaterials, batch.MaterialState);
+			var texture = SortId(sortTextures, batch.Texture);
+			var blend = SortId(sortBlends, batch.Blend);
+			var sampler = SortId(sortSamplers, batch.Sampler);
+			var scissor = SortId(sortScissors, batch.Scissor);
+
+			// too many unique states to fit in the key, so leave the range as it is
+			if (material >= (1 << 16) || texture >= (1 << 20) || blend >= (1 << 8) || sampler >= (1 << 8) || scissor >= (1 << 12))
+				return;
+
+			var key =
+				((ulong)(uint)material << 48) |
+				((ulong)(uint)texture << 28) |
+				((ulong)(uint)blend << 20) |
+				((ulong)(uint)sampler << 12) |
+				(ulong)(uint)scissor;
+
+			sortItems[i] = new(key, i);
+		}
+
+		RadixSort(sortItems, sortItemsSwap, count);
+
+		for (int i = 0; i < count; i++)
+			sortScratch[i] = sortedBatches[start + sortItems[i].Index];
+		for (int i = 0; i < count; i++)
+			sortedBatches[start + i] = sortScratch[i];
+	}
+
+	/// <summary>
+	/// Stable LSD radix sort of the items by their key, one byte at a time
+	/// </summary>
+	private static void RadixSort(SortItem[] items, SortItem[] swap, int count)
+	{
+		Span<int> offsets = stackalloc int[256];
+		var src = items;
+		var dst = swap;
+
+		for (int shift = 0; shift < 64; shift += 8)
+		{
+			offsets.Clear();
+			for (int i = 0; i < count; i++)
+				offsets[(int)((src[i].Key >> shift) & 0xFF)]++;
+
+			// every key has the same value in this byte, so nothing would move
+			if (offsets[(int)((src[0].Key >> shift) & 0xFF)] == count)
+				continue;
+
+			for (int i = 0, total = 0; i < 256; i++)
+			{
+				var amount = offsets[i];
+				offsets[i] = total;
+				total += amount;
+			}
+
+			for (int i = 0; i < count; i++)
+				dst[offsets[(int)((src[i].Key >> shift) & 0xFF)]++] = src[i];
+
+			(src, dst) = (dst, src);
+		}
+
+		if (src != items)
+			Array.Copy(src, items, count);
+	}
+
+	private static int SortId<T>(List<T> list, in T value)
+	{
+		var comparer = EqualityComparer<T>.Default;
+		for (int i = 0; i < list.Count; i++)
+			if (comparer.Equals(list[i], value))
+				return i;
+		list.Add(value);
+		return list.Count - 1;
+	}
+
+	private static bool IsSameState(in Batch a, in Batch b)
+	{
+		return
+			a.MaterialState == b.MaterialState &&
+			a.Instanced == b.Instanced &&
+			a.Texture == b.Texture &&
+			a.Blend == b.Blend &&
+			a.Sampler == b.Sampler &&
+			a.Scissor == b.Scissor;
 	}
 
 	#endregion
@@ -273,7 +862,17 @@ public class Batcher : IDisposable
 	/// Sets the Current Texture being drawn
 	/// </summary>
 	public void SetTexture(Texture? texture)
+		=> SetTexture(texture, 0);
+
+	/// <summary>
+	/// Sets the Current Texture being drawn, and the Layer to sample from if it's a Texture Array.
+	/// Changing only the Layer doesn't break the batch. Layers past 255 can't be drawn with the default Material.
+	/// </summary>
+	public void SetTexture(Texture? texture, int layer)
 	{
+		modeLayer = (texture?.IsArray ?? false) ? layer : null;
+		UpdateMode();
+
 		if (currentBatch.Texture == null || currentBatch.Elements == 0)
 		{
 			currentBatch.Texture = texture;
@@ -371,6 +970,40 @@ public class Batcher : IDisposable
 		}
 	}
 
+	private void SetUnordered(bool unordered)
+	{
+		if (currentBatch.Elements == 0)
+		{
+			currentBatch.Unordered = unordered;
+		}
+		else if (currentBatch.Unordered != unordered)
+		{
+			batches.Insert(currentBatchInsert, currentBatch);
+
+			currentBatch.Unordered = unordered;
+			currentBatch.Offset += currentBatch.Elements;
+			currentBatch.Elements = 0;
+			currentBatchInsert++;
+		}
+	}
+
+	private void SetInstanced(bool instanced)
+	{
+		if (currentBatch.Instanced == instanced)
+			return;
+
+		// instanced batches count instances instead of triangles
+		if (currentBatch.Elements > 0)
+		{
+			batches.Insert(currentBatchInsert, currentBatch);
+			currentBatchInsert++;
+		}
+
+		currentBatch.Instanced = instanced;
+		currentBatch.Offset = instanced ? instanceCount : indexCount / 3;
+		currentBatch.Elements = 0;
+	}
+
 	private void SetScissor(RectInt? scissor)
 	{
 		if (currentBatch.Elements == 0)
@@ -503,6 +1136,26 @@ public class Batcher : IDisposable
 		SetScissor(scissorStack.Pop());
 	}
 
+	/// <summary>
+	/// Pushes a scope where the draw order doesn't matter, such as for opaque tiles.
+	/// Within it, the Batcher may reorder what is drawn (on the same layer) to group
+	/// things by their Material, Texture, Blend, Sampler and Scissor, reducing the
+	/// number of draw calls. Overlapping geometry may be drawn in any order.
+	/// </summary>
+	public void PushUnordered()
+	{
+		unorderedStack.Push(currentBatch.Unordered);
+		SetUnordered(true);
+	}
+
+	/// <summary>
+	/// Pops the current Unordered scope
+	/// </summary>
+	public void PopUnordered()
+	{
+		SetUnordered(unorderedStack.Pop());
+	}
+
 	/// <summary>
 	/// Pushes a Matrix that will transform all future data
 	/// </summary>
@@ -565,8 +1218,7 @@ public class Batcher : IDisposable
 	/// </summary>
 	public void PushModeNormal()
 	{
-		modeStack.Push(mode);
-		mode = new Color(255, 0, 0, 0);
+		PushMode(new Color(255, 0, 0, 0));
 	}
 
 	/// <summary>
@@ -574,8 +1226,7 @@ public class Batcher : IDisposable
 	/// </summary>
 	public void PushModeWash()
 	{
-		modeStack.Push(mode);
-		mode = new Color(0, 255, 0, 0);
+		PushMode(new Color(0, 255, 0, 0));
 	}
 
 	/// <summary>
@@ -584,17 +1235,18 @@ public class Batcher : IDisposable
 	/// </summary>
 	public void PushModeFill()
 	{
-		modeStack.Push(mode);
-		mode = new Color(0, 0, 255, 0);
+		PushMode(new Color(0, 0, 255, 0));
 	}
 
 	/// <summary>
-	/// Pushes a custom Mode value
+	/// Pushes a custom Mode value.
+	/// While drawing a Texture Array, its alpha is replaced with the current Layer.
 	/// </summary>
 	public void PushMode(Color value)
 	{
-		modeStack.Push(mode);
-		mode = value;
+		modeStack.Push(pushedMode);
+		pushedMode = value;
+		UpdateMode();
 	}
 
 	/// <summary>
@@ -602,7 +1254,15 @@ public class Batcher : IDisposable
 	/// </summary>
 	public void PopMode()
 	{
-		mode = modeStack.Pop();
+		pushedMode = modeStack.Pop();
+		UpdateMode();
+	}
+
+	private void UpdateMode()
+	{
+		mode = pushedMode;
+		if (modeLayer.HasValue)
+			mode.A = (byte)modeLayer.Value;
 	}
 
 	#endregion
@@ -656,6 +1316,9 @@ public class Batcher : IDisposable
 
 	public void Quad(in Vector2 v0, in Vector2 v1, in Vector2 v2, in Vector2 v3, in Color color)
 	{
+		if (instancing && TryPushInstance(v0, v1, v2, v3, Vector2.Zero, Vector2.Zero, color, new Color(0, 0, 255, 0)))
+			return;
+
 		PushQuad();
 		EnsureVertexCapacity(vertexCount + 4);
 
@@ -683,6 +1346,11 @@ public class Batcher : IDisposable
 
 	public void Quad(in Vector2 v0, in Vector2 v1, in Vector2 v2, in Vector2 v3, in Vector2 t0, in Vector2 t1, in Vector2 t2, in Vector2 t3, in Color color)
 	{
+		// instances interpolate between two UV corners, so the UVs must be axis-aligned
+		if (instancing && t0.Y == t1.Y && t1.X == t2.X && t2.Y == t3.Y && t3.X == t0.X &&
+			TryPushInstance(v0, v1, v2, v3, t0, t2, color, mode))
+			return;
+
 		PushQuad();
 		EnsureVertexCapacity(vertexCount + 4);
 
@@ -694,10 +1362,10 @@ public class Batcher : IDisposable
 			vertexArray[1].Pos = Vector2.Transform(v1, Matrix);
 			vertexArray[2].Pos = Vector2.Transform(v2, Matrix);
 			vertexArray[3].Pos = Vector2.Transform(v3, Matrix);
-			vertexArray[0].Tex = t0;
-			vertexArray[1].Tex = t1;
-			vertexArray[2].Tex = t2;
-			vertexArray[3].Tex = t3;
+			vertexArray[0].Tex = TexCoord(t0);
+			vertexArray[1].Tex = TexCoord(t1);
+			vertexArray[2].Tex = TexCoord(t2);
+			vertexArray[3].Tex = TexCoord(t3);
 			vertexArray[0].Col = color;
 			vertexArray[1].Col = color;
 			vertexArray[2].Col = color;
@@ -706,9 +1374,6 @@ public class Batcher : IDisposable
 			vertexArray[1].Mode = mode;
 			vertexArray[2].Mode = mode;
 			vertexArray[3].Mode = mode;
-
-			if (currentBatch.FlipVerticalUV)
-				FlipVerticalUVs(vertexPtr, vertexCount, 4);
 		}
 
 		vertexCount += 4;
@@ -754,10 +1419,10 @@ public class Batcher : IDisposable
 			vertexArray[1].Pos = Vector2.Transform(v1, Matrix);
 			vertexArray[2].Pos = Vector2.Transform(v2, Matrix);
 			vertexArray[3].Pos = Vector2.Transform(v3, Matrix);
-			vertexArray[0].Tex = t0;
-			vertexArray[1].Tex = t1;
-			vertexArray[2].Tex = t2;
-			vertexArray[3].Tex = t3;
+			vertexArray[0].Tex = TexCoord(t0);
+			vertexArray[1].Tex = TexCoord(t1);
+			vertexArray[2].Tex = TexCoord(t2);
+			vertexArray[3].Tex = TexCoord(t3);
 			vertexArray[0].Col = c0;
 			vertexArray[1].Col = c1;
 			vertexArray[2].Col = c2;
@@ -766,14 +1431,41 @@ public class Batcher : IDisposable
 			vertexArray[1].Mode = mode;
 			vertexArray[2].Mode = mode;
 			vertexArray[3].Mode = mode;
-
-			if (currentBatch.FlipVerticalUV)
-				FlipVerticalUVs(vertexPtr, vertexCount, 4);
 		}
 
 		vertexCount += 4;
 	}
 
+	/// <summary>
+	/// Draws pre-built quads with the given Texture, 4 vertices per quad in the same order as <see cref="Quad(in Vector2, in Vector2, in Vector2, in Vector2, in Color)"/>.
+	/// The vertices are copied as-is when the Matrix is the identity, and otherwise only their positions are transformed.
+	/// Their Texture Coordinates and Mode are used as-is, so they aren't flipped for Target Textures.
+	/// </summary>
+	public unsafe void Quads(Texture? texture, ReadOnlySpan<Vertex> vertices)
+	{
+		var count = vertices.Length / 4;
+		if (count <= 0)
+			return;
+
+		SetTexture(texture);
+		EnsureVertexCapacity(vertexCount + count * 4);
+
+		var vertexArray = new Span<Vertex>((Vertex*)vertexPtr + vertexCount, count * 4);
+		vertices[..(count * 4)].CopyTo(vertexArray);
+
+		if (!Matrix.IsIdentity)
+		{
+			for (int i = 0; i < vertexArray.Length; i++)
+				vertexArray[i].Pos = Vector2.Transform(vertexArray[i].Pos, Matrix);
+		}
+
+		for (int i = 0; i < count; i++)
+		{
+			PushQuad();
+			vertexCount += 4;
+		}
+	}
+
 	public void QuadLine(in Vector2 a, in Vector2 b, in Vector2 c, in Vector2 d, float thickness, in Color color)
 	{
 		Line(a, b, thickness, color);
@@ -826,18 +1518,15 @@ public class Batcher : IDisposable
 			vertexArray[0].Pos = Vector2.Transform(v0, Matrix);
 			vertexArray[1].Pos = Vector2.Transform(v1, Matrix);
 			vertexArray[2].Pos = Vector2.Transform(v2, Matrix);
-			vertexArray[0].Tex = uv0;
-			vertexArray[1].Tex = uv1;
-			vertexArray[2].Tex = uv2;
+			vertexArray[0].Tex = TexCoord(uv0);
+			vertexArray[1].Tex = TexCoord(uv1);
+			vertexArray[2].Tex = TexCoord(uv2);
 			vertexArray[0].Col = color;
 			vertexArray[1].Col = color;
 			vertexArray[2].Col = color;
 			vertexArray[0].Mode = mode;
 			vertexArray[1].Mode = mode;
 			vertexArray[2].Mode = mode;
-
-			if (currentBatch.FlipVerticalUV)
-				FlipVerticalUVs(vertexPtr, vertexCount, 3);
 		}
 
 		vertexCount += 3;
@@ -862,9 +1551,6 @@ public class Batcher : IDisposable
 			vertexArray[0].Mode = mode;
 			vertexArray[1].Mode = mode;
 			vertexArray[2].Mode = mode;
-
-			if (currentBatch.FlipVerticalUV)
-				FlipVerticalUVs(vertexPtr, vertexCount, 3);
 		}
 
 		vertexCount += 3;
@@ -1020,6 +1706,9 @@ public class Batcher : IDisposable
 			// set tris
 			unsafe
 			{
+				SetInstanced(false);
+				if (quadsOnly)
+					ExpandQuadIndices();
 				EnsureIndexCapacity(indexCount + 30);
 
 				var indexArray = new Span<int>((int*)indexPtr + indexCount, 30);
@@ -1470,7 +2159,7 @@ public class Batcher : IDisposable
 
 	public void Image(in Subtexture subtex, Color color)
 	{
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			subtex.DrawCoords0, subtex.DrawCoords1, subtex.DrawCoords2, subtex.DrawCoords3,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1479,7 +2168,7 @@ public class Batcher : IDisposable
 
 	public void Image(in Subtexture subtex, in Vector2 position, Color color)
 	{
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(position + subtex.DrawCoords0, position + subtex.DrawCoords1, position + subtex.DrawCoords2, position + subtex.DrawCoords3,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
 			color);
@@ -1491,7 +2180,7 @@ public class Batcher : IDisposable
 
 		Matrix = Transform.CreateMatrix(position, origin, scale, rotation) * Matrix;
 
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			subtex.DrawCoords0, subtex.DrawCoords1, subtex.DrawCoords2, subtex.DrawCoords3,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1506,7 +2195,7 @@ public class Batcher : IDisposable
 
 		Matrix = Transform.CreateMatrix(position, origin, scale, rotation) * Matrix;
 
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			subtex.DrawCoords0, subtex.DrawCoords1, subtex.DrawCoords2, subtex.DrawCoords3,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1541,7 +2230,7 @@ public class Batcher : IDisposable
 			ty1 = source.Bottom / tex.Height;
 		}
 
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			new Vector2(px0, py0), new Vector2(px1, py0), new Vector2(px1, py1), new Vector2(px0, py1),
 			new Vector2(tx0, ty0), new Vector2(tx1, ty0), new Vector2(tx1, ty1), new Vector2(tx0, ty1),
@@ -1552,7 +2241,7 @@ public class Batcher : IDisposable
 
 	public void ImageStretch(in Subtexture subtex, in Rect rect, Color color)
 	{
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			rect.TopLeft, rect.TopRight, rect.BottomRight, rect.BottomLeft,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1566,7 +2255,7 @@ public class Batcher : IDisposable
 		var pos = rect.Position;
 		Matrix = Transform.CreateMatrix(pos, origin, scale, rotation) * Matrix;
 
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			Vector2.Zero, rect.TopRight - pos, rect.BottomRight - pos, rect.BottomLeft - pos,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1577,7 +2266,7 @@ public class Batcher : IDisposable
 
 	public void ImageStretch(in Subtexture subtex, in Rect rect, Color c0, Color c1, Color c2, Color c3)
 	{
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			rect.TopLeft, rect.TopRight, rect.BottomRight, rect.BottomLeft,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1591,7 +2280,7 @@ public class Batcher : IDisposable
 		var pos = rect.Position;
 		Matrix = Transform.CreateMatrix(pos, origin, scale, rotation) * Matrix;
 
-		SetTexture(subtex.Texture);
+		SetTexture(subtex.Texture, subtex.Layer);
 		Quad(
 			Vector2.Zero, rect.TopRight - pos, rect.BottomRight - pos, rect.BottomLeft - pos,
 			subtex.TexCoords0, subtex.TexCoords1, subtex.TexCoords2, subtex.TexCoords3,
@@ -1673,6 +2362,10 @@ public class Batcher : IDisposable
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private void PushTriangle()
 	{
+		if (currentBatch.Instanced)
+			SetInstanced(false);
+		if (quadsOnly)
+			ExpandQuadIndices();
 		EnsureIndexCapacity(indexCount + 3);
 
 		unsafe
@@ -1692,6 +2385,18 @@ public class Batcher : IDisposable
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private void PushQuad()
 	{
+		if (currentBatch.Instanced)
+			SetInstanced(false);
+
+		// quads use the shared quad indices, which only need to be counted
+		if (quadsOnly)
+		{
+			indexCount += 6;
+			currentBatch.Elements += 2;
+			dirty = true;
+			return;
+		}
+
 		EnsureIndexCapacity(indexCount + 6);
 
 		unsafe
@@ -1711,6 +2416,101 @@ public class Batcher : IDisposable
 		dirty = true;
 	}
 
+	/// <summary>
+	/// Writes out the indices of every quad pushed so far, after which
+	/// indices are always written so arbitrary triangles can be drawn
+	/// </summary>
+	private unsafe void ExpandQuadIndices()
+	{
+		quadsOnly = false;
+
+		// the existing buffer contents are stale, so don't bother copying them when growing
+		var count = indexCount;
+		indexCount = 0;
+		EnsureIndexCapacity(count);
+		indexCount = count;
+
+		var indexArray = (int*)indexPtr;
+		for (int i = 0, v = 0; i < indexCount; i += 6, v += 4)
+		{
+			indexArray[i + 0] = v + 0;
+			indexArray[i + 1] = v + 1;
+			indexArray[i + 2] = v + 2;
+			indexArray[i + 3] = v + 0;
+			indexArray[i + 4] = v + 2;
+			indexArray[i + 5] = v + 3;
+		}
+	}
+
+	/// <summary>
+	/// Pushes a quad as a single Instance, if it's a parallelogram drawn with the default Material.
+	/// Returns false if it has to be drawn as regular vertices instead.
+	/// </summary>
+	private unsafe bool TryPushInstance(in Vector2 v0, in Vector2 v1, in Vector2 v2, in Vector2 v3, in Vector2 t0, in Vector2 t2, in Color color, in Color mode)
+	{
+		if (currentBatch.MaterialState != defaultMaterialState)
+			return false;
+
+		// the opposite corners of a parallelogram share a midpoint
+		var skew = v0 + v2 - v1 - v3;
+		if (MathF.Abs(skew.X) > 0.001f || MathF.Abs(skew.Y) > 0.001f)
+			return false;
+
+		if (!currentBatch.Instanced)
+			SetInstanced(true);
+		EnsureInstanceCapacity(instanceCount + 1);
+
+		var origin = Vector2.Transform(v0, Matrix);
+		var uv0 = TexCoord(t0);
+		var uv2 = TexCoord(t2);
+
+		ref var instance = ref ((Instance*)instancePtr)[instanceCount];
+		instance.Origin = origin;
+		instance.AxisX = Vector2.Transform(v1, Matrix) - origin;
+		instance.AxisY = Vector2.Transform(v3, Matrix) - origin;
+		instance.Tex = new Vector4(uv0.X, uv0.Y, uv2.X, uv2.Y);
+		instance.Col = color;
+		instance.Mode = mode;
+
+		instanceCount++;
+		currentBatch.Elements++;
+		dirty = true;
+		return true;
+	}
+
+	private unsafe void UploadInstances(CommandBuffer? commands)
+	{
+		instanceMesh!.SetInstances(commands, instancePtr, instanceCount, InstanceFormat);
+
+		// every streaming slot has its own vertex buffer, so the corners go in after the instances
+		Span<Vector2> corners = [new(0, 0), new(1, 0), new(1, 1), new(0, 1)];
+		fixed (Vector2* ptr = corners)
+			instanceMesh.SetVertices(commands, new IntPtr(ptr), corners.Length, CornerFormat);
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private unsafe void EnsureInstanceCapacity(int index)
+	{
+		if (index >= instanceCapacity)
+		{
+			if (instanceCapacity == 0)
+				instanceCapacity = 32;
+
+			while (index >= instanceCapacity)
+				instanceCapacity *= 2;
+
+			var newPtr = Marshal.AllocHGlobal(sizeof(Instance) * instanceCapacity);
+
+			if (instanceCount > 0)
+				Buffer.MemoryCopy((void*)instancePtr, (void*)newPtr, instanceCapacity * sizeof(Instance), instanceCount * sizeof(Instance));
+
+			if (instancePtr != IntPtr.Zero)
+				Marshal.FreeHGlobal(instancePtr);
+
+			instancePtr = newPtr;
+		}
+	}
+
 	[MethodImpl(MethodImplOptions.AggressiveInlining)]
 	private unsafe void EnsureIndexCapacity(int index)
 	{
@@ -1739,6 +2539,9 @@ public class Batcher : IDisposable
 	{
 		if (index >= vertexCapacity)
 		{
+			if ((verticesInMesh || (DirectVertexWrites && vertexCount == 0 && !vertexMappingUnsupported)) && MapVertices(index))
+				return;
+
 			if (vertexCapacity == 0)
 				vertexCapacity = 32;
 
@@ -1757,17 +2560,58 @@ public class Batcher : IDisposable
 		}
 	}
 
-	[MethodImpl(MethodImplOptions.AggressiveInlining)]
-	private unsafe void FlipVerticalUVs(IntPtr ptr, int start, int count)
+	private unsafe bool MapVertices(int index)
 	{
-		Vertex* it = (Vertex*)ptr + start;
-		Vertex* end = it + count;
-		while (it < end)
+		// the Mesh can only be mapped on the Main Thread
+		if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+		{
+			if (verticesInMesh)
+				throw new Exception("Batcher vertices written directly into the Mesh can only be continued on the Main Thread");
+			return false;
+		}
+
+		var capacity = Math.Max(32, mappedVertexCapacity);
+		while (index >= capacity)
+			capacity *= 2;
+
+		// remap to fit more vertices, which keeps the ones already written
+		if (vertexMapped)
+			mesh.UnmapVertices();
+
+		var ptr = mesh.MapVertices(vertexCount, capacity - vertexCount, VertexFormat);
+		if (ptr == IntPtr.Zero)
 		{
-			it->Tex.Y = 1.0f - it->Tex.Y;
-			it++;
+			if (verticesInMesh)
+				throw new Exception("Failed to map Batcher vertices");
+			vertexMappingUnsupported = true;
+			return false;
 		}
+
+		// we were using our own (empty) buffer before this
+		if (!verticesInMesh && vertexPtr != IntPtr.Zero)
+			Marshal.FreeHGlobal(vertexPtr);
+
+		// offset the pointer so vertices are still indexed from the start of the Mesh
+		vertexPtr = ptr - vertexCount * sizeof(Vertex);
+		vertexCapacity = mappedVertexCapacity = capacity;
+		vertexMapped = verticesInMesh = true;
+		return true;
 	}
 
+	private void UnmapVertices()
+	{
+		if (vertexMapped)
+			mesh.UnmapVertices();
+
+		// the next write will map the Mesh again from the current vertex count
+		vertexMapped = false;
+		vertexPtr = IntPtr.Zero;
+		vertexCapacity = 0;
+	}
+
+	[MethodImpl(MethodImplOptions.AggressiveInlining)]
+	private Vector2 TexCoord(in Vector2 uv)
+		=> currentBatch.FlipVerticalUV ? new(uv.X, 1.0f - uv.Y) : uv;
+
 	#endregion
 }
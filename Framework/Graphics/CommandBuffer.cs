@@ -0,0 +1,319 @@
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// Records Draw Commands, Clears and data uploads without sending them to the GPU,
+/// so they can be built from any thread and executed on the Main Thread later.
+/// A Command Buffer can only be recorded into by one thread at a time.
+/// Material values and uploaded data are copied when they're recorded, and the
+/// resources they use are kept alive until the Command Buffer is reset.
+/// </summary>
+public class CommandBuffer : IResource
+{
+	/// <summary>
+	/// Optional Command Buffer Name
+	/// </summary>
+	public string Name { get; set; } = string.Empty;
+
+	/// <summary>
+	/// If the Command Buffer has been disposed
+	/// </summary>
+	public bool IsDisposed => disposed;
+
+	internal readonly IntPtr resource;
+	internal bool disposed = false;
+
+	private readonly HashSet<IResource> resources = new();
+	private readonly HashSet<Shader> shaders = new();
+
+	public CommandBuffer()
+	{
+		resource = Platform.FosterCommandListCreate();
+		if (resource == IntPtr.Zero)
+			throw new Exception("Failed to create Command Buffer");
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterCommandListDestroy);
+	}
+
+	~CommandBuffer()
+	{
+		Dispose(false);
+	}
+
+	/// <summary>
+	/// Records a Draw Command, along with the current values of its Material
+	/// </summary>
+	public unsafe void Submit(in DrawCommand command)
+	{
+		var fc = Record(command);
+		Platform.FosterCommandListDraw(resource, &fc);
+	}
+
+	/// <summary>
+	/// Records a Draw Command to be drawn once for each of the given index ranges.
+	/// The Command's own index range is ignored.
+	/// </summary>
+	public unsafe void Submit(in DrawCommand command, ReadOnlySpan<DrawRange> ranges)
+	{
+		if (ranges.Length <= 0)
+			return;
+
+		var fc = Record(command);
+		fixed (DrawRange* ptr = ranges)
+			Platform.FosterCommandListDrawList(resource, &fc, ptr, ranges.Length);
+	}
+
+	/// <summary>
+	/// Records Draw Commands that were already validated, whose Material values
+	/// have been recorded before them
+	/// </summary>
+	internal unsafe void SubmitBatch(ReadOnlySpan<Platform.FosterDrawCommand> commands)
+	{
+		AssertNotDisposed();
+
+		fixed (Platform.FosterDrawCommand* ptr = commands)
+			Platform.FosterCommandListDrawBatch(resource, ptr, commands.Length);
+	}
+
+	/// <summary>
+	/// Records clearing the Target, or the Back Buffer if it's null, to the given Color
+	/// </summary>
+	public void Clear(Target? target, Color color)
+	{
+		Clear(target, color, 0, 0, ClearMask.Color);
+	}
+
+	/// <summary>
+	/// Records clearing the Target, or the Back Buffer if it's null
+	/// </summary>
+	public unsafe void Clear(Target? target, Color color, float depth, int stencil, ClearMask mask)
+	{
+		AssertNotDisposed();
+
+		if (target != null && target.IsDisposed)
+			throw new Exception("Target is Disposed");
+
+		Platform.FosterClearCommand clear = new()
+		{
+			target = target?.resource ?? IntPtr.Zero,
+			clip = target != null ? new(0, 0, target.Width, target.Height) : new(0, 0, Graphics.Width, Graphics.Height),
+			color = color,
+			depth = depth,
+			stencil = stencil,
+			mask = mask
+		};
+
+		Keep(target);
+		Platform.FosterCommandListClear(resource, &clear);
+	}
+
+	/// <summary>
+	/// Records uploading the Index Data to the Mesh
+	/// </summary>
+	public unsafe void SetIndices<T>(Mesh mesh, ReadOnlySpan<T> indices) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(indices))
+			SetIndices(mesh, new IntPtr(ptr), indices.Length, Mesh.GetIndexFormat<T>());
+	}
+
+	/// <summary>
+	/// Records uploading the Index Data to the Mesh
+	/// </summary>
+	public void SetIndices(Mesh mesh, nint data, int count, IndexFormat format)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetIndices(this, data, count, format);
+	}
+
+	/// <summary>
+	/// Records uploading a sub area of Index Data to the Mesh.
+	/// See <see cref="Mesh.SetSubIndices(int, nint, int)"/>
+	/// </summary>
+	public void SetSubIndices(Mesh mesh, int offset, nint data, int count)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetSubIndices(this, offset, data, count);
+	}
+
+	/// <summary>
+	/// Records the Mesh using shared Index data for the given number of Quads.
+	/// See <see cref="Mesh.SetQuadIndices(int)"/>
+	/// </summary>
+	public void SetQuadIndices(Mesh mesh, int quadCount)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetQuadIndices(this, quadCount);
+	}
+
+	/// <summary>
+	/// Records uploading the Vertex Data to the Mesh
+	/// </summary>
+	public unsafe void SetVertices<T>(Mesh mesh, ReadOnlySpan<T> vertices, VertexFormat format) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(vertices))
+			SetVertices(mesh, new IntPtr(ptr), vertices.Length, format);
+	}
+
+	/// <summary>
+	/// Records uploading the Vertex Data to the Mesh
+	/// </summary>
+	public void SetVertices(Mesh mesh, IntPtr data, int count, VertexFormat format)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetVertices(this, data, count, format);
+	}
+
+	/// <summary>
+	/// Records uploading a sub area of Vertex Data to the Mesh.
+	/// See <see cref="Mesh.SetSubVertices(int, nint, int)"/>
+	/// </summary>
+	public unsafe void SetSubVertices<T>(Mesh mesh, int offset, ReadOnlySpan<T> vertices) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(vertices))
+			SetSubVertices(mesh, offset, new IntPtr(ptr), vertices.Length);
+	}
+
+	/// <summary>
+	/// Records uploading a sub area of Vertex Data to the Mesh.
+	/// See <see cref="Mesh.SetSubVertices(int, nint, int)"/>
+	/// </summary>
+	public void SetSubVertices(Mesh mesh, int offset, IntPtr data, int count)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetSubVertices(this, offset, data, count);
+	}
+
+	/// <summary>
+	/// Records uploading the per-Instance Data to the Mesh
+	/// </summary>
+	public unsafe void SetInstances<T>(Mesh mesh, ReadOnlySpan<T> instances, VertexFormat format) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(instances))
+			SetInstances(mesh, new IntPtr(ptr), instances.Length, format);
+	}
+
+	/// <summary>
+	/// Records uploading the per-Instance Data to the Mesh
+	/// </summary>
+	public void SetInstances(Mesh mesh, IntPtr data, int count, VertexFormat format)
+	{
+		AssertNotDisposed();
+		Keep(mesh);
+		mesh.SetInstances(this, data, count, format);
+	}
+
+	/// <summary>
+	/// Records uploading values to the Uniform Buffer at the given byte offset.
+	/// The values must match the std140 layout of the Uniform Block.
+	/// </summary>
+	public unsafe void SetData<T>(UniformBuffer buffer, ReadOnlySpan<T> data, int offset = 0) where T : unmanaged
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+			SetData(buffer, new IntPtr(ptr), data.Length * sizeof(T), offset);
+	}
+
+	/// <summary>
+	/// Records uploading data to the Uniform Buffer at the given byte offset.
+	/// </summary>
+	public void SetData(UniformBuffer buffer, IntPtr data, int length, int offset = 0)
+	{
+		AssertNotDisposed();
+
+		if (buffer.IsDisposed)
+			throw new Exception("Uniform Buffer is Disposed");
+
+		if (offset < 0 || offset + length > buffer.Size)
+			throw new Exception("Data is out of range of the Uniform Buffer");
+
+		Keep(buffer);
+		Platform.FosterCommandListUniformBufferSetData(resource, buffer.resource, data, length, offset);
+	}
+
+	/// <summary>
+	/// Executes everything recorded into the Command Buffer, in the order it was recorded.
+	/// This must be called from the Main Thread. The Command Buffer keeps its contents
+	/// and can be executed again until it's reset.
+	/// </summary>
+	public void Execute()
+	{
+		AssertNotDisposed();
+
+		if (Thread.CurrentThread.ManagedThreadId != App.MainThreadID)
+			throw new Exception("Command Buffers can only be executed on the Main Thread");
+
+		foreach (var it in resources)
+		{
+			if (it.IsDisposed)
+				throw new Exception("A resource used by the Command Buffer was Disposed before it was executed");
+		}
+
+		Platform.FosterExecuteCommandList(resource);
+
+		// Material values were uploaded behind the Materials' backs
+		foreach (var shader in shaders)
+			shader.appliedMaterial = null;
+	}
+
+	/// <summary>
+	/// Clears everything that has been recorded, so the Command Buffer can be reused
+	/// </summary>
+	public void Reset()
+	{
+		AssertNotDisposed();
+
+		Platform.FosterCommandListReset(resource);
+		resources.Clear();
+		shaders.Clear();
+	}
+
+	/// <summary>
+	/// Keeps a resource alive until the Command Buffer is reset
+	/// </summary>
+	internal void Keep(IResource? resource)
+	{
+		if (resource == null)
+			return;
+
+		resources.Add(resource);
+		if (resource is Shader shader)
+			shaders.Add(shader);
+	}
+
+	private Platform.FosterDrawCommand Record(in DrawCommand command)
+	{
+		AssertNotDisposed();
+
+		var fc = Graphics.GetPlatformCommand(command);
+		command.Material?.Apply(this);
+		Keep(command.Target);
+		Keep(command.Mesh);
+		Keep(command.Pipeline);
+		return fc;
+	}
+
+	private void AssertNotDisposed()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+	}
+
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (!disposed)
+		{
+			disposed = true;
+			Graphics.Resources.RequestDelete(resource);
+		}
+	}
+}
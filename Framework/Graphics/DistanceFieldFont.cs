@@ -0,0 +1,382 @@
+using System.Numerics;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// A Font that renders text from Signed Distance Field glyphs, so that one set of glyphs
+/// can be drawn at any size. Glyphs are rendered once at the <see cref="BakeSize"/> as they're
+/// requested, into a single channel Texture whose cells are reused for the least recently
+/// drawn glyphs once it fills up.
+/// For small or pixel-perfect text, a <see cref="SpriteFont"/> per size will look sharper.
+/// </summary>
+public class DistanceFieldFont
+{
+	public readonly record struct Character(
+		int Codepoint,
+		int Glyph,
+		float Advance,
+		Vector2 Offset,
+		Vector2 Size,
+		bool Exists
+	);
+
+	private readonly record struct KerningPair(int First, int Second);
+
+	private class Cell
+	{
+		public int Codepoint;
+		public RectInt Bounds;
+		public RectInt Source;
+		public Vector2 Offset;
+		public ulong LastUsedFrame;
+		public LinkedListNode<Cell>? Node;
+	}
+
+	/// <summary>
+	/// The Font being used
+	/// </summary>
+	public readonly Font Font;
+
+	/// <summary>
+	/// Name of the Font. Not used internally.
+	/// </summary>
+	public string Name = string.Empty;
+
+	/// <summary>
+	/// The size glyphs are rendered at to create their distance fields
+	/// </summary>
+	public readonly float BakeSize;
+
+	/// <summary>
+	/// How many pixels the distance fields extend past the edges of each glyph, at the <see cref="BakeSize"/>
+	/// </summary>
+	public readonly int Padding;
+
+	/// <summary>
+	/// The Texture holding the distance fields of the glyphs that are currently cached
+	/// </summary>
+	public readonly Texture Texture;
+
+	/// <summary>
+	/// Newline characters to use during various text measuring and rendering methods.
+	/// </summary>
+	public readonly List<char> NewlineCharacters = [ '\n' ];
+
+	private readonly float bakeScale;
+	private readonly int cellSize;
+	private readonly Dictionary<int, Character> characters = [];
+	private readonly Dictionary<int, Cell> cached = [];
+	private readonly Dictionary<KerningPair, float> kerning = [];
+	private readonly LinkedList<Cell> leastRecentlyUsed = [];
+	private readonly Stack<Cell> unused = [];
+	private readonly Material material = new();
+	private byte[] glyphBuffer = [];
+	private byte[] cellBuffer = [];
+
+	private static Shader? DistanceFieldShader;
+
+	public DistanceFieldFont(Font font, float bakeSize = 48, int padding = 6, int textureSize = 1024)
+	{
+		Font = font;
+		BakeSize = bakeSize;
+		Padding = Math.Max(1, padding);
+		bakeScale = font.GetScale(bakeSize);
+
+		// every cell is large enough for a glyph as tall as the font, and its padding
+		cellSize = (int)MathF.Ceiling(font.Height * bakeScale) + Padding * 2;
+		if (cellSize > textureSize)
+			throw new Exception("The Distance Field Font's Texture is too small to fit any glyphs");
+
+		// cells must be cleared, as they're sampled past the edges of each glyph
+		Texture = new Texture(textureSize, textureSize, TextureFormat.R8);
+		Texture.SetData<byte>(new byte[textureSize * textureSize]);
+
+		// the Shader is created along with the Texture, as both must be done on the Main Thread
+		if (DistanceFieldShader == null || DistanceFieldShader.IsDisposed)
+		{
+			if (!ShaderDefaults.BatcherDistanceField.TryGetValue(Graphics.Renderer, out var info))
+				throw new Exception($"There is no Distance Field shader for {Graphics.Renderer}");
+			DistanceFieldShader = new Shader(info);
+		}
+		material.SetShader(DistanceFieldShader);
+
+		for (int y = textureSize / cellSize - 1; y >= 0; y--)
+			for (int x = textureSize / cellSize - 1; x >= 0; x--)
+				unused.Push(new() { Bounds = new(x * cellSize, y * cellSize, cellSize, cellSize) });
+	}
+
+	public DistanceFieldFont(string path, float bakeSize = 48, int padding = 6, int textureSize = 1024)
+		: this(new Font(path), bakeSize, padding, textureSize)
+	{
+
+	}
+
+	/// <summary>
+	/// The number of glyphs the Texture can hold at once
+	/// </summary>
+	public int Capacity => (Texture.Width / cellSize) * (Texture.Height / cellSize);
+
+	/// <summary>
+	/// Font Ascent at the given size
+	/// </summary>
+	public float AscentOf(float size) => Font.Ascent * Font.GetScale(size);
+
+	/// <summary>
+	/// Line Height (including Line Gap) at the given size
+	/// </summary>
+	public float LineHeightOf(float size) => Font.LineHeight * Font.GetScale(size);
+
+	/// <summary>
+	/// Gets the metrics of a Character at the <see cref="BakeSize"/>
+	/// </summary>
+	public Character GetCharacter(int codepoint)
+	{
+		if (!characters.TryGetValue(codepoint, out var value))
+		{
+			var glyph = Font.GetGlyphIndex(codepoint);
+			var metrics = Font.GetCharacterOfGlyph(glyph, bakeScale);
+			characters[codepoint] = value = new(
+				codepoint,
+				glyph,
+				metrics.Advance,
+				metrics.Offset,
+				new(metrics.Width, metrics.Height),
+				glyph != 0);
+		}
+
+		return value;
+	}
+
+	public bool TryGetCharacter(ReadOnlySpan<char> text, int index, out Character character, out int length)
+	{
+		if (index + 1 < text.Length && char.IsSurrogatePair(text[index], text[index + 1]))
+		{
+			length = 2;
+			character = GetCharacter(char.ConvertToUtf32(text[index], text[index + 1]));
+		}
+		else
+		{
+			length = 1;
+			character = GetCharacter(text[index]);
+		}
+
+		return character.Exists;
+	}
+
+	/// <summary>
+	/// Gets the kerning between two codepoints at the <see cref="BakeSize"/>
+	/// </summary>
+	public float GetKerning(int codepointFirst, int codepointSecond)
+	{
+		var key = new KerningPair(codepointFirst, codepointSecond);
+		if (!kerning.TryGetValue(key, out var value))
+			kerning[key] = value = Font.GetKerning(codepointFirst, codepointSecond, bakeScale);
+		return value;
+	}
+
+	/// <summary>
+	/// Calculates the width of the given text at the given size. If the text has
+	/// multiple lines, then the width of the widest line will be returned.
+	/// </summary>
+	public float WidthOf(ReadOnlySpan<char> text, float size)
+	{
+		float width = 0;
+		float lineWidth = 0;
+		int lastCodepoint = 0;
+
+		for (int i = 0; i < text.Length; i ++)
+		{
+			if (NewlineCharacters.Contains(text[i]))
+			{
+				lineWidth = 0;
+				lastCodepoint = 0;
+				continue;
+			}
+
+			if (TryGetCharacter(text, i, out var ch, out var step))
+			{
+				lineWidth += ch.Advance;
+				if (lastCodepoint != 0)
+					lineWidth += GetKerning(lastCodepoint, ch.Codepoint);
+				if (lineWidth > width)
+					width = lineWidth;
+				lastCodepoint = ch.Codepoint;
+				i += step - 1;
+			}
+		}
+
+		return width * size / BakeSize;
+	}
+
+	/// <summary>
+	/// Calculates the width of the given text at the given size, up to the first line-break.
+	/// </summary>
+	public float WidthOfLine(ReadOnlySpan<char> text, float size)
+	{
+		for (int i = 0; i < text.Length; i ++)
+			if (NewlineCharacters.Contains(text[i]))
+				return WidthOf(text[..i], size);
+		return WidthOf(text, size);
+	}
+
+	/// <summary>
+	/// Calculate the height of the given text at the given size
+	/// </summary>
+	public float HeightOf(ReadOnlySpan<char> text, float size)
+	{
+		if (text.Length <= 0)
+			return 0;
+
+		var scale = Font.GetScale(size);
+		float height = Font.LineHeight * scale;
+
+		for (int i = 0; i < text.Length; i ++)
+		{
+			if (NewlineCharacters.Contains(text[i]))
+				height += Font.LineHeight * scale;
+		}
+
+		return height - Font.LineGap * scale;
+	}
+
+	/// <summary>
+	/// Renders the given characters into the Texture ahead of time, so they
+	/// don't need to be rendered the first frame they're drawn.
+	/// </summary>
+	public void PrepareCharacters(ReadOnlySpan<int> codepoints)
+	{
+		foreach (var it in codepoints)
+			TryGetCell(GetCharacter(it), out _, out _);
+	}
+
+	public void RenderText(Batcher batch, ReadOnlySpan<char> text, Vector2 position, float size, Color color)
+	{
+		RenderText(batch, text, position, Vector2.Zero, size, color);
+	}
+
+	public void RenderText(Batcher batch, ReadOnlySpan<char> text, Vector2 position, Vector2 justify, float size, Color color)
+	{
+		var scale = size / BakeSize;
+		var at = position + new Vector2(0, AscentOf(size));
+		var last = 0;
+
+		if (justify.X != 0)
+			at.X -= justify.X * WidthOfLine(text, size);
+
+		if (justify.Y != 0)
+			at.Y -= justify.Y * HeightOf(text, size);
+
+		batch.PushMaterial(material);
+		batch.PushSampler(new(TextureFilter.Linear, TextureWrap.ClampToEdge, TextureWrap.ClampToEdge));
+
+		for (int i = 0; i < text.Length; i++)
+		{
+			if (text[i] == '\n')
+			{
+				at.X = position.X;
+				if (justify.X != 0 && i < text.Length - 1)
+					at.X -= justify.X * WidthOfLine(text[(i + 1)..], size);
+				at.Y += LineHeightOf(size);
+				last = 0;
+				continue;
+			}
+
+			if (TryGetCharacter(text, i, out var ch, out var step))
+			{
+				if (last != 0)
+					at.X += GetKerning(last, ch.Codepoint) * scale;
+
+				if (TryGetCell(ch, out var bounds, out var offset))
+				{
+					var subtex = new Subtexture(Texture, bounds);
+					batch.Image(subtex, at + offset * scale, Vector2.Zero, new Vector2(scale), 0, color);
+				}
+
+				last = ch.Codepoint;
+				at.X += ch.Advance * scale;
+				i += step - 1;
+			}
+		}
+
+		batch.PopSampler();
+		batch.PopMaterial();
+	}
+
+	private bool TryGetCell(in Character ch, out RectInt bounds, out Vector2 offset)
+	{
+		bounds = default;
+		offset = default;
+
+		if (ch.Size.X <= 0 || ch.Size.Y <= 0)
+			return false;
+
+		if (cached.TryGetValue(ch.Codepoint, out var cell))
+		{
+			leastRecentlyUsed.Remove(cell.Node!);
+			leastRecentlyUsed.AddFirst(cell.Node!);
+			cell.LastUsedFrame = Time.Frame;
+			bounds = cell.Source;
+			offset = cell.Offset;
+			return true;
+		}
+
+		if (!Font.GetDistanceField(ch.Glyph, bakeScale, Padding, ref glyphBuffer, out int width, out int height, out var fieldOffset))
+			return false;
+
+		// unusual case where the glyph is much larger than the rest of the font
+		if (width > cellSize || height > cellSize)
+		{
+			Log.Warning($"Distance Field Font Character was too large to render to a Texture!");
+			return false;
+		}
+
+		// take an unused cell, or reuse the least recently drawn one
+		if (!unused.TryPop(out cell))
+		{
+			cell = leastRecentlyUsed.Last!.Value;
+
+			// every cell has been drawn this frame, so reusing one would change text that's already been drawn
+			if (cell.LastUsedFrame == Time.Frame)
+			{
+				Log.Warning($"Distance Field Font Texture is too small to draw this many different Characters at once!");
+				return false;
+			}
+
+			leastRecentlyUsed.RemoveLast();
+			cached.Remove(cell.Codepoint);
+		}
+
+		// upload the whole cell, so nothing from a previous glyph is left around it
+		if (cellBuffer.Length < cellSize * cellSize)
+			cellBuffer = new byte[cellSize * cellSize];
+		Array.Clear(cellBuffer);
+		for (int y = 0; y < height; y ++)
+			glyphBuffer.AsSpan(y * width, width).CopyTo(cellBuffer.AsSpan(y * cellSize, width));
+		Texture.SetData<byte>(cellBuffer, cell.Bounds);
+
+		// the field's offset is from the pen position, where the character's horizontal offset is only its bearing
+		cell.Codepoint = ch.Codepoint;
+		cell.Source = new RectInt(cell.Bounds.X, cell.Bounds.Y, width, height);
+		cell.Offset = new Vector2(fieldOffset.X, fieldOffset.Y);
+		cell.LastUsedFrame = Time.Frame;
+		cell.Node = leastRecentlyUsed.AddFirst(cell);
+		cached[ch.Codepoint] = cell;
+
+		bounds = cell.Source;
+		offset = cell.Offset;
+		return true;
+	}
+}
+
+public static class DistanceFieldFontBatcherExt
+{
+	public static void Text(this Batcher batch, DistanceFieldFont font, ReadOnlySpan<char> text, Vector2 position, float size, Color color)
+	{
+		font.RenderText(batch, text, position, Vector2.Zero, size, color);
+	}
+
+	public static void Text(this Batcher batch, DistanceFieldFont font, ReadOnlySpan<char> text, Vector2 position, Vector2 justify, float size, Color color)
+	{
+		font.RenderText(batch, text, position, justify, size, color);
+	}
+}
@@ -28,6 +28,16 @@ public struct DrawCommand()
 	/// </summary>
 	public int MeshIndexCount;
 
+	/// <summary>
+	/// The number of Instances to draw, or 0 to draw without instancing
+	/// </summary>
+	public int InstanceCount;
+
+	/// <summary>
+	/// The first Instance to draw from the Mesh's Instance data
+	/// </summary>
+	public int InstanceStart;
+
 	/// <summary>
 	/// The Render State Blend Mode
 	/// </summary>
@@ -48,6 +58,12 @@ public struct DrawCommand()
 	/// </summary>
 	public bool DepthMask = false;
 
+	/// <summary>
+	/// Optional Pipeline, which when assigned replaces the Blend Mode, Cull Mode,
+	/// Depth Compare and Depth Mask with its own. Its Shader must match the Material's.
+	/// </summary>
+	public Pipeline? Pipeline = null;
+
 	/// <summary>
 	/// Render Viewport
 	/// </summary>
@@ -75,4 +91,13 @@ public struct DrawCommand()
 	{
 		Graphics.Submit(this);
 	}
+
+	/// <summary>
+	/// Submits the Draw Command once for each of the given index ranges.
+	/// The Command's own MeshIndexStart and MeshIndexCount are ignored.
+	/// </summary>
+	public readonly void Submit(ReadOnlySpan<DrawRange> ranges)
+	{
+		Graphics.Submit(this, ranges);
+	}
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// A range of Mesh indices drawn as part of a Draw List.
+/// See <see cref="DrawCommand.Submit(ReadOnlySpan{DrawRange})"/>
+/// </summary>
+[StructLayout(LayoutKind.Sequential)]
+public struct DrawRange(int indexStart, int indexCount, int baseVertex = 0)
+{
+	/// <summary>
+	/// The first Mesh index to draw
+	/// </summary>
+	public int IndexStart = indexStart;
+
+	/// <summary>
+	/// The number of Mesh indices to draw
+	/// </summary>
+	public int IndexCount = indexCount;
+
+	/// <summary>
+	/// A value added to every index in the range before fetching its vertex
+	/// </summary>
+	public int BaseVertex = baseVertex;
+}
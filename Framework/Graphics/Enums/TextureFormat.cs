@@ -17,6 +17,31 @@ public enum TextureFormat
 	/// </summary>
 	Depth24Stencil8,
 
+	/// <summary>
+	/// Block compressed RGB with 1-bit Alpha, 8 bytes per 4x4 block (DXT1)
+	/// </summary>
+	BC1,
+
+	/// <summary>
+	/// Block compressed RGBA, 16 bytes per 4x4 block (DXT5)
+	/// </summary>
+	BC3,
+
+	/// <summary>
+	/// High quality block compressed RGBA, 16 bytes per 4x4 block
+	/// </summary>
+	BC7,
+
+	/// <summary>
+	/// Block compressed RGBA for GLES / mobile, 16 bytes per 4x4 block
+	/// </summary>
+	ETC2,
+
+	/// <summary>
+	/// Block compressed RGBA for GLES / mobile, 16 bytes per 4x4 block
+	/// </summary>
+	ASTC4x4,
+
 	/// <summary>
 	/// Shorthand for R8G8B8A8
 	/// </summary>
@@ -25,6 +50,9 @@ public enum TextureFormat
 
 public static class TextureFormatExt
 {
+	/// <summary>
+	/// The size of a single pixel, in bytes. Compressed formats don't have one.
+	/// </summary>
 	public static int Size(this TextureFormat format)
 		=> format switch
 		{
@@ -33,4 +61,29 @@ public static class TextureFormatExt
 			TextureFormat.Depth24Stencil8 => 4,
 			_ => throw new NotImplementedException()
 		};
+
+	/// <summary>
+	/// If the format is stored in compressed 4x4 pixel blocks
+	/// </summary>
+	public static bool IsCompressed(this TextureFormat format)
+		=> format switch
+		{
+			TextureFormat.BC1 => true,
+			TextureFormat.BC3 => true,
+			TextureFormat.BC7 => true,
+			TextureFormat.ETC2 => true,
+			TextureFormat.ASTC4x4 => true,
+			_ => false
+		};
+
+	/// <summary>
+	/// The size of an image of the given dimensions, in bytes
+	/// </summary>
+	public static int DataSize(this TextureFormat format, int width, int height)
+		=> format switch
+		{
+			TextureFormat.BC1 => ((width + 3) / 4) * ((height + 3) / 4) * 8,
+			_ when format.IsCompressed() => ((width + 3) / 4) * ((height + 3) / 4) * 16,
+			_ => width * height * format.Size()
+		};
 }
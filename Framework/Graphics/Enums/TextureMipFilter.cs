@@ -0,0 +1,19 @@
+namespace Foster.Framework;
+
+public enum TextureMipFilter
+{
+	/// <summary>
+	/// Mipmaps are not used, and only the full size Texture is sampled
+	/// </summary>
+	None,
+
+	/// <summary>
+	/// Samples the nearest Mip Level
+	/// </summary>
+	Nearest,
+
+	/// <summary>
+	/// Blends between the two nearest Mip Levels
+	/// </summary>
+	Linear,
+}
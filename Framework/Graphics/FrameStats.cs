@@ -0,0 +1,71 @@
+namespace Foster.Framework;
+
+/// <summary>
+/// Render statistics of the last completed frame.
+/// See <see cref="Graphics.GetFrameStats"/>
+/// </summary>
+public readonly struct FrameStats
+{
+	/// <summary>
+	/// The number of draw calls sent to the GPU
+	/// </summary>
+	public readonly int DrawCalls;
+
+	/// <summary>
+	/// The number of render state changes that were sent to the GPU
+	/// </summary>
+	public readonly int StateChanges;
+
+	/// <summary>
+	/// The number of render state changes that were skipped, as the state was already current
+	/// </summary>
+	public readonly int StateChangesSkipped;
+
+	/// <summary>
+	/// The number of Textures bound to be sampled from
+	/// </summary>
+	public readonly int TextureBinds;
+
+	/// <summary>
+	/// The number of bytes uploaded to Mesh and Uniform Buffers
+	/// </summary>
+	public readonly long BufferBytesUploaded;
+
+	/// <summary>
+	/// The number of bytes uploaded to Textures
+	/// </summary>
+	public readonly long TextureBytesUploaded;
+
+	/// <summary>
+	/// The time the GPU spent on the frame, or null if the Renderer can't measure it.
+	/// GPU results trail behind by a few frames, so this is the latest one available.
+	/// </summary>
+	public readonly TimeSpan? GpuTime;
+
+	/// <summary>
+	/// The number of GPU Scopes timed within the frame of <see cref="GpuTime"/>.
+	/// See <see cref="Graphics.GetGpuScopes"/>
+	/// </summary>
+	public readonly int GpuScopeCount;
+
+	internal FrameStats(in Platform.FosterFrameStats stats)
+	{
+		DrawCalls = stats.drawCalls;
+		StateChanges = stats.stateChanges;
+		StateChangesSkipped = stats.stateChangesSkipped;
+		TextureBinds = stats.textureBinds;
+		BufferBytesUploaded = stats.bufferBytesUploaded;
+		TextureBytesUploaded = stats.textureBytesUploaded;
+		GpuTime = stats.gpuTime >= 0 ? TimeSpan.FromMilliseconds(stats.gpuTime) : null;
+		GpuScopeCount = stats.gpuScopeCount;
+	}
+}
+
+/// <summary>
+/// The time the GPU spent within a labeled scope.
+/// See <see cref="Graphics.BeginGpuScope(string)"/>
+/// </summary>
+/// <param name="Name">The name the Scope was begun with</param>
+/// <param name="Depth">How many Scopes it was nested inside of</param>
+/// <param name="Time">The time the GPU spent within the Scope</param>
+public readonly record struct GpuScope(string Name, int Depth, TimeSpan Time);
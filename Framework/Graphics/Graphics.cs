@@ -25,6 +25,13 @@ namespace Foster.Framework
 		/// </summary>
 		public static int MaxTextureSize { get; private set; }
 
+		/// <summary>
+		/// Checks if Textures of the given Format can be created by the current Renderer.
+		/// Compressed formats depend on the GPU and driver.
+		/// </summary>
+		public static bool IsTextureFormatSupported(TextureFormat format)
+			=> Platform.FosterTextureFormatSupported(format) != 0;
+
 		/// <summary>
 		/// If our (0,0) in our coordinate system is bottom-left.
 		/// This is true in OpenGL
@@ -68,6 +75,92 @@ namespace Foster.Framework
 		}
 
 		public static unsafe void Submit(in DrawCommand command)
+		{
+			var fc = GetPlatformCommand(command);
+
+			// apply material values before drawing
+			command.Material?.Apply();
+
+			// perform draw
+			Platform.FosterDraw(&fc);
+		}
+
+		/// <summary>
+		/// Submits a Draw Command once for each of the given index ranges, which the
+		/// Renderer can send to the GPU in a single call. The Command's own index range is ignored.
+		/// </summary>
+		public static unsafe void Submit(in DrawCommand command, ReadOnlySpan<DrawRange> ranges)
+		{
+			if (ranges.Length <= 0)
+				return;
+
+			var fc = GetPlatformCommand(command);
+
+			// apply material values before drawing
+			command.Material?.Apply();
+
+			// perform draw
+			fixed (DrawRange* ptr = ranges)
+				Platform.FosterDrawList(&fc, ptr, ranges.Length);
+		}
+
+		/// <summary>
+		/// Gets the render statistics of the last completed frame
+		/// </summary>
+		public static FrameStats GetFrameStats()
+		{
+			Platform.FosterGetFrameStats(out var stats);
+			return new FrameStats(stats);
+		}
+
+		/// <summary>
+		/// Begins a labeled Scope whose GPU time is measured, which can be nested.
+		/// Does nothing if the Renderer can't measure GPU time.
+		/// </summary>
+		public static void BeginGpuScope(string name)
+		{
+			Platform.FosterGpuScopeBegin(name);
+		}
+
+		/// <summary>
+		/// Ends the most recent Scope begun with <see cref="BeginGpuScope(string)"/>
+		/// </summary>
+		public static void EndGpuScope()
+		{
+			Platform.FosterGpuScopeEnd();
+		}
+
+		/// <summary>
+		/// Adds the GPU times of the Scopes within the frame reported by
+		/// <see cref="GetFrameStats"/> to the list, in the order they were begun.
+		/// Returns how many were added.
+		/// </summary>
+		public static unsafe int GetGpuScopes(List<GpuScope> output)
+		{
+			var scopes = stackalloc Platform.FosterGpuScope[MaxGpuScopes];
+			var count = Platform.FosterGetGpuScopes(scopes, MaxGpuScopes);
+
+			for (int i = 0; i < count; i++)
+			{
+				output.Add(new(
+					Platform.ParseUTF8(scopes[i].name),
+					scopes[i].depth,
+					TimeSpan.FromMilliseconds(scopes[i].time)));
+			}
+
+			return count;
+		}
+
+		/// <summary>
+		/// The most GPU Scopes the Renderer times per frame
+		/// </summary>
+		private const int MaxGpuScopes = 32;
+
+		/// <summary>
+		/// Validates the Draw Command and converts it to the Platform representation.
+		/// Note this does not apply the Material values.
+		/// </summary>
+		internal static Platform.FosterDrawCommand GetPlatformCommand(in DrawCommand command)
 		{
 			IntPtr shader = IntPtr.Zero;
 			if (command.Material != null && command.Material.Shader != null && !command.Material.Shader.IsDisposed)
@@ -76,6 +169,16 @@ namespace Foster.Framework
 			if (shader == IntPtr.Zero)
 				throw new Exception("Material Shader is Invalid");
 
+			IntPtr pipeline = IntPtr.Zero;
+			if (command.Pipeline != null)
+			{
+				if (command.Pipeline.IsDisposed)
+					throw new Exception("Pipeline is Disposed");
+				if (command.Pipeline.Shader != command.Material!.Shader)
+					throw new Exception("Pipeline Shader does not match the Material Shader");
+				pipeline = command.Pipeline.resource;
+			}
+
 			if (command.Target != null && command.Target.IsDisposed)
 				throw new Exception("Mesh is Invalid");
 
@@ -91,11 +194,13 @@ namespace Foster.Framework
 				hasScissor = command.Scissor.HasValue ? 1 : 0,
 				indexStart = command.MeshIndexStart,
 				indexCount = command.MeshIndexCount,
-				instanceCount = 0,
+				instanceCount = command.InstanceCount,
+				instanceStart = command.InstanceStart,
 				compare = command.DepthCompare,
 				depthMask = command.DepthMask ? 1 : 0,
 				cull = command.CullMode,
 				blend = command.BlendMode,
+				pipeline = pipeline,
 			};
 
 			if (command.Viewport.HasValue)
@@ -118,11 +223,7 @@ namespace Foster.Framework
 				);
 			}
 
-			// apply material values before drawing
-			command.Material?.Apply();
-
-			// perform draw
-			Platform.FosterDraw(&fc);
+			return fc;
 		}
 
 		internal static class Resources
@@ -143,6 +244,16 @@ namespace Foster.Framework
 					allocated.Add(handle, alloc);
 			}
 
+			/// <summary>
+			/// Stops tracking a graphical resource that has already been freed by the Platform,
+			/// such as a Texture Upload once it has been Submitted
+			/// </summary>
+			public static void Unregister(IntPtr handle)
+			{
+				lock (allocated)
+					allocated.Remove(handle);
+			}
+
 			/// <summary>
 			/// Requests that a graphical resource be deleted.
 			/// Running on the main thread performs the resource deletion
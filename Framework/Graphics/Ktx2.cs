@@ -0,0 +1,153 @@
+using System.Buffers.Binary;
+using System.IO.MemoryMappedFiles;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// Reads KTX2 containers, which hold Texture data that's already in its GPU format
+/// (usually block compressed) and can be uploaded without being decoded first.
+/// Only single 2D images without supercompression are supported.
+/// sRGB formats are loaded as their regular counterparts.
+/// </summary>
+public static class Ktx2
+{
+	/// <summary>
+	/// The contents of a KTX2 container header
+	/// </summary>
+	public readonly record struct Header(
+		TextureFormat Format,
+		int Width,
+		int Height,
+		int LevelCount,
+		long DataOffset,
+		int DataLength
+	);
+
+	private static ReadOnlySpan<byte> Identifier => [0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A];
+
+	private const int HeaderSize = 80;
+	private const int LevelSize = 24;
+
+	/// <summary>
+	/// Checks if the data starts with the KTX2 identifier
+	/// </summary>
+	public static bool IsKtx2(ReadOnlySpan<byte> data)
+		=> data.Length >= Identifier.Length && data[..Identifier.Length].SequenceEqual(Identifier);
+
+	/// <summary>
+	/// Reads the KTX2 header, and finds the data of the first Mip Level
+	/// </summary>
+	public static Header ReadHeader(ReadOnlySpan<byte> data)
+	{
+		if (!IsKtx2(data) || data.Length < HeaderSize + LevelSize)
+			throw new Exception("Data is not a KTX2 container");
+
+		var vkFormat = BinaryPrimitives.ReadUInt32LittleEndian(data[12..]);
+		var width = BinaryPrimitives.ReadUInt32LittleEndian(data[20..]);
+		var height = BinaryPrimitives.ReadUInt32LittleEndian(data[24..]);
+		var depth = BinaryPrimitives.ReadUInt32LittleEndian(data[28..]);
+		var layers = BinaryPrimitives.ReadUInt32LittleEndian(data[32..]);
+		var faces = BinaryPrimitives.ReadUInt32LittleEndian(data[36..]);
+		var levels = BinaryPrimitives.ReadUInt32LittleEndian(data[40..]);
+		var supercompression = BinaryPrimitives.ReadUInt32LittleEndian(data[44..]);
+
+		if (width <= 0 || height <= 0 || depth > 1 || layers > 1 || faces != 1)
+			throw new Exception("Only 2D KTX2 images are supported");
+		if (supercompression != 0)
+			throw new Exception("Supercompressed KTX2 data is not supported");
+
+		var format = GetFormat(vkFormat) ??
+			throw new Exception($"KTX2 format {vkFormat} is not supported");
+
+		if (data.Length < HeaderSize + LevelSize * Math.Max(1, (int)levels))
+			throw new Exception("KTX2 level index is out of bounds");
+
+		var (offset, length) = GetLevel(data, format, (int)width, (int)height, 0);
+		return new(format, (int)width, (int)height, Math.Max(1, (int)levels), offset, length);
+	}
+
+	/// <summary>
+	/// Finds and validates the data of a Mip Level in the level index,
+	/// which follows the header and starts from the largest level
+	/// </summary>
+	private static (long Offset, int Length) GetLevel(ReadOnlySpan<byte> data, TextureFormat format, int width, int height, int level)
+	{
+		var offset = BinaryPrimitives.ReadUInt64LittleEndian(data[(HeaderSize + level * LevelSize)..]);
+		var length = BinaryPrimitives.ReadUInt64LittleEndian(data[(HeaderSize + level * LevelSize + 8)..]);
+
+		if (offset + length > (ulong)data.Length)
+			throw new Exception("KTX2 level data is out of bounds");
+		if (length < (ulong)format.DataSize(Math.Max(1, width >> level), Math.Max(1, height >> level)))
+			throw new Exception("KTX2 level data is smaller than the image");
+
+		return ((long)offset, (int)length);
+	}
+
+	/// <summary>
+	/// Creates a Texture from KTX2 data, including any Mip Levels it has
+	/// </summary>
+	public static unsafe Texture Load(ReadOnlySpan<byte> data)
+	{
+		var header = ReadHeader(data);
+		if (!Graphics.IsTextureFormatSupported(header.Format))
+			throw new Exception($"Texture Format {header.Format} is not supported by the current Renderer");
+
+		var texture = new Texture(header.Width, header.Height, header.Format);
+		var levels = Math.Min(header.LevelCount, texture.MaxMipLevels);
+
+		fixed (byte* ptr = data)
+		{
+			texture.SetData(new IntPtr(ptr + header.DataOffset), header.DataLength);
+
+			for (int i = 1; i < levels; i ++)
+			{
+				var (offset, length) = GetLevel(data, header.Format, header.Width, header.Height, i);
+				texture.SetLevelData(i, new IntPtr(ptr + offset), length);
+			}
+		}
+
+		return texture;
+	}
+
+	/// <summary>
+	/// Creates a Texture from a KTX2 file. The file is memory-mapped and
+	/// uploaded straight from the mapping, which avoids copying it into memory.
+	/// </summary>
+	public static unsafe Texture Load(string path)
+	{
+		using var stream = File.OpenRead(path);
+		var length = stream.Length;
+		if (length > int.MaxValue)
+			throw new Exception("KTX2 file is too large");
+
+		using var file = MemoryMappedFile.CreateFromFile(stream, null, 0, MemoryMappedFileAccess.Read, HandleInheritability.None, false);
+		using var view = file.CreateViewAccessor(0, length, MemoryMappedFileAccess.Read);
+
+		byte* ptr = null;
+		view.SafeMemoryMappedViewHandle.AcquirePointer(ref ptr);
+		try
+		{
+			return Load(new ReadOnlySpan<byte>(ptr + view.PointerOffset, (int)length));
+		}
+		finally
+		{
+			view.SafeMemoryMappedViewHandle.ReleasePointer();
+		}
+	}
+
+	/// <summary>
+	/// Maps a Vulkan format, which KTX2 uses, to a Texture Format
+	/// </summary>
+	private static TextureFormat? GetFormat(uint vkFormat) => vkFormat switch
+	{
+		9 => TextureFormat.R8,					// R8_UNORM
+		37 or 43 => TextureFormat.R8G8B8A8,		// R8G8B8A8_UNORM / SRGB
+		131 or 132 => TextureFormat.BC1,		// BC1_RGB_UNORM_BLOCK / SRGB
+		133 or 134 => TextureFormat.BC1,		// BC1_RGBA_UNORM_BLOCK / SRGB
+		137 or 138 => TextureFormat.BC3,		// BC3_UNORM_BLOCK / SRGB
+		145 or 146 => TextureFormat.BC7,		// BC7_UNORM_BLOCK / SRGB
+		151 or 152 => TextureFormat.ETC2,		// ETC2_R8G8B8A8_UNORM_BLOCK / SRGB
+		157 or 158 => TextureFormat.ASTC4x4,	// ASTC_4x4_UNORM_BLOCK / SRGB
+		_ => null
+	};
+}
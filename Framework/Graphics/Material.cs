@@ -20,9 +20,21 @@ public class Material
 
 	private TextureSampler[] samplerBuffer = Array.Empty<TextureSampler>();
 	private Texture?[] textureBuffer = Array.Empty<Texture?>();
+	private UniformBuffer?[] uniformBufferBuffer = Array.Empty<UniformBuffer?>();
 	private float[] floatBuffer = Array.Empty<float>();
 	private readonly List<Uniform> uniforms = new();
 
+	// Which Uniforms have changed since they were last uploaded to the Shader.
+	// These only matter while this is the last Material applied to the Shader.
+	private bool[] uniformDirty = Array.Empty<bool>();
+	private bool anyDirty = true;
+
+	// Uniforms are only known once the Shader has finished compiling, so that attaching a
+	// Shader compiled asynchronously doesn't wait on it. Values Set before then are kept here,
+	// by Uniform name and index, and applied once the Uniforms are loaded.
+	private bool uniformsLoaded;
+	private readonly Dictionary<(string Uniform, int Index), Action<Material>> pending = new();
+
 	/// <summary>
 	/// The current Shader the Material is using.
 	/// If null, the Material will not have any Uniforms.
@@ -46,9 +58,13 @@ public class Material
 	{
 		Shader = null;
 		uniforms.Clear();
+		uniformsLoaded = false;
+		pending.Clear();
 		Array.Fill(samplerBuffer, new());
 		Array.Fill(textureBuffer, null);
+		Array.Fill(uniformBufferBuffer, null);
 		Array.Fill(floatBuffer, 0.0f);
+		MarkAllDirty();
 	}
 
 	/// <summary>
@@ -56,14 +72,28 @@ public class Material
 	/// </summary>
 	public void CopyTo(Material material)
 	{
+		if (!LoadUniforms(wait: false))
+		{
+			material.Clear();
+			material.SetShader(Shader);
+			foreach (var set in pending.Values)
+				set(material);
+			return;
+		}
+
+		// our Uniforms are loaded, so the Shader already has them and this doesn't wait
 		material.SetShader(Shader);
+		material.LoadUniforms(wait: true);
 		samplerBuffer.AsSpan().CopyTo(material.samplerBuffer);
 		textureBuffer.AsSpan().CopyTo(material.textureBuffer);
+		uniformBufferBuffer.AsSpan().CopyTo(material.uniformBufferBuffer);
 		floatBuffer.AsSpan().CopyTo(material.floatBuffer);
+		material.MarkAllDirty();
 	}
 
 	/// <summary>
-	/// Sets the Shader this Material is currently using
+	/// Sets the Shader this Material is currently using.
+	/// If the Shader is still compiling, this doesn't wait for it to finish.
 	/// </summary>
 	public void SetShader(Shader? shader)
 	{
@@ -72,11 +102,25 @@ public class Material
 
 		Clear();
 		Shader = shader;
-		if (Shader == null)
-			return;
+		LoadUniforms(wait: false);
+	}
+
+	/// <summary>
+	/// Loads the Shader's Uniforms if they haven't been already. Unless waiting, this only
+	/// happens once the Shader has finished compiling, and off the main thread only if the
+	/// Shader has already loaded them. Returns if the Uniforms are loaded.
+	/// </summary>
+	private bool LoadUniforms(bool wait)
+	{
+		if (uniformsLoaded || Shader == null)
+			return true;
+
+		if (!wait && !Shader.HasLoadedUniforms && (Thread.CurrentThread.ManagedThreadId != App.MainThreadID || !Shader.IsReady))
+			return false;
 
 		int samplerLength = 0;
 		int textureLength = 0;
+		int uniformBufferLength = 0;
 		int floatLength = 0;
 
 		foreach (var u in Shader.Uniforms.Values)
@@ -112,6 +156,7 @@ public class Material
 					floatLength += it.BufferLength;
 					break;
 				case UniformType.Texture2D:
+				case UniformType.Texture2DArray:
 					it = new(u.Name, u.Index, textureLength, u.ArrayElements, u.Type, u.ArrayElements);
 					textureLength += it.BufferLength;
 					break;
@@ -119,6 +164,10 @@ public class Material
 					it = new(u.Name, u.Index, samplerLength, u.ArrayElements, u.Type, u.ArrayElements);
 					samplerLength += it.BufferLength;
 					break;
+				case UniformType.UniformBuffer:
+					it = new(u.Name, u.Index, uniformBufferLength, 1, u.Type, 1);
+					uniformBufferLength += it.BufferLength;
+					break;
 			}
 
 			uniforms.Add(it);
@@ -128,8 +177,25 @@ public class Material
 			Array.Resize(ref samplerBuffer, samplerLength);
 		if (textureLength > textureBuffer.Length)
 			Array.Resize(ref textureBuffer, textureLength);
+		if (uniformBufferLength > uniformBufferBuffer.Length)
+			Array.Resize(ref uniformBufferBuffer, uniformBufferLength);
 		if (floatLength > floatBuffer.Length)
 			Array.Resize(ref floatBuffer, floatLength);
+		if (uniforms.Count > uniformDirty.Length)
+			Array.Resize(ref uniformDirty, uniforms.Count);
+		MarkAllDirty();
+		uniformsLoaded = true;
+
+		// apply the values that were Set while waiting on the Shader
+		if (pending.Count > 0)
+		{
+			var sets = pending.Values.ToArray();
+			pending.Clear();
+			foreach (var set in sets)
+				set(this);
+		}
+
+		return true;
 	}
 
 	public void Set(string uniform, float value)
@@ -205,37 +271,91 @@ public class Material
 
 	public unsafe void Set(string uniform, ReadOnlySpan<float> values)
 	{
-		var it = Get(uniform);
+		if (!LoadUniforms(wait: false))
+		{
+			var copy = values.ToArray();
+			pending[(uniform, 0)] = (m) => m.Set(uniform, copy);
+			return;
+		}
+
+		var it = Get(uniform, out var uniformIndex);
 
 		if (!IsFloat(it.Type))
 			throw new Exception($"Uniform '{uniform}' is not a Float value type");
 
 		var subspan = values[0..Math.Min(values.Length, it.BufferLength)];
-		subspan.CopyTo(floatBuffer.AsSpan()[it.BufferStart..]);
+		var dest = floatBuffer.AsSpan(it.BufferStart, subspan.Length);
+		if (!subspan.SequenceEqual(dest))
+		{
+			subspan.CopyTo(dest);
+			MarkDirty(uniformIndex);
+		}
 	}
 
 	public unsafe void Set(string uniform, Texture? texture, int index = 0)
 	{
-		var it = Get(uniform);
+		if (!LoadUniforms(wait: false))
+		{
+			pending[(uniform, index)] = (m) => m.Set(uniform, texture, index);
+			return;
+		}
+
+		var it = Get(uniform, out var uniformIndex);
 
-		if (it.Type != UniformType.Texture2D)
+		if (it.Type != UniformType.Texture2D && it.Type != UniformType.Texture2DArray)
 			throw new Exception($"Uniform '{uniform}' is not a Texture2D value type");
 		if (index >= it.BufferLength)
 			throw new Exception($"Uniform '{uniform}' with index {index} is out of bounds");
+		if (texture != null && texture.IsArray != (it.Type == UniformType.Texture2DArray))
+			throw new Exception($"Uniform '{uniform}' does not match the Texture's array type");
 
-		textureBuffer[it.BufferStart + index] = texture;
+		if (textureBuffer[it.BufferStart + index] != texture)
+		{
+			textureBuffer[it.BufferStart + index] = texture;
+			MarkDirty(uniformIndex);
+		}
 	}
 
 	public unsafe void Set(string uniform, TextureSampler sampler, int index = 0)
 	{
-		var it = Get(uniform);
+		if (!LoadUniforms(wait: false))
+		{
+			pending[(uniform, index)] = (m) => m.Set(uniform, sampler, index);
+			return;
+		}
+
+		var it = Get(uniform, out var uniformIndex);
 
 		if (it.Type != UniformType.Sampler2D)
 			throw new Exception($"Uniform '{uniform}' is not a Sampler2D value type");
 		if (index >= it.BufferLength)
 			throw new Exception($"Uniform '{uniform}' with index {index} is out of bounds");
 
-		samplerBuffer[it.BufferStart + index] = sampler;
+		if (samplerBuffer[it.BufferStart + index] != sampler)
+		{
+			samplerBuffer[it.BufferStart + index] = sampler;
+			MarkDirty(uniformIndex);
+		}
+	}
+
+	public void Set(string uniform, UniformBuffer? buffer)
+	{
+		if (!LoadUniforms(wait: false))
+		{
+			pending[(uniform, 0)] = (m) => m.Set(uniform, buffer);
+			return;
+		}
+
+		var it = Get(uniform, out var uniformIndex);
+
+		if (it.Type != UniformType.UniformBuffer)
+			throw new Exception($"Uniform '{uniform}' is not a Uniform Buffer");
+
+		if (uniformBufferBuffer[it.BufferStart] != buffer)
+		{
+			uniformBufferBuffer[it.BufferStart] = buffer;
+			MarkDirty(uniformIndex);
+		}
 	}
 
 	/// <summary>
@@ -246,6 +366,18 @@ public class Material
 		if (Shader == null || Shader.IsDisposed)
 			return;
 
+		// the Shader is about to be drawn with, which waits for it to finish compiling anyway
+		LoadUniforms(wait: true);
+
+		// if we were the last Material applied to the Shader, it already
+		// holds all of our values except the ones that have changed since
+		var uploadAll = Shader.appliedMaterial != this;
+		if (!uploadAll && !anyDirty)
+			return;
+
+		Shader.appliedMaterial = this;
+		anyDirty = false;
+
 		var id = Shader.resource;
 
 		fixed (float* floatPtr = floatBuffer)
@@ -264,6 +396,10 @@ public class Material
 			// apply each uniform value
 			for (var i = 0; i < uniforms.Count; i++)
 			{
+				if (!uploadAll && !uniformDirty[i])
+					continue;
+				uniformDirty[i] = false;
+
 				var uniform = uniforms[i];
 				if (IsFloat(uniform.Type))
 				{
@@ -273,10 +409,79 @@ public class Material
 				{
 					Platform.FosterShaderSetSampler(id, uniform.Index, samplerPtr + uniform.BufferStart);
 				}
-				else if (uniform.Type == UniformType.Texture2D)
+				else if (uniform.Type == UniformType.Texture2D || uniform.Type == UniformType.Texture2DArray)
 				{
 					Platform.FosterShaderSetTexture(id, uniform.Index, texturePtr + uniform.BufferStart);
 				}
+				else if (uniform.Type == UniformType.UniformBuffer)
+				{
+					var buffer = uniformBufferBuffer[uniform.BufferStart];
+					var bufferPtr = buffer != null && !buffer.IsDisposed ? buffer.resource : IntPtr.Zero;
+					Platform.FosterShaderSetUniformBuffer(id, uniform.Index, bufferPtr);
+				}
+			}
+		}
+	}
+
+	/// <summary>
+	/// Records all of the Uniform Values in this Material into the Command Buffer.
+	/// The Shader can be left holding anyone's values by the time it's executed,
+	/// so nothing is skipped by dirty tracking here.
+	/// </summary>
+	internal unsafe void Apply(CommandBuffer commands)
+	{
+		if (Shader == null || Shader.IsDisposed)
+			return;
+
+		// waiting on the Shader can only be done on the main thread
+		if (!LoadUniforms(wait: Thread.CurrentThread.ManagedThreadId == App.MainThreadID))
+			throw new Exception("A Material can only be recorded off the main thread once its Shader has finished compiling");
+
+		commands.Keep(Shader);
+
+		var id = Shader.resource;
+		var list = commands.resource;
+
+		fixed (float* floatPtr = floatBuffer)
+		fixed (TextureSampler* samplerPtr = samplerBuffer)
+		{
+			// copy texture values to int pointers buffer
+			var texturePtr = stackalloc IntPtr[textureBuffer.Length];
+			for (int i = 0; i < textureBuffer.Length; i ++)
+			{
+				if (textureBuffer[i] is Texture texture && !texture.IsDisposed)
+				{
+					texturePtr[i] = texture.resource;
+					commands.Keep(texture);
+				}
+				else
+					texturePtr[i] = IntPtr.Zero;
+			}
+
+			// record each uniform value
+			for (var i = 0; i < uniforms.Count; i++)
+			{
+				var uniform = uniforms[i];
+				if (IsFloat(uniform.Type))
+				{
+					Platform.FosterCommandListShaderSetUniform(list, id, uniform.Index, floatPtr + uniform.BufferStart, uniform.BufferLength);
+				}
+				else if (uniform.Type == UniformType.Sampler2D)
+				{
+					Platform.FosterCommandListShaderSetSampler(list, id, uniform.Index, samplerPtr + uniform.BufferStart, uniform.BufferLength);
+				}
+				else if (uniform.Type == UniformType.Texture2D || uniform.Type == UniformType.Texture2DArray)
+				{
+					Platform.FosterCommandListShaderSetTexture(list, id, uniform.Index, texturePtr + uniform.BufferStart, uniform.BufferLength);
+				}
+				else if (uniform.Type == UniformType.UniformBuffer)
+				{
+					var buffer = uniformBufferBuffer[uniform.BufferStart];
+					var bufferPtr = buffer != null && !buffer.IsDisposed ? buffer.resource : IntPtr.Zero;
+					if (buffer != null)
+						commands.Keep(buffer);
+					Platform.FosterCommandListShaderSetUniformBuffer(list, id, uniform.Index, bufferPtr);
+				}
 			}
 		}
 	}
@@ -284,18 +489,33 @@ public class Material
 	/// <summary>
 	/// Tries to find a Uniform of a given name
 	/// </summary>
-	private Uniform Get(string uniform)
+	private Uniform Get(string uniform, out int index)
 	{
 		for (var i = 0; i < uniforms.Count; i++)
 		{
 			var it = uniforms[i];
 			if (it.Name == uniform)
+			{
+				index = i;
 				return it;
+			}
 		}
 
 		throw new Exception($"Uniform '{uniform}' does not exist");
 	}
 
+	private void MarkDirty(int index)
+	{
+		uniformDirty[index] = true;
+		anyDirty = true;
+	}
+
+	private void MarkAllDirty()
+	{
+		Array.Fill(uniformDirty, true);
+		anyDirty = true;
+	}
+
 	/// <summary>
 	/// Checks if the given Uniform Type is a float
 	/// </summary>
@@ -310,6 +530,8 @@ public class Material
 		UniformType.Mat4x4 => true,
 		UniformType.Texture2D => false,
 		UniformType.Sampler2D => false,
+		UniformType.UniformBuffer => false,
+		UniformType.Texture2DArray => false,
 		_ => false
 	};
 }
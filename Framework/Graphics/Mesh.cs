@@ -28,12 +28,45 @@ public class Mesh : IResource
 	/// </summary>
 	public VertexFormat? VertexFormat { get; private set; }
 
+	/// <summary>
+	/// Number of Instances in the Mesh
+	/// </summary>
+	public int InstanceCount { get; private set; } = 0;
+
+	/// <summary>
+	/// Current Instance Format
+	/// </summary>
+	public VertexFormat? InstanceFormat { get; private set; }
+
+	/// <summary>
+	/// If the Mesh was created for streaming data that is re-uploaded every time it's drawn
+	/// </summary>
+	public bool Streaming { get; private set; }
+
 	internal IntPtr resource;
 	internal bool disposed = false;
 
-	public Mesh()
+	// Recording into a CommandBuffer leaves the cached counts & formats above alone, as the
+	// native Mesh doesn't change until the buffer is executed (if ever). Formats recorded since
+	// the last direct change may have been applied, so the next direct change always sets them.
+	private bool indexFormatRecorded;
+	private bool vertexFormatRecorded;
+	private bool instanceFormatRecorded;
+
+	// matches FOSTER_MAX_QUADS_SIXTEEN_BIT
+	private const int MaxQuadsSixteenBit = 16384;
+
+	public Mesh() : this(false) { }
+
+	/// <summary>
+	/// Creates a new Mesh. Streaming Meshes are intended to have all of their data
+	/// uploaded again after each time they're drawn, which lets the renderer avoid
+	/// waiting on the GPU to finish reading previous data.
+	/// </summary>
+	public Mesh(bool streaming)
 	{
-		resource = Platform.FosterMeshCreate();
+		Streaming = streaming;
+		resource = streaming ? Platform.FosterMeshCreateStreaming() : Platform.FosterMeshCreate();
 		if (resource == IntPtr.Zero)
 			throw new Exception("Failed to create Mesh");
 		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterMeshDestroy);
@@ -44,7 +77,7 @@ public class Mesh : IResource
 		Dispose(false);
 	}
 
-	private static IndexFormat GetIndexFormat<T>()
+	internal static IndexFormat GetIndexFormat<T>()
 		=> true switch
 		{
 			true when typeof(T) == typeof(short) => Framework.IndexFormat.Sixteen,
@@ -85,24 +118,36 @@ public class Mesh : IResource
 	/// Uploads the Index data to the Mesh.
 	/// </summary>
 	public void SetIndices(nint data, int count, IndexFormat format)
+	{
+		SetIndices(null, data, count, format);
+	}
+
+	internal void SetIndices(CommandBuffer? commands, nint data, int count, IndexFormat format)
 	{
 		if (IsDisposed)
 			throw new Exception("Resource is Disposed");
 
+		if (commands != null)
+		{
+			indexFormatRecorded = true;
+			Platform.FosterCommandListMeshSetIndexFormat(commands.resource, resource, format);
+			Platform.FosterCommandListMeshSetIndexData(commands.resource, resource, data, GetIndexFormatSize(format) * count, 0);
+			return;
+		}
+
 		IndexCount = count;
+		SetIndexFormat(format);
+		Platform.FosterMeshSetIndexData(resource, data, GetIndexFormatSize(format) * count, 0);
+	}
 
-		if (!IndexFormat.HasValue || IndexFormat.Value != format)
+	private void SetIndexFormat(IndexFormat format)
+	{
+		if (indexFormatRecorded || !IndexFormat.HasValue || IndexFormat.Value != format)
 		{
 			IndexFormat = format;
+			indexFormatRecorded = false;
 			Platform.FosterMeshSetIndexFormat(resource, format);
 		}
-
-		Platform.FosterMeshSetIndexData(
-			resource,
-			data,
-			GetIndexFormatSize(format) * count,
-			0
-		);
 	}
 
 	/// <summary>
@@ -127,6 +172,11 @@ public class Mesh : IResource
 	/// This also cannot modify the existing Index Format.
 	/// </summary>
 	public void SetSubIndices(int offset, nint data, int count)
+	{
+		SetSubIndices(null, offset, data, count);
+	}
+
+	internal void SetSubIndices(CommandBuffer? commands, int offset, nint data, int count)
 	{
 		if (IsDisposed)
 			throw new Exception("Resource is Disposed");
@@ -139,12 +189,73 @@ public class Mesh : IResource
 
 		var size = GetIndexFormatSize(IndexFormat.Value);
 
-		Platform.FosterMeshSetIndexData(
-			resource,
-			data,
-			size * count,
-			size * offset
-		);
+		if (commands != null)
+			Platform.FosterCommandListMeshSetIndexData(commands.resource, resource, data, size * count, size * offset);
+		else
+			Platform.FosterMeshSetIndexData(resource, data, size * count, size * offset);
+	}
+
+	/// <summary>
+	/// Uses Index data for drawing the given number of Quads, where every 4 Vertices form a Quad
+	/// made of the triangles (0, 1, 2) and (0, 2, 3). The Renderer shares these Indices between
+	/// Meshes so nothing needs to be uploaded. 16-bit Indices are used when the Quads fit in them.
+	/// </summary>
+	public void SetQuadIndices(int quadCount)
+	{
+		SetQuadIndices(null, quadCount);
+	}
+
+	internal void SetQuadIndices(CommandBuffer? commands, int quadCount)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		// the Platform sets the Index Format to match the shared Indices
+		if (commands != null)
+		{
+			indexFormatRecorded = true;
+			Platform.FosterCommandListMeshSetQuadIndices(commands.resource, resource, quadCount);
+			return;
+		}
+
+		IndexCount = quadCount * 6;
+		IndexFormat = quadCount <= MaxQuadsSixteenBit ? Framework.IndexFormat.Sixteen : Framework.IndexFormat.ThirtyTwo;
+		indexFormatRecorded = false;
+		Platform.FosterMeshSetQuadIndices(resource, quadCount);
+	}
+
+	/// <summary>
+	/// Maps the Index data of the Mesh so it can be written to directly, resizing it to fit.
+	/// Indices before the offset keep their existing values, while the mapped range starts undefined.
+	/// Returns IntPtr.Zero if the Renderer doesn't support this, in which case SetIndices should be used.
+	/// UnmapIndices must be called before the Mesh is drawn.
+	/// </summary>
+	public nint MapIndices(int offset, int count, IndexFormat format)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (offset > 0 && IndexFormat.HasValue && IndexFormat.Value != format)
+			throw new Exception("Index Format mismatch; MapIndices with an offset must use the existing Format");
+
+		SetIndexFormat(format);
+
+		var size = GetIndexFormatSize(format);
+		var ptr = Platform.FosterMeshMapIndexData(resource, size * count, size * offset);
+		if (ptr != IntPtr.Zero)
+			IndexCount = offset + count;
+		return ptr;
+	}
+
+	/// <summary>
+	/// Finishes writing to Index data mapped with MapIndices
+	/// </summary>
+	public void UnmapIndices()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		Platform.FosterMeshUnmapIndexData(resource);
 	}
 
 	/// <summary>
@@ -178,41 +289,128 @@ public class Mesh : IResource
 	/// Uploads the Vertex data to the Mesh.
 	/// </summary>
 	public unsafe void SetVertices(IntPtr data, int count, VertexFormat format)
+	{
+		SetVertices(null, data, count, format);
+	}
+
+	internal void SetVertices(CommandBuffer? commands, IntPtr data, int count, VertexFormat format)
 	{
 		if (IsDisposed)
 			throw new Exception("Resource is Disposed");
 
+		SetVertexFormat(commands, format);
+
+		if (commands != null)
+		{
+			Platform.FosterCommandListMeshSetVertexData(commands.resource, resource, data, format.Stride * count, 0);
+			return;
+		}
+
 		VertexCount = count;
+		Platform.FosterMeshSetVertexData(resource, data, format.Stride * count, 0);
+	}
 
-		// update vertex format
-		if (!VertexFormat.HasValue || VertexFormat.Value != format)
+	private unsafe void SetVertexFormat(CommandBuffer? commands, VertexFormat format)
+	{
+		// recorded formats are always set, as the native Mesh may differ by the time they execute
+		if (commands != null)
+		{
+			vertexFormatRecorded = true;
+			var elements = stackalloc Platform.FosterVertexElement[format.Elements.Length];
+			var f = GetPlatformFormat(format, elements);
+			Platform.FosterCommandListMeshSetVertexFormat(commands.resource, resource, ref f);
+		}
+		else if (vertexFormatRecorded || !VertexFormat.HasValue || VertexFormat.Value != format)
 		{
 			VertexFormat = format;
+			vertexFormatRecorded = false;
+			var elements = stackalloc Platform.FosterVertexElement[format.Elements.Length];
+			var f = GetPlatformFormat(format, elements);
+			Platform.FosterMeshSetVertexFormat(resource, ref f);
+		}
+	}
 
+	private unsafe void SetInstanceFormat(CommandBuffer? commands, VertexFormat format)
+	{
+		if (commands != null)
+		{
+			instanceFormatRecorded = true;
 			var elements = stackalloc Platform.FosterVertexElement[format.Elements.Length];
-			for (int i = 0; i < format.Elements.Length; i++)
-			{
-				elements[i].index = format.Elements[i].Index;
-				elements[i].type = format.Elements[i].Type;
-				elements[i].normalized = format.Elements[i].Normalized ? 1 : 0;
-			}
-
-			Platform.FosterVertexFormat f = new()
-			{
-				elements = new IntPtr(elements),
-				elementCount = format.Elements.Length,
-				stride = format.Stride
-			};
+			var f = GetPlatformFormat(format, elements);
+			Platform.FosterCommandListMeshSetInstanceFormat(commands.resource, resource, ref f);
+		}
+		else if (instanceFormatRecorded || !InstanceFormat.HasValue || InstanceFormat.Value != format)
+		{
+			InstanceFormat = format;
+			instanceFormatRecorded = false;
+			var elements = stackalloc Platform.FosterVertexElement[format.Elements.Length];
+			var f = GetPlatformFormat(format, elements);
+			Platform.FosterMeshSetInstanceFormat(resource, ref f);
+		}
+	}
 
-			Platform.FosterMeshSetVertexFormat(resource, ref f);
+	internal static unsafe Platform.FosterVertexFormat GetPlatformFormat(VertexFormat format, Platform.FosterVertexElement* elements)
+	{
+		for (int i = 0; i < format.Elements.Length; i++)
+		{
+			elements[i].index = format.Elements[i].Index;
+			elements[i].type = format.Elements[i].Type;
+			elements[i].normalized = format.Elements[i].Normalized ? 1 : 0;
 		}
 
-		Platform.FosterMeshSetVertexData(
-			resource,
-			data,
-			format.Stride * count,
-			0
-		);
+		return new()
+		{
+			elements = new IntPtr(elements),
+			elementCount = format.Elements.Length,
+			stride = format.Stride
+		};
+	}
+
+	/// <summary>
+	/// Uploads the per-Instance data to the Mesh, which is used when drawing with an InstanceCount.
+	/// The attribute locations of the Instance Format must not overlap the Vertex Format.
+	/// </summary>
+	public unsafe void SetInstances<T>(ReadOnlySpan<T> instances) where T : struct, IVertex
+	{
+		SetInstances(instances, default(T).Format);
+	}
+
+	/// <summary>
+	/// Uploads the per-Instance data to the Mesh, which is used when drawing with an InstanceCount.
+	/// The attribute locations of the Instance Format must not overlap the Vertex Format.
+	/// </summary>
+	public unsafe void SetInstances<T>(ReadOnlySpan<T> instances, VertexFormat format) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(instances))
+		{
+			SetInstances(new IntPtr(ptr), instances.Length, format);
+		}
+	}
+
+	/// <summary>
+	/// Uploads the per-Instance data to the Mesh, which is used when drawing with an InstanceCount.
+	/// The attribute locations of the Instance Format must not overlap the Vertex Format.
+	/// </summary>
+	public void SetInstances(IntPtr data, int count, VertexFormat format)
+	{
+		SetInstances(null, data, count, format);
+	}
+
+	internal void SetInstances(CommandBuffer? commands, IntPtr data, int count, VertexFormat format)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		SetInstanceFormat(commands, format);
+
+		if (commands != null)
+		{
+			Platform.FosterCommandListMeshSetInstanceData(commands.resource, resource, data, format.Stride * count, 0);
+			return;
+		}
+
+		InstanceCount = count;
+		Platform.FosterMeshSetInstanceData(resource, data, format.Stride * count, 0);
 	}
 
 	/// <summary>
@@ -234,6 +432,11 @@ public class Mesh : IResource
 	/// This also cannot modify the existing Vertex Format.
 	/// </summary>
 	public unsafe void SetSubVertices(int offset, IntPtr data, int count)
+	{
+		SetSubVertices(null, offset, data, count);
+	}
+
+	internal void SetSubVertices(CommandBuffer? commands, int offset, IntPtr data, int count)
 	{
 		if (IsDisposed)
 			throw new Exception("Resource is Disposed");
@@ -244,12 +447,45 @@ public class Mesh : IResource
 		if (offset + count > VertexCount)
 			throw new Exception("SetSubVertices is out of range of the existing Vertex Buffer");
 
-		Platform.FosterMeshSetVertexData(
-			resource,
-			data,
-			VertexFormat.Value.Stride * count,
-			VertexFormat.Value.Stride * offset
-		);
+		var stride = VertexFormat.Value.Stride;
+
+		if (commands != null)
+			Platform.FosterCommandListMeshSetVertexData(commands.resource, resource, data, stride * count, stride * offset);
+		else
+			Platform.FosterMeshSetVertexData(resource, data, stride * count, stride * offset);
+	}
+
+	/// <summary>
+	/// Maps the Vertex data of the Mesh so it can be written to directly, resizing it to fit.
+	/// Vertices before the offset keep their existing values, while the mapped range starts undefined.
+	/// Returns IntPtr.Zero if the Renderer doesn't support this, in which case SetVertices should be used.
+	/// UnmapVertices must be called before the Mesh is drawn.
+	/// </summary>
+	public nint MapVertices(int offset, int count, VertexFormat format)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (offset > 0 && VertexFormat.HasValue && VertexFormat.Value != format)
+			throw new Exception("Vertex Format mismatch; MapVertices with an offset must use the existing Format");
+
+		SetVertexFormat(null, format);
+
+		var ptr = Platform.FosterMeshMapVertexData(resource, format.Stride * count, format.Stride * offset);
+		if (ptr != IntPtr.Zero)
+			VertexCount = offset + count;
+		return ptr;
+	}
+
+	/// <summary>
+	/// Finishes writing to Vertex data mapped with MapVertices
+	/// </summary>
+	public void UnmapVertices()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		Platform.FosterMeshUnmapVertexData(resource);
 	}
 
 	public void Dispose()
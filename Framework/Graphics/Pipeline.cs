@@ -0,0 +1,117 @@
+namespace Foster.Framework;
+
+/// <summary>
+/// The Render State of a Draw Command, baked ahead of time so the Renderer can
+/// resolve it once instead of for every draw. Assign it to a Draw Command's
+/// Pipeline to replace its Blend Mode, Cull Mode, Depth Compare and Depth Mask.
+/// </summary>
+public class Pipeline : IResource
+{
+	/// <summary>
+	/// Optional Pipeline Name
+	/// </summary>
+	public string Name { get; set; } = string.Empty;
+
+	/// <summary>
+	/// If the Pipeline has been disposed
+	/// </summary>
+	public bool IsDisposed => disposed;
+
+	/// <summary>
+	/// The Shader the Pipeline is drawn with, which must match the Material's Shader
+	/// </summary>
+	public readonly Shader Shader;
+
+	/// <summary>
+	/// The Vertex Format of the Meshes the Pipeline will be drawn with
+	/// </summary>
+	public readonly VertexFormat VertexFormat;
+
+	/// <summary>
+	/// The Instance Format of the Meshes the Pipeline will be drawn with, if any
+	/// </summary>
+	public readonly VertexFormat? InstanceFormat;
+
+	/// <summary>
+	/// The Render State Blend Mode
+	/// </summary>
+	public readonly BlendMode BlendMode;
+
+	/// <summary>
+	/// The Render State Culling Mode
+	/// </summary>
+	public readonly CullMode CullMode;
+
+	/// <summary>
+	/// The Render State Depth comparison Function
+	/// </summary>
+	public readonly DepthCompare DepthCompare;
+
+	/// <summary>
+	/// If Writing to the Depth Buffer is enabled
+	/// </summary>
+	public readonly bool DepthMask;
+
+	internal readonly IntPtr resource;
+	internal bool disposed = false;
+
+	public unsafe Pipeline(
+		Shader shader,
+		VertexFormat vertexFormat,
+		VertexFormat? instanceFormat,
+		BlendMode blendMode,
+		CullMode cullMode = CullMode.None,
+		DepthCompare depthCompare = DepthCompare.None,
+		bool depthMask = false)
+	{
+		if (shader.IsDisposed)
+			throw new Exception("Shader is Disposed");
+
+		Shader = shader;
+		VertexFormat = vertexFormat;
+		InstanceFormat = instanceFormat;
+		BlendMode = blendMode;
+		CullMode = cullMode;
+		DepthCompare = depthCompare;
+		DepthMask = depthMask;
+
+		var vertexElements = stackalloc Platform.FosterVertexElement[vertexFormat.Elements.Length];
+		var instanceElements = stackalloc Platform.FosterVertexElement[instanceFormat?.Elements.Length ?? 0];
+
+		Platform.FosterPipelineData data = new()
+		{
+			shader = shader.resource,
+			vertexFormat = Mesh.GetPlatformFormat(vertexFormat, vertexElements),
+			instanceFormat = instanceFormat.HasValue ? Mesh.GetPlatformFormat(instanceFormat.Value, instanceElements) : default,
+			compare = depthCompare,
+			depthMask = depthMask ? 1 : 0,
+			cull = cullMode,
+			blend = blendMode,
+		};
+
+		resource = Platform.FosterPipelineCreate(ref data);
+		if (resource == IntPtr.Zero)
+			throw new Exception("Failed to create Pipeline");
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterPipelineDestroy);
+	}
+
+	~Pipeline()
+	{
+		Dispose(false);
+	}
+
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (!disposed)
+		{
+			disposed = true;
+			Graphics.Resources.RequestDelete(resource);
+		}
+	}
+}
@@ -48,14 +48,49 @@ public class Shader : IResource
 	public bool IsDisposed => disposed;
 
 	/// <summary>
-	/// Dictionary of Uniforms in the Shader
+	/// Dictionary of Uniforms in the Shader.
+	/// If the Shader is still compiling, this waits for it to finish.
 	/// </summary>
-	public readonly ReadOnlyDictionary<string, Uniform> Uniforms;
+	public ReadOnlyDictionary<string, Uniform> Uniforms => uniforms ?? LoadUniforms();
+
+	/// <summary>
+	/// If the Shader has finished compiling and can be used without waiting on it.
+	/// This is always true for Shaders that were not compiled asynchronously.
+	/// </summary>
+	public bool IsReady
+	{
+		get
+		{
+			if (!ready && !disposed)
+				ready = Platform.FosterShaderIsReady(resource) != 0;
+			return ready;
+		}
+	}
 
 	internal readonly IntPtr resource;
 	internal bool disposed = false;
 
+	/// <summary>
+	/// If the Uniforms have already been loaded, so getting them won't wait or call into the Platform
+	/// </summary>
+	internal bool HasLoadedUniforms => uniforms != null;
+
+	private ReadOnlyDictionary<string, Uniform>? uniforms;
+	private bool ready;
+
+	// the last Material to upload its values to this Shader
+	internal Material? appliedMaterial;
+
 	public Shader(in ShaderCreateInfo createInfo)
+		: this(createInfo, false) {}
+
+	/// <summary>
+	/// Creates a Shader. If compileAsync is true, the Shader is compiled in
+	/// the background where the Renderer supports it, and doesn't block until
+	/// it's first used or <see cref="Wait"/> is called. Check <see cref="IsReady"/>
+	/// to find out when it's done compiling.
+	/// </summary>
+	public Shader(in ShaderCreateInfo createInfo, bool compileAsync)
 	{
 		Platform.FosterShaderData data = new()
 		{
@@ -63,10 +98,44 @@ public class Shader : IResource
 			vertex = createInfo.VertexShader
 		};
 
-		resource = Platform.FosterShaderCreate(ref data);
+		if (compileAsync)
+			resource = Platform.FosterShaderCreateAsync(ref data);
+		else
+			resource = Platform.FosterShaderCreate(ref data);
 		if (resource == IntPtr.Zero)
 			throw new Exception("Failed to create Shader");
 
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterShaderDestroy);
+
+		if (!compileAsync)
+		{
+			ready = true;
+			LoadUniforms();
+		}
+	}
+
+	~Shader()
+	{
+		Dispose(false);
+	}
+
+	/// <summary>
+	/// Waits for the Shader to finish compiling, and throws if it failed
+	/// </summary>
+	public void Wait()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (Platform.FosterShaderWait(resource) == 0)
+			throw new Exception("Failed to create Shader");
+		ready = true;
+	}
+
+	private ReadOnlyDictionary<string, Uniform> LoadUniforms()
+	{
+		Wait();
+
 		var infos = new Platform.FosterUniformInfo[64];
 		var count = 0;
 
@@ -86,21 +155,15 @@ public class Shader : IResource
 		}
 
 		// add each uniform
-		var uniforms = new Dictionary<string, Uniform>();
+		var results = new Dictionary<string, Uniform>();
 		for (int i = 0; i < count; i ++)
 		{
 			var info = infos[i];
 			var name = Platform.ParseUTF8(info.name);
-			uniforms.Add(name, new (info.index, name, info.type, info.arrayElements));
+			results.Add(name, new (info.index, name, info.type, info.arrayElements));
 		}
 
-		Uniforms = uniforms.AsReadOnly();
-		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterShaderDestroy);
-	}
-
-	~Shader()
-	{
-		Dispose(false);
+		return uniforms = results.AsReadOnly();
 	}
 
 	/// <summary>
@@ -40,4 +40,95 @@ internal static class ShaderDefaults
 				}"
 		}
 	};
+
+	public static Dictionary<Renderers, ShaderCreateInfo> BatcherInstanced = new()
+	{
+		[Renderers.OpenGL] = new()
+		{
+			VertexShader =
+				@"#version 330
+				uniform mat4 u_matrix;
+				layout(location=0) in vec2 a_corner;
+				layout(location=1) in vec2 a_origin;
+				layout(location=2) in vec2 a_axis_x;
+				layout(location=3) in vec2 a_axis_y;
+				layout(location=4) in vec4 a_tex;
+				layout(location=5) in vec4 a_color;
+				layout(location=6) in vec4 a_type;
+				out vec2 v_tex;
+				out vec4 v_col;
+				out vec4 v_type;
+				void main(void)
+				{
+					vec2 position = a_origin + a_axis_x * a_corner.x + a_axis_y * a_corner.y;
+					gl_Position = u_matrix * vec4(position, 0, 1);
+					v_tex = mix(a_tex.xy, a_tex.zw, a_corner);
+					v_col = a_color;
+					v_type = a_type;
+				}",
+			FragmentShader = Batcher[Renderers.OpenGL].FragmentShader
+		}
+	};
+
+	/// <summary>
+	/// The Batcher's shaders for Texture Arrays, which read the Layer from the alpha of the vertex Mode
+	/// </summary>
+	private const string BatcherArrayFragmentShader =
+		@"#version 330
+		uniform sampler2DArray u_texture;
+		in vec2 v_tex;
+		in vec4 v_col;
+		in vec4 v_type;
+		out vec4 o_color;
+		void main(void)
+		{
+			vec4 color = texture(u_texture, vec3(v_tex, floor(v_type.w * 255.0 + 0.5)));
+			o_color = 
+				v_type.x * color * v_col + 
+				v_type.y * color.a * v_col + 
+				v_type.z * v_col;
+		}";
+
+	public static Dictionary<Renderers, ShaderCreateInfo> BatcherArray = new()
+	{
+		[Renderers.OpenGL] = new()
+		{
+			VertexShader = Batcher[Renderers.OpenGL].VertexShader,
+			FragmentShader = BatcherArrayFragmentShader
+		}
+	};
+
+	public static Dictionary<Renderers, ShaderCreateInfo> BatcherInstancedArray = new()
+	{
+		[Renderers.OpenGL] = new()
+		{
+			VertexShader = BatcherInstanced[Renderers.OpenGL].VertexShader,
+			FragmentShader = BatcherArrayFragmentShader
+		}
+	};
+
+	/// <summary>
+	/// The Batcher's shaders for Signed Distance Field glyphs, which are stored in the red channel
+	/// of the texture. The edge is smoothed over one screen pixel, so it stays sharp at any scale.
+	/// </summary>
+	public static Dictionary<Renderers, ShaderCreateInfo> BatcherDistanceField = new()
+	{
+		[Renderers.OpenGL] = new()
+		{
+			VertexShader = Batcher[Renderers.OpenGL].VertexShader,
+			FragmentShader =
+				@"#version 330
+				uniform sampler2D u_texture;
+				in vec2 v_tex;
+				in vec4 v_col;
+				in vec4 v_type;
+				out vec4 o_color;
+				void main(void)
+				{
+					float dist = texture(u_texture, v_tex).r;
+					float width = max(fwidth(dist), 0.0001);
+					o_color = v_col * smoothstep(0.5 - width, 0.5 + width, dist);
+				}"
+		}
+	};
 }
@@ -93,9 +93,23 @@ public class SpriteFont
 	/// </summary>
 	public readonly List<char> WordbreakCharacters = [ '\n', ' ' ];
 
+	/// <summary>
+	/// Incremented whenever a Character is added or changed, so cached layouts know to rebuild
+	/// </summary>
+	internal int Version { get; private set; }
+
+	/// <summary>
+	/// Characters and kerning in the Latin-1 range are looked up from flat tables instead of
+	/// dictionaries, as they're the vast majority of what's drawn
+	/// </summary>
+	private const int LatinCount = 256;
+
 	private readonly float fontScale = 1.0f;
 	private readonly Dictionary<int, Character> characters = [];
+	private readonly Character[] latinCharacters = new Character[LatinCount];
+	private readonly bool[] latinCharactersSet = new bool[LatinCount];
 	private readonly Dictionary<KerningPair, float> kerning = [];
+	private float[]? latinKerning;
 	private readonly List<Page> texturePages = [];
 	private Color[] buffer = [];
 
@@ -328,7 +342,7 @@ public class SpriteFont
 	/// </summary>
 	public void AddCharacter(int codepoint, in float advance, in Vector2 offset, in Subtexture subtexture)
 	{
-		characters[codepoint] = new(codepoint, subtexture, advance, offset, true);
+		SetCharacter(new(codepoint, subtexture, advance, offset, true));
 	}
 
 	/// <summary>
@@ -336,7 +350,7 @@ public class SpriteFont
 	/// </summary>
 	public void AddCharacter(in Character character)
 	{
-		characters[character.Codepoint] = character;
+		SetCharacter(character);
 	}
 
 	/// <summary>
@@ -346,6 +360,9 @@ public class SpriteFont
 	/// </summary>
 	public Character GetCharacter(int codepoint)
 	{
+		if ((uint)codepoint < LatinCount && latinCharactersSet[codepoint])
+			return latinCharacters[codepoint];
+
 		if (!characters.TryGetValue(codepoint, out var value))
 		{
 			// we are not allowed to dynamically create new characters
@@ -389,9 +406,32 @@ public class SpriteFont
 	public void SetKerning(int codepointFirst, int codepointSecond, float advance)
 	{
 		kerning[new(codepointFirst, codepointSecond)] = advance;
+		if (latinKerning != null && (uint)codepointFirst < LatinCount && (uint)codepointSecond < LatinCount)
+			latinKerning[codepointFirst * LatinCount + codepointSecond] = advance;
+		Version++;
 	}
 
 	public float GetKerning(int codepointFirst, int codepointSecond)
+	{
+		// unknown pairs are NaN, and are filled in from the dictionary / Font below
+		if ((uint)codepointFirst < LatinCount && (uint)codepointSecond < LatinCount)
+		{
+			if (latinKerning == null)
+			{
+				latinKerning = new float[LatinCount * LatinCount];
+				Array.Fill(latinKerning, float.NaN);
+			}
+
+			ref var cached = ref latinKerning[codepointFirst * LatinCount + codepointSecond];
+			if (float.IsNaN(cached))
+				cached = GetKerningUncached(codepointFirst, codepointSecond);
+			return cached;
+		}
+
+		return GetKerningUncached(codepointFirst, codepointSecond);
+	}
+
+	private float GetKerningUncached(int codepointFirst, int codepointSecond)
 	{
 		var key = new KerningPair(codepointFirst, codepointSecond);
 
@@ -510,13 +550,25 @@ public class SpriteFont
 			}
 		}
 
-		return characters[codepoint] = new(
+		return SetCharacter(new(
 			codepoint,
 			subtex,
 			advance,
 			offset,
 			exists
-		);
+		));
+	}
+
+	private Character SetCharacter(in Character character)
+	{
+		characters[character.Codepoint] = character;
+		if ((uint)character.Codepoint < LatinCount)
+		{
+			latinCharacters[character.Codepoint] = character;
+			latinCharactersSet[character.Codepoint] = true;
+		}
+		Version++;
+		return character;
 	}
 
 	private static bool TryBlitCharacter(Font font, in Font.Character ch, ref Color[] buffer, bool premultiply)
@@ -678,6 +730,7 @@ public class SpriteFont
 		private readonly Texture texture = new(size, size, TextureFormat.Color);
 		private readonly List<Node> nodes = [ new() { Bounds = new(0, 0, size, size) } ];
 		private bool textureDirty;
+		private RectInt textureDirtyBounds;
 
 		public bool TryPack(Color[] buffer, int width, int height, bool uploadToTexture, out Subtexture result)
 		{
@@ -689,13 +742,14 @@ public class SpriteFont
 				image.CopyPixels(buffer, width, height, new Point2(node.Bounds.X + 1, node.Bounds.Y + 1));
 				result = new Subtexture(texture, node.Bounds, new Rect(1, 1, width, height));
 
+				var bounds = new RectInt(node.Bounds.X + 1, node.Bounds.Y + 1, width, height);
 				if (uploadToTexture)
 				{
-					// TODO: partial rectangle upload
-					texture.SetData<Color>(image.Data);
+					texture.SetData<Color>(buffer, bounds);
 				}
 				else
 				{
+					textureDirtyBounds = textureDirty ? textureDirtyBounds.Conflate(bounds) : bounds;
 					textureDirty = true;
 				}
 
@@ -710,7 +764,14 @@ public class SpriteFont
 		{
 			if (textureDirty)
 			{
-				texture.SetData<Color>(image.Data);
+				// only upload the region that has changed
+				var bounds = textureDirtyBounds;
+				var upload = texture.BeginUpload(bounds);
+				var src = image.Data;
+				var dst = upload.GetData<Color>();
+				for (int y = 0; y < bounds.Height; y ++)
+					src.Slice((bounds.Y + y) * size + bounds.X, bounds.Width).CopyTo(dst.Slice(y * bounds.Width, bounds.Width));
+				upload.Submit();
 				textureDirty = false;
 			}
 		}
@@ -788,4 +849,9 @@ public static class SpriteFontBatcherExt
 	{
 		font.RenderText(batch, text, maxLineWidth, position, justify, color);
 	}
+
+	public static void Text(this Batcher batch, TextLayout layout, Vector2 position, Color color)
+	{
+		layout.Render(batch, position, color);
+	}
 }
@@ -46,6 +46,9 @@ public class Target : IResource
 		: this(width, height, defaultFormats) { }
 
 	public Target(int width, int height, TextureFormat[] attachments)
+		: this(width, height, attachments, false) { }
+
+	private Target(int width, int height, TextureFormat[] attachments, bool pooled)
 	{
 		if (width <= 0 || height <= 0)
 			throw new ArgumentException("Target width and height must be larger than 0");
@@ -53,7 +56,9 @@ public class Target : IResource
 		if (attachments == null || attachments.Length <= 0)
 			throw new ArgumentException("Target needs at least 1 color attachment");
 
-		resource = Platform.FosterTargetCreate(width, height, attachments, attachments.Length);
+		resource = pooled ?
+			Platform.FosterTargetAcquire(width, height, attachments, attachments.Length) :
+			Platform.FosterTargetCreate(width, height, attachments, attachments.Length);
 		if (resource == IntPtr.Zero)
 			throw new Exception("Failed to create Target");
 
@@ -69,9 +74,22 @@ public class Target : IResource
 		}
 
 		Attachments = textures.AsReadOnly();
-		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterTargetDestroy);
+		Graphics.Resources.RegisterAllocated(this, resource, pooled ? Platform.FosterTargetRelease : Platform.FosterTargetDestroy);
 	}
 
+	/// <summary>
+	/// Gets a transient Target from the Platform's pool, which reuses an unused Target of the
+	/// same size and formats instead of allocating a new one. Disposing the Target returns it to the
+	/// pool and discards its contents, so transient Targets used by different passes within a frame
+	/// share the same memory. Its contents are undefined until it's cleared or drawn to.
+	/// </summary>
+	public static Target Acquire(int width, int height)
+		=> new(width, height, defaultFormats, true);
+
+	/// <inheritdoc cref="Acquire(int, int)"/>
+	public static Target Acquire(int width, int height, TextureFormat[] attachments)
+		=> new(width, height, attachments, true);
+
 	~Target()
 	{
 		Dispose(false);
@@ -106,6 +124,42 @@ public class Target : IResource
 		Platform.FosterClear(&clear);
 	}
 
+	/// <summary>
+	/// Hints that the contents of the Target are no longer needed, which saves tile-based
+	/// GPUs from writing them back to memory. The contents are undefined afterwards.
+	/// </summary>
+	public void Discard()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		Platform.FosterTargetDiscard(resource);
+	}
+
+	/// <summary>
+	/// Begins reading an Attachment of the Target back from the GPU without stalling.
+	/// The result is usually ready a frame or two later.
+	/// </summary>
+	public TextureReadback ReadAsync(int attachment = 0)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		return Attachments[attachment].ReadAsync();
+	}
+
+	/// <summary>
+	/// Begins reading a Rectangle of an Attachment of the Target back from the GPU without stalling.
+	/// The result is usually ready a frame or two later.
+	/// </summary>
+	public TextureReadback ReadAsync(in RectInt rect, int attachment = 0)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		return Attachments[attachment].ReadAsync(rect);
+	}
+
 	/// <summary>
 	/// Disposes of the Target and all its Attachments
 	/// </summary>
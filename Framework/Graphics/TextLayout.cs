@@ -0,0 +1,240 @@
+using System.Numerics;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// Caches the layout of a block of text drawn with a <see cref="SpriteFont"/>, so that text which
+/// doesn't change between frames isn't measured, wrapped and looked up character by character again.
+/// Call <see cref="Set"/> every frame with the text to draw, which only rebuilds the layout when the
+/// text, font or layout options change, and then <see cref="Render"/>.
+/// </summary>
+public class TextLayout
+{
+	private readonly record struct Run(Texture? Texture, int Start, int Count);
+
+	/// <summary>
+	/// The SpriteFont the layout was built with
+	/// </summary>
+	public SpriteFont? Font { get; private set; }
+
+	/// <summary>
+	/// The text the layout was built from
+	/// </summary>
+	public ReadOnlySpan<char> Text => text.AsSpan(0, textLength);
+
+	/// <summary>
+	/// The width the text is wrapped to, or null if it isn't wrapped
+	/// </summary>
+	public float? MaxLineWidth { get; private set; }
+
+	/// <summary>
+	/// The justification of the text relative to the position it's rendered at
+	/// </summary>
+	public Vector2 Justify { get; private set; }
+
+	/// <summary>
+	/// The size of the text
+	/// </summary>
+	public Vector2 Size { get; private set; }
+
+	private char[] text = [];
+	private int textLength;
+	private int fontVersion;
+	private bool dirty = true;
+
+	// vertices are built relative to the (rounded) position of the first line,
+	// and are moved / recolored in place when rendered somewhere else
+	private Batcher.Vertex[] vertices = [];
+	private int vertexCount;
+	private readonly List<Run> runs = [];
+	private Vector2 origin;
+	private Vector2 builtAt;
+	private Color builtColor;
+
+	private static readonly Color ModeNormal = new(255, 0, 0, 0);
+
+	public TextLayout() { }
+
+	public TextLayout(SpriteFont font, ReadOnlySpan<char> text, float? maxLineWidth = null, Vector2 justify = default)
+		=> Set(font, text, maxLineWidth, justify);
+
+	/// <summary>
+	/// Sets the text to lay out, which is only rebuilt if something has changed since the last time
+	/// </summary>
+	public void Set(SpriteFont font, ReadOnlySpan<char> value, float? maxLineWidth = null, Vector2 justify = default)
+	{
+		if (!dirty && Font == font && MaxLineWidth == maxLineWidth && Justify == justify && Text.SequenceEqual(value))
+			return;
+
+		Font = font;
+		MaxLineWidth = maxLineWidth;
+		Justify = justify;
+
+		if (text.Length < value.Length)
+			Array.Resize(ref text, value.Length);
+		value.CopyTo(text);
+		textLength = value.Length;
+		dirty = true;
+	}
+
+	/// <summary>
+	/// Draws the text at the given position
+	/// </summary>
+	public void Render(Batcher batch, Vector2 position, Color color)
+	{
+		if (Font == null)
+			return;
+
+		// characters can change when streamed in, or replaced with AddCharacter
+		if (dirty || fontVersion != Font.Version)
+			Build(color);
+
+		// same as SpriteFont.RenderText, only the starting position is rounded
+		var at = new Vector2(Calc.Round(position.X + origin.X), Calc.Round(position.Y + origin.Y));
+		if (at != builtAt || color != builtColor)
+		{
+			var offset = at - builtAt;
+			for (int i = 0; i < vertexCount; i++)
+			{
+				vertices[i].Pos += offset;
+				vertices[i].Col = color;
+			}
+			builtAt = at;
+			builtColor = color;
+		}
+
+		foreach (var run in runs)
+			batch.Quads(run.Texture, vertices.AsSpan(run.Start, run.Count));
+	}
+
+	private void Build(Color color)
+	{
+		var font = Font!;
+		var value = Text;
+
+		runs.Clear();
+		vertexCount = 0;
+		fontVersion = font.Version;
+		dirty = false;
+		origin = Vector2.Zero;
+		builtAt = Vector2.Zero;
+		builtColor = color;
+
+		if (MaxLineWidth is float maxLineWidth)
+		{
+			var lines = Pool.Get<List<(int Start, int Length)>>();
+			lines.Clear();
+			font.WrapText(value, maxLineWidth, lines);
+
+			var y = 0.0f;
+			if (Justify.Y != 0)
+				y -= Justify.Y * (font.Height * lines.Count + font.LineGap * (lines.Count - 1));
+
+			var width = 0.0f;
+			for (int i = 0; i < lines.Count; i++)
+			{
+				var line = value.Slice(lines[i].Start, lines[i].Length);
+				BuildLines(font, line, new Vector2(0, y), i == 0, color);
+				width = Math.Max(width, font.WidthOf(line));
+				y += font.LineHeight;
+			}
+
+			Size = new(width, lines.Count > 0 ? font.Height * lines.Count + font.LineGap * (lines.Count - 1) : 0);
+			Pool.Return(lines);
+		}
+		else
+		{
+			BuildLines(font, value, Vector2.Zero, true, color);
+			Size = font.SizeOf(value);
+		}
+
+		// group the quads by Texture, so each page is drawn as a single run
+		if (runs.Count > 1)
+		{
+			var sorted = new Batcher.Vertex[vertexCount];
+			var count = 0;
+			var grouped = new List<Run>();
+
+			foreach (var texture in runs.Select(it => it.Texture).Distinct())
+			{
+				var start = count;
+				foreach (var run in runs)
+				{
+					if (run.Texture != texture)
+						continue;
+					vertices.AsSpan(run.Start, run.Count).CopyTo(sorted.AsSpan(count));
+					count += run.Count;
+				}
+				grouped.Add(new(texture, start, count - start));
+			}
+
+			vertices = sorted;
+			runs.Clear();
+			runs.AddRange(grouped);
+		}
+	}
+
+	/// <summary>
+	/// Lays out the text the same as SpriteFont.RenderText would at the given position,
+	/// relative to the origin. The first line laid out sets the origin.
+	/// </summary>
+	private void BuildLines(SpriteFont font, ReadOnlySpan<char> value, Vector2 position, bool first, Color color)
+	{
+		var start = position + new Vector2(0, font.Ascent);
+		var last = 0;
+
+		if (Justify.X != 0)
+			start.X -= Justify.X * font.WidthOfLine(value);
+
+		if (Justify.Y != 0)
+			start.Y -= Justify.Y * font.HeightOf(value);
+
+		if (first)
+			origin = start;
+
+		var at = start - origin;
+
+		for (int i = 0; i < value.Length; i++)
+		{
+			if (value[i] == '\n')
+			{
+				at.X = position.X - origin.X;
+				if (Justify.X != 0 && i < value.Length - 1)
+					at.X -= Justify.X * font.WidthOfLine(value[(i + 1)..]);
+				at.Y += font.LineHeight;
+				last = 0;
+				continue;
+			}
+
+			if (font.TryGetCharacter(value, i, out var ch, out var step))
+			{
+				if (last != 0)
+					at.X += font.GetKerning(last, ch.Codepoint);
+
+				if (ch.Subtexture.Texture != null)
+					PushQuad(ch.Subtexture, at + ch.Offset, color);
+
+				last = ch.Codepoint;
+				at.X += ch.Advance;
+				i += step - 1;
+			}
+		}
+	}
+
+	private void PushQuad(in Subtexture subtex, Vector2 position, Color color)
+	{
+		if (runs.Count <= 0 || runs[^1].Texture != subtex.Texture)
+			runs.Add(new(subtex.Texture, vertexCount, 0));
+
+		if (vertices.Length < vertexCount + 4)
+			Array.Resize(ref vertices, Math.Max(vertexCount + 4, vertices.Length * 2));
+
+		vertices[vertexCount + 0] = new(position + subtex.DrawCoords0, subtex.TexCoords0, color, ModeNormal);
+		vertices[vertexCount + 1] = new(position + subtex.DrawCoords1, subtex.TexCoords1, color, ModeNormal);
+		vertices[vertexCount + 2] = new(position + subtex.DrawCoords2, subtex.TexCoords2, color, ModeNormal);
+		vertices[vertexCount + 3] = new(position + subtex.DrawCoords3, subtex.TexCoords3, color, ModeNormal);
+		vertexCount += 4;
+
+		runs[^1] = runs[^1] with { Count = runs[^1].Count + 4 };
+	}
+}
@@ -33,6 +33,16 @@ public class Texture : IResource
 	/// </summary>
 	public Point2 Size => new(Width, Height);
 
+	/// <summary>
+	/// Gets the number of Layers in the Texture, which is 1 unless it's a Texture Array
+	/// </summary>
+	public readonly int Layers = 1;
+
+	/// <summary>
+	/// If this Texture is a Texture Array, sampled with a sampler2DArray
+	/// </summary>
+	public readonly bool IsArray;
+
 	/// <summary>
 	/// The Texture Data Format
 	/// </summary>
@@ -44,9 +54,21 @@ public class Texture : IResource
 	public readonly bool IsTargetAttachment;
 
 	/// <summary>
-	/// The Memory Size of the Texture, in bytes
+	/// The number of Mip Levels the Texture has, which is 1 until Mipmaps
+	/// are generated or uploaded
+	/// </summary>
+	public int MipLevels { get; private set; } = 1;
+
+	/// <summary>
+	/// The number of Mip Levels in a full chain for this Texture's size, down to 1x1
+	/// </summary>
+	public int MaxMipLevels => 1 + (int)Math.Log2(Math.Max(Width, Height));
+
+	/// <summary>
+	/// The Memory Size of the Texture, in bytes.
+	/// This is only the size of the first Mip Level.
 	/// </summary>
-	public int MemorySize => Width * Height * Format.Size();
+	public int MemorySize => Format.DataSize(Width, Height) * Layers;
 
 	internal readonly IntPtr resource;
 	internal bool disposed = false;
@@ -68,6 +90,32 @@ public class Texture : IResource
 		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterTextureDestroy);
 	}
 
+	/// <summary>
+	/// Creates a Texture Array, where every Layer has the given size
+	/// </summary>
+	public Texture(int width, int height, int layers, TextureFormat format = TextureFormat.Color)
+	{
+		if (width <= 0 || height <= 0)
+			throw new Exception("Texture must have a size larger than 0");
+		if (layers <= 0)
+			throw new Exception("Texture Array must have at least 1 Layer");
+		if (format.IsCompressed())
+			throw new Exception("Compressed Texture Arrays are not supported");
+
+		resource = Platform.FosterTextureCreateArray(width, height, layers, format);
+		if (resource == IntPtr.Zero)
+			throw new Exception("Failed to create Texture Array");
+
+		Width = width;
+		Height = height;
+		Layers = layers;
+		Format = format;
+		IsArray = true;
+		IsTargetAttachment = false;
+
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterTextureDestroy);
+	}
+
 	public Texture(int width, int height, ReadOnlySpan<Color> pixels)
 		: this(width, height, TextureFormat.Color)
 	{
@@ -119,6 +167,147 @@ public class Texture : IResource
 		}
 	}
 
+	/// <summary>
+	/// Sets the Texture data from the given pointer, which must hold at least <see cref="MemorySize"/> bytes.
+	/// Compressed Texture data is uploaded as-is.
+	/// </summary>
+	public unsafe void SetData(IntPtr data, int length)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (length < MemorySize)
+			throw new Exception("Data Buffer is smaller than the Size of the Texture");
+
+		Platform.FosterTextureSetData(resource, (void*)data, length);
+	}
+
+	/// <summary>
+	/// Sets a single Layer of a Texture Array from the given buffer
+	/// </summary>
+	public unsafe void SetLayerData<T>(int layer, ReadOnlySpan<T> data) where T : struct
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (!IsArray)
+			throw new Exception("Texture is not a Texture Array");
+
+		if (layer < 0 || layer >= Layers)
+			throw new Exception($"Layer {layer} is out of the bounds of the Texture Array");
+
+		if (Unsafe.SizeOf<T>() * data.Length < Width * Height * Format.Size())
+			throw new Exception("Data Buffer is smaller than the Size of the Layer");
+
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+		{
+			int length = Unsafe.SizeOf<T>() * data.Length;
+			Platform.FosterTextureSetLayerData(resource, layer, ptr, length);
+		}
+	}
+
+	/// <summary>
+	/// Sets a single Mip Level of the Texture from the given buffer.
+	/// Levels should be set in order, as sampling uses every Level up to the highest one set.
+	/// </summary>
+	public unsafe void SetLevelData<T>(int level, ReadOnlySpan<T> data) where T : struct
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+			SetLevelData(level, new IntPtr(ptr), Unsafe.SizeOf<T>() * data.Length);
+	}
+
+	/// <summary>
+	/// Sets a single Mip Level of the Texture from the given pointer.
+	/// Levels should be set in order, as sampling uses every Level up to the highest one set.
+	/// </summary>
+	public unsafe void SetLevelData(int level, IntPtr data, int length)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (IsArray)
+			throw new Exception("Mip Levels can't be set for Texture Arrays");
+
+		if (level < 0 || level >= MaxMipLevels)
+			throw new Exception($"Mip Level {level} is out of the bounds of the Texture");
+
+		if (length < Format.DataSize(Math.Max(1, Width >> level), Math.Max(1, Height >> level)))
+			throw new Exception("Data Buffer is smaller than the Size of the Mip Level");
+
+		Platform.FosterTextureSetLevelData(resource, level, (void*)data, length);
+		MipLevels = Math.Max(MipLevels, level + 1);
+	}
+
+	/// <summary>
+	/// Generates a full chain of Mipmaps from the Texture's current data.
+	/// This needs to be called again after the Texture data changes.
+	/// </summary>
+	public void GenerateMipmaps()
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (Format.IsCompressed() || Format == TextureFormat.Depth24Stencil8)
+			throw new Exception($"Mipmaps can't be generated for {Format} Textures");
+
+		Platform.FosterTextureGenerateMipmaps(resource);
+		MipLevels = MaxMipLevels;
+	}
+
+	/// <summary>
+	/// Sets a Rectangle of the Texture data from the given buffer.
+	/// The buffer holds the pixels of the Rectangle, row by row.
+	/// </summary>
+	public unsafe void SetData<T>(ReadOnlySpan<T> data, in RectInt rect) where T : struct
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (IsArray)
+			throw new Exception("Texture Arrays must be set one Layer at a time");
+
+		if (Format.IsCompressed())
+			throw new Exception("Compressed Textures must be set all at once");
+
+		if (rect.X < 0 || rect.Y < 0 || rect.Width <= 0 || rect.Height <= 0 || rect.Right > Width || rect.Bottom > Height)
+			throw new Exception("Rectangle is out of the bounds of the Texture");
+
+		if (Unsafe.SizeOf<T>() * data.Length < rect.Width * rect.Height * Format.Size())
+			throw new Exception("Data Buffer is smaller than the Size of the Rectangle");
+
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+		{
+			int length = Unsafe.SizeOf<T>() * data.Length;
+			Platform.FosterTextureSetSubData(resource, new(rect.X, rect.Y, rect.Width, rect.Height), ptr, length);
+		}
+	}
+
+	/// <summary>
+	/// Begins an asynchronous upload to a Rectangle of the Texture.
+	/// The returned staging memory can be filled from any thread, after which
+	/// <see cref="TextureUpload.Submit"/> must be called from the main thread.
+	/// </summary>
+	public TextureUpload BeginUpload(in RectInt rect)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (IsArray)
+			throw new Exception("Texture Arrays must be set one Layer at a time");
+
+		if (Format.IsCompressed())
+			throw new Exception("Compressed Textures must be set all at once");
+
+		if (rect.X < 0 || rect.Y < 0 || rect.Width <= 0 || rect.Height <= 0 || rect.Right > Width || rect.Bottom > Height)
+			throw new Exception("Rectangle is out of the bounds of the Texture");
+
+		var upload = Platform.FosterTextureUploadBegin(resource, new(rect.X, rect.Y, rect.Width, rect.Height));
+		if (upload == IntPtr.Zero)
+			throw new Exception("Failed to begin Texture Upload");
+
+		return new TextureUpload(this, rect, upload, Platform.FosterTextureUploadGetData(upload));
+	}
+
 	/// <summary>
 	/// Writes the Texture data to the given buffer
 	/// </summary>
@@ -127,6 +316,9 @@ public class Texture : IResource
 		if (IsDisposed)
 			throw new Exception("Resource is Disposed");
 
+		if (Format.IsCompressed())
+			throw new Exception("Compressed Textures can't be read back");
+
 		if (Unsafe.SizeOf<T>() * data.Length < MemorySize)
 			throw new Exception("Data Buffer is smaller than the Size of the Texture");
 
@@ -137,6 +329,37 @@ public class Texture : IResource
 		}
 	}
 
+	/// <summary>
+	/// Begins reading the Texture data back from the GPU without stalling.
+	/// The result is usually ready a frame or two later.
+	/// </summary>
+	public TextureReadback ReadAsync() => ReadAsync(new RectInt(0, 0, Width, Height));
+
+	/// <summary>
+	/// Begins reading a Rectangle of the Texture data back from the GPU without stalling.
+	/// The result is usually ready a frame or two later.
+	/// </summary>
+	public TextureReadback ReadAsync(in RectInt rect)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (IsArray)
+			throw new Exception("Texture Arrays can't be read asynchronously");
+
+		if (Format.IsCompressed())
+			throw new Exception("Compressed Textures can't be read back");
+
+		if (rect.X < 0 || rect.Y < 0 || rect.Width <= 0 || rect.Height <= 0 || rect.Right > Width || rect.Bottom > Height)
+			throw new Exception("Rectangle is out of the bounds of the Texture");
+
+		var readback = Platform.FosterTextureReadAsync(resource, new(rect.X, rect.Y, rect.Width, rect.Height));
+		if (readback == IntPtr.Zero)
+			throw new Exception("Failed to begin Texture Readback");
+
+		return new TextureReadback(readback, rect, Format);
+	}
+
 	public void Dispose()
 	{
 		if (IsTargetAttachment)
@@ -0,0 +1,106 @@
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// Texture data being read back from the GPU, created by <see cref="Texture.ReadAsync()"/>.
+/// Poll <see cref="IsReady"/> each frame and get the data once it is true.
+/// </summary>
+public class TextureReadback : IResource
+{
+	/// <summary>
+	/// Optional Readback Name
+	/// </summary>
+	public string Name { get; set; } = string.Empty;
+
+	/// <summary>
+	/// If the Readback has been disposed
+	/// </summary>
+	public bool IsDisposed => disposed;
+
+	/// <summary>
+	/// The Rectangle of the Texture being read
+	/// </summary>
+	public readonly RectInt Rect;
+
+	/// <summary>
+	/// The Texture Data Format
+	/// </summary>
+	public readonly TextureFormat Format;
+
+	/// <summary>
+	/// The Memory Size of the Readback, in bytes
+	/// </summary>
+	public int MemorySize => Rect.Width * Rect.Height * Format.Size();
+
+	/// <summary>
+	/// If the GPU has finished copying the data, in which case getting it will not stall
+	/// </summary>
+	public bool IsReady => !IsDisposed && Platform.FosterReadbackPoll(resource) != 0;
+
+	internal readonly IntPtr resource;
+	internal bool disposed = false;
+
+	internal TextureReadback(IntPtr resource, in RectInt rect, TextureFormat format)
+	{
+		this.resource = resource;
+		Rect = rect;
+		Format = format;
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterReadbackDestroy);
+	}
+
+	~TextureReadback()
+	{
+		Dispose(false);
+	}
+
+	/// <summary>
+	/// Writes the Readback data to the given buffer.
+	/// This will stall until the GPU has finished if it is not yet <see cref="IsReady"/>.
+	/// </summary>
+	public unsafe void GetData<T>(Span<T> data) where T : struct
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (Unsafe.SizeOf<T>() * data.Length < MemorySize)
+			throw new Exception("Data Buffer is smaller than the Size of the Readback");
+
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+		{
+			int length = Unsafe.SizeOf<T>() * data.Length;
+			if (Platform.FosterReadbackGet(resource, ptr, length) == 0)
+				throw new Exception("Failed to get Readback data");
+		}
+	}
+
+	/// <summary>
+	/// Creates an Image from the Readback data.
+	/// This will stall until the GPU has finished if it is not yet <see cref="IsReady"/>.
+	/// </summary>
+	public Image GetImage()
+	{
+		if (Format != TextureFormat.Color)
+			throw new Exception("Only Color Readbacks can be converted to an Image");
+
+		var image = new Image(Rect.Width, Rect.Height);
+		GetData(image.Data);
+		return image;
+	}
+
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (!disposed)
+		{
+			disposed = true;
+			Graphics.Resources.RequestDelete(resource);
+		}
+	}
+}
@@ -2,9 +2,16 @@ using System.Runtime.InteropServices;
 
 namespace Foster.Framework;
 
+/// <summary>
+/// How a Texture is sampled.
+/// The Mip Filter only has an effect on Textures with Mipmaps, and Anisotropy
+/// is clamped to what the Renderer supports, where 0 or 1 disables it.
+/// </summary>
 [StructLayout(LayoutKind.Sequential)]
 public readonly record struct TextureSampler(
 	TextureFilter Filter,
 	TextureWrap WrapX,
-	TextureWrap WrapY
+	TextureWrap WrapY,
+	TextureMipFilter MipFilter = TextureMipFilter.None,
+	int Anisotropy = 0
 );
@@ -0,0 +1,120 @@
+namespace Foster.Framework;
+
+/// <summary>
+/// An asynchronous upload to a Rectangle of a Texture, created by <see cref="Texture.BeginUpload"/>.
+/// The staging memory can be written to from any thread until the upload is Submitted.
+/// Disposing an upload that hasn't been Submitted cancels it, releasing its staging memory.
+/// </summary>
+public class TextureUpload : IResource
+{
+	/// <summary>
+	/// Optional Upload Name
+	/// </summary>
+	public string Name { get; set; } = string.Empty;
+
+	/// <summary>
+	/// If the upload has been Submitted or Disposed
+	/// </summary>
+	public bool IsDisposed { get; private set; }
+
+	/// <summary>
+	/// The Texture being uploaded to
+	/// </summary>
+	public readonly Texture Texture;
+
+	/// <summary>
+	/// The Rectangle of the Texture being uploaded to
+	/// </summary>
+	public readonly RectInt Rect;
+
+	/// <summary>
+	/// The Size of the staging memory, in bytes
+	/// </summary>
+	public int Length => Rect.Width * Rect.Height * Texture.Format.Size();
+
+	/// <summary>
+	/// If the upload has been Submitted, after which its data can no longer be written to
+	/// </summary>
+	public bool IsSubmitted { get; private set; }
+
+	/// <summary>
+	/// The staging memory, which holds the pixels of the Rectangle row by row
+	/// </summary>
+	public unsafe Span<byte> Data
+	{
+		get
+		{
+			if (IsSubmitted)
+				throw new Exception("Texture Upload has already been Submitted");
+			if (IsDisposed)
+				throw new Exception("Resource is Disposed");
+			return new Span<byte>((void*)data, Length);
+		}
+	}
+
+	private readonly IntPtr resource;
+	private readonly IntPtr data;
+
+	internal TextureUpload(Texture texture, in RectInt rect, IntPtr resource, IntPtr data)
+	{
+		Texture = texture;
+		Rect = rect;
+		this.resource = resource;
+		this.data = data;
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterTextureUploadCancel);
+	}
+
+	~TextureUpload()
+	{
+		Dispose(false);
+	}
+
+	/// <summary>
+	/// Gets the staging memory as a Span of the given type
+	/// </summary>
+	public unsafe Span<T> GetData<T>() where T : unmanaged
+	{
+		if (IsSubmitted)
+			throw new Exception("Texture Upload has already been Submitted");
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+		return new Span<T>((void*)data, Length / sizeof(T));
+	}
+
+	/// <summary>
+	/// Copies the staging memory into the Texture. This must be called from the
+	/// main thread, once all writes to the staging memory have finished.
+	/// </summary>
+	public void Submit()
+	{
+		if (IsSubmitted)
+			throw new Exception("Texture Upload has already been Submitted");
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		// submitting frees the upload, so it no longer needs to be cancelled
+		IsSubmitted = true;
+		IsDisposed = true;
+		Graphics.Resources.Unregister(resource);
+		Platform.FosterTextureUploadSubmit(resource);
+		GC.SuppressFinalize(this);
+	}
+
+	/// <summary>
+	/// Cancels the upload if it hasn't been Submitted, releasing its staging memory
+	/// </summary>
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (!IsDisposed)
+		{
+			IsDisposed = true;
+			Graphics.Resources.RequestDelete(resource);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// A block of GPU memory holding Uniform values. It can be updated once and
+/// then assigned to the Uniform Blocks of any number of Materials.
+/// </summary>
+public class UniformBuffer : IResource
+{
+	/// <summary>
+	/// Optional Uniform Buffer Name
+	/// </summary>
+	public string Name { get; set; } = string.Empty;
+
+	/// <summary>
+	/// If the Uniform Buffer has been disposed
+	/// </summary>
+	public bool IsDisposed => disposed;
+
+	/// <summary>
+	/// The Size of the Uniform Buffer, in bytes
+	/// </summary>
+	public readonly int Size;
+
+	internal readonly IntPtr resource;
+	internal bool disposed = false;
+
+	public UniformBuffer(int size)
+	{
+		if (size <= 0)
+			throw new Exception("Uniform Buffer must have a size larger than 0");
+
+		Size = size;
+		resource = Platform.FosterUniformBufferCreate(size);
+		if (resource == IntPtr.Zero)
+			throw new Exception("Failed to create Uniform Buffer");
+		Graphics.Resources.RegisterAllocated(this, resource, Platform.FosterUniformBufferDestroy);
+	}
+
+	~UniformBuffer()
+	{
+		Dispose(false);
+	}
+
+	/// <summary>
+	/// Uploads a value to the Uniform Buffer at the given byte offset.
+	/// The value must match the std140 layout of the Uniform Block.
+	/// </summary>
+	public unsafe void SetData<T>(in T value, int offset = 0) where T : unmanaged
+	{
+		fixed (T* ptr = &value)
+			SetData(new IntPtr(ptr), sizeof(T), offset);
+	}
+
+	/// <summary>
+	/// Uploads values to the Uniform Buffer at the given byte offset.
+	/// The values must match the std140 layout of the Uniform Block.
+	/// </summary>
+	public unsafe void SetData<T>(ReadOnlySpan<T> data, int offset = 0) where T : unmanaged
+	{
+		fixed (byte* ptr = MemoryMarshal.AsBytes(data))
+			SetData(new IntPtr(ptr), data.Length * sizeof(T), offset);
+	}
+
+	/// <summary>
+	/// Uploads data to the Uniform Buffer at the given byte offset.
+	/// </summary>
+	public void SetData(IntPtr data, int length, int offset = 0)
+	{
+		if (IsDisposed)
+			throw new Exception("Resource is Disposed");
+
+		if (offset < 0 || offset + length > Size)
+			throw new Exception("Data is out of range of the Uniform Buffer");
+
+		Platform.FosterUniformBufferSetData(resource, data, length, offset);
+	}
+
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (!disposed)
+		{
+			disposed = true;
+			Graphics.Resources.RequestDelete(resource);
+		}
+	}
+}
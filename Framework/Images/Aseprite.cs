@@ -5,7 +5,7 @@ using System.Text;
 
 namespace Foster.Framework;
 
-public class Aseprite : Aseprite.IUserDataTarget
+public class Aseprite : Aseprite.IUserDataTarget, IDisposable
 {
 	private enum ChunkType
 	{
@@ -143,9 +143,42 @@ public class Aseprite : Aseprite.IUserDataTarget
 		public Point2 Pos;
 		public byte Opacity;
 		public int ZIndex;
-		public Image? Image;
 		public AseUserData UserData { get; set; } = new();
 
+		/// <summary>
+		/// The Cel's pixels. In files opened with <see cref="Open"/>, this is
+		/// decompressed the first time it's requested, which is thread-safe.
+		/// </summary>
+		public Image? Image
+		{
+			get => lazyImage != null ? lazyImage.Value : image;
+			set
+			{
+				image = value;
+				lazyImage = null;
+			}
+		}
+
+		private Image? image;
+		private Lazy<Image?>? lazyImage;
+
+		/// <summary>
+		/// If the Cel's Image has been decompressed (or was never lazily loaded)
+		/// </summary>
+		public bool IsLoaded => lazyImage == null || lazyImage.IsValueCreated;
+
+		internal void SetLazy(Lazy<Image?> lazy)
+		{
+			image = null;
+			lazyImage = lazy;
+		}
+
+		internal void LinkTo(Cel cel)
+		{
+			image = cel.image;
+			lazyImage = cel.lazyImage;
+		}
+
 		public Cel(Layer layer, Point2 pos, byte opacity, int zIndex)
 		{
 			Layer = layer;
@@ -195,6 +228,20 @@ public class Aseprite : Aseprite.IUserDataTarget
 	public List<Slice> Slices = new();
 	public List<Layer> Layers = new();
 	public AseUserData UserData { get; set; } = new();
+
+	/// <summary>
+	/// The file data that Cels are lazily decompressed from, if opened with <see cref="Open"/>
+	/// </summary>
+	private MappedFile? mapped;
+	private Format format;
+
+	/// <summary>
+	/// How many Cels are currently being decompressed from the mapped file. The file is
+	/// only released once none are, so disposing never frees memory that's being read.
+	/// </summary>
+	private int mappedReaders;
+	private bool disposeRequested;
+	private readonly object mappedLock = new();
 	
 	public Aseprite(string filePath)
 	{
@@ -213,6 +260,104 @@ public class Aseprite : Aseprite.IUserDataTarget
 		using var bin = new BinaryReader(stream);
 		Load(bin);
 	}
+
+	private Aseprite(MappedFile file)
+	{
+		mapped = file;
+		using var bin = new BinaryReader(file.CreateStream());
+		Load(bin);
+	}
+
+	/// <summary>
+	/// Opens an Aseprite file without loading its pixels. The file is memory-mapped, its chunks
+	/// are indexed, and each Cel's Image is only decompressed the first time it's requested
+	/// (see <see cref="DecodeAsync"/> to do so ahead of time). The file stays mapped until
+	/// the Aseprite is disposed, after which Cels that were never requested can't be loaded.
+	/// </summary>
+	public static Aseprite Open(string filePath)
+		=> Open(new MappedFile(filePath));
+
+	/// <summary>
+	/// Opens an Aseprite file from mapped memory without loading its pixels, which
+	/// the Aseprite takes ownership of. See <see cref="Open(string)"/>.
+	/// </summary>
+	public static Aseprite Open(MappedFile file)
+	{
+		try
+		{
+			return new Aseprite(file);
+		}
+		catch
+		{
+			file.Dispose();
+			throw;
+		}
+	}
+
+	/// <summary>
+	/// Decompresses every Cel that hasn't been yet, across worker threads
+	/// </summary>
+	public Task DecodeAsync()
+	{
+		var cels = Frames.SelectMany(it => it.Cels).Where(it => !it.IsLoaded).ToArray();
+		return Task.Run(() => Parallel.ForEach(cels, it => _ = it.Image));
+	}
+
+	/// <summary>
+	/// Releases the mapped file of an Aseprite opened with <see cref="Open"/>.
+	/// Cel Images that have already been loaded remain valid, and Cels being loaded
+	/// on other threads finish first, after which the file is released.
+	/// </summary>
+	public void Dispose()
+	{
+		MappedFile? release = null;
+		lock (mappedLock)
+		{
+			disposeRequested = true;
+			if (mappedReaders == 0)
+			{
+				release = mapped;
+				mapped = null;
+			}
+		}
+		release?.Dispose();
+	}
+
+	/// <summary>
+	/// Decompresses a lazily loaded Cel, keeping the mapped file alive while it's read
+	/// </summary>
+	private Image LoadLazyCel(long offset, long length, CelType type, int width, int height)
+	{
+		MappedFile file;
+		lock (mappedLock)
+		{
+			if (disposeRequested || mapped == null)
+				throw new ObjectDisposedException(nameof(Aseprite), "The Aseprite was disposed before the Cel was loaded");
+			file = mapped;
+			mappedReaders++;
+		}
+
+		try
+		{
+			using var stream = file.CreateStream(offset, length);
+			return ReadCelImage(stream, type, width, height, null);
+		}
+		finally
+		{
+			MappedFile? release = null;
+			lock (mappedLock)
+			{
+				mappedReaders--;
+				if (disposeRequested && mappedReaders == 0)
+				{
+					release = mapped;
+					mapped = null;
+				}
+			}
+			release?.Dispose();
+		}
+	}
+
 	private void Load(BinaryReader bin)
 	{
 		// Shorthand methods to match Aseprite's naming convention
@@ -232,7 +377,7 @@ public class Aseprite : Aseprite.IUserDataTarget
 		var frameCount = ReadWord();
 		Width = ReadWord();
 		Height = ReadWord();
-		var format = (Format)ReadWord();
+		format = (Format)ReadWord();
 		ReadDWord(); // Flags (IGNORE)
 		ReadWord(); // Speed (DEPRECATED)
 		ReadDWord(); // Set be 0
@@ -407,46 +552,25 @@ public class Aseprite : Aseprite.IUserDataTarget
 					{
 						var linkedFrame = ReadWord();
 						var linkedCel = Frames[linkedFrame].Cels.Find(c => c.Layer == layer)!;
-						cel.Image = linkedCel.Image;
+						cel.LinkTo(linkedCel);
 						SkipTo(chunkEnd);
 						continue;
 					}
 
 					var width = (int)ReadWord();
 					var height = (int)ReadWord();
-					var pixels = new Color[width * height];
-					var decompressedLen = width * height * ((int)format / 8);
-
-					if (buffer.Length < decompressedLen)
-						Array.Resize(ref buffer, decompressedLen);
 
-					if (type == CelType.RawImageData)
+					// only remember where the pixels are, to be decompressed when requested
+					if (mapped != null)
 					{
-						bin.Read(buffer, 0, decompressedLen);
-					}
-					else if (type == CelType.CompressedImage)
-					{
-						using var zip = new ZLibStream(bin.BaseStream, CompressionMode.Decompress, true);
-						zip.ReadExactly(buffer, 0, decompressedLen);
-					}
-
-					switch (format)
-					{
-						case Format.Rgba:
-							for (int i = 0, b = 0; i < pixels.Length; ++i, b += 4)
-								pixels[i] = new Color(buffer[b], buffer[b + 1], buffer[b + 2], buffer[b + 3]);
-							break;
-						case Format.Grayscale:
-							for (int i = 0, b = 0; i < pixels.Length; ++i, b += 2)
-								pixels[i] = new Color(buffer[b], buffer[b], buffer[b], buffer[b + 1]);
-							break;
-						case Format.Indexed:
-							for (int i = 0; i < pixels.Length; ++i)
-								pixels[i] = Palette[buffer[i]];
-							break;
+						var offset = bin.BaseStream.Position;
+						var length = chunkEnd - offset;
+						cel.SetLazy(new(() => LoadLazyCel(offset, length, type, width, height)));
+						SkipTo(chunkEnd);
+						continue;
 					}
 
-					cel.Image = new Image(width, height, pixels);
+					cel.Image = ReadCelImage(bin.BaseStream, type, width, height, buffer);
 				}
 
 				SkipTo(chunkEnd);
@@ -454,6 +578,46 @@ public class Aseprite : Aseprite.IUserDataTarget
 		}
 	}
 
+	/// <summary>
+	/// Reads the pixels of a Cel, starting at its width and height
+	/// </summary>
+	private Image ReadCelImage(Stream stream, CelType type, int width, int height, byte[]? buffer)
+	{
+		var pixels = new Color[width * height];
+		var decompressedLen = width * height * ((int)format / 8);
+
+		if (buffer == null || buffer.Length < decompressedLen)
+			buffer = new byte[decompressedLen];
+
+		if (type == CelType.RawImageData)
+		{
+			stream.ReadExactly(buffer, 0, decompressedLen);
+		}
+		else if (type == CelType.CompressedImage)
+		{
+			using var zip = new ZLibStream(stream, CompressionMode.Decompress, true);
+			zip.ReadExactly(buffer, 0, decompressedLen);
+		}
+
+		switch (format)
+		{
+			case Format.Rgba:
+				for (int i = 0, b = 0; i < pixels.Length; ++i, b += 4)
+					pixels[i] = new Color(buffer[b], buffer[b + 1], buffer[b + 2], buffer[b + 3]);
+				break;
+			case Format.Grayscale:
+				for (int i = 0, b = 0; i < pixels.Length; ++i, b += 2)
+					pixels[i] = new Color(buffer[b], buffer[b], buffer[b], buffer[b + 1]);
+				break;
+			case Format.Indexed:
+				for (int i = 0; i < pixels.Length; ++i)
+					pixels[i] = Palette[buffer[i]];
+				break;
+		}
+
+		return new Image(width, height, pixels);
+	}
+
 	/// <summary>
 	/// Renders the frame at the given Index
 	/// </summary>
@@ -24,6 +24,7 @@ public class Font : IDisposable
 	private IntPtr fontPtr;
 	private IntPtr dataPtr;
 	private GCHandle dataHandle;
+	private MappedFile? dataMapped;
 	private int dataLength;
 	private readonly Dictionary<int, int> codepointToGlyphLookup = new();
 
@@ -38,10 +39,24 @@ public class Font : IDisposable
 		Load(stream);
 	}
 
+	/// <summary>
+	/// Loads the Font from the given path, which is memory-mapped instead of being read into memory
+	/// </summary>
 	public Font(string path)
+		: this(new MappedFile(path))
 	{
-		using var stream = File.OpenRead(path);
-		Load(stream);
+
+	}
+
+	/// <summary>
+	/// Loads the Font directly from the mapped memory, which the Font takes ownership of
+	/// </summary>
+	public Font(MappedFile file)
+	{
+		dataMapped = file;
+		dataPtr = file.Pointer;
+		dataLength = checked((int)file.Length);
+		Load();
 	}
 
 	~Font() => Dispose();
@@ -56,7 +71,11 @@ public class Font : IDisposable
 		dataHandle =  GCHandle.Alloc(buffer, GCHandleType.Pinned);
 		dataPtr = dataHandle.AddrOfPinnedObject();
 		dataLength = buffer.Length;
+		Load();
+	}
 
+	private void Load()
+	{
 		// create the font ptr
 		fontPtr = Platform.FosterFontInit(dataPtr, dataLength);
 		if (fontPtr == IntPtr.Zero)
@@ -215,12 +234,43 @@ public class Font : IDisposable
 		return true;
 	}
 
+	/// <summary>
+	/// Renders a glyph as a single channel Signed Distance Field, where 128 is the edge of the glyph and
+	/// each step of 128 / padding away from it is one pixel further inside or outside. The field includes
+	/// the padding on every side, and the offset is relative to the glyph's origin, same as <see cref="Character.Offset"/>.
+	/// Returns false if the glyph has no shape to render.
+	/// </summary>
+	public unsafe bool GetDistanceField(int glyphIndex, float scale, int padding, ref byte[] buffer, out int width, out int height, out Vector2 offset)
+	{
+		if (fontPtr == IntPtr.Zero)
+			throw new Exception("Trying to use an invalid Font");
+
+		padding = Math.Max(1, padding);
+		var data = Platform.FosterFontGetSDF(fontPtr, glyphIndex, scale, padding, 128, 128.0f / padding,
+			out width, out height, out int offsetX, out int offsetY);
+		offset = new Vector2(offsetX, offsetY);
+
+		if (data == IntPtr.Zero)
+			return false;
+
+		var length = width * height;
+		if (buffer.Length < length)
+			Array.Resize(ref buffer, length);
+
+		new ReadOnlySpan<byte>((void*)data, length).CopyTo(buffer);
+		Platform.FosterFontFreeSDF(data);
+		return true;
+	}
+
 	public void Dispose()
 	{
 		if (dataPtr != IntPtr.Zero)
 		{
-			dataHandle.Free();
+			if (dataHandle.IsAllocated)
+				dataHandle.Free();
 			dataHandle = new();
+			dataMapped?.Dispose();
+			dataMapped = null;
 			dataPtr = IntPtr.Zero;
 		}
 
@@ -89,8 +89,16 @@ public class Image : IDisposable
 
 	public Image(string file)
 	{
-		using var stream = File.OpenRead(file);
-		Load(stream);
+		using var mapped = new MappedFile(file);
+		Load(mapped);
+	}
+
+	/// <summary>
+	/// Decodes an Image directly from the mapped memory
+	/// </summary>
+	public Image(MappedFile file)
+	{
+		Load(file);
 	}
 
 	public Image(Stream stream)
@@ -98,24 +106,110 @@ public class Image : IDisposable
 		Load(stream);
 	}
 
+	private Image(nint data, int width, int height)
+	{
+		Width = width;
+		Height = height;
+		ptr = data;
+		unmanaged = true;
+	}
+
 	~Image()
 	{
 		Dispose();
 	}
 
+	/// <summary>
+	/// Loads many Images at once, reading the files and decoding them across multiple threads.
+	/// Throws if any of them fail to load.
+	/// </summary>
+	public static Image[] LoadParallel(IReadOnlyList<string> files)
+	{
+		var data = new byte[files.Count][];
+		Parallel.For(0, files.Count, i => data[i] = File.ReadAllBytes(files[i]));
+		return LoadParallel(data, files);
+	}
+
+	/// <summary>
+	/// Loads many Images at once from their encoded data, decoding them across multiple threads.
+	/// Throws if any of them fail to load.
+	/// </summary>
+	public static Image[] LoadParallel(IReadOnlyList<byte[]> data)
+	{
+		return LoadParallel(data, null);
+	}
+
+	private static unsafe Image[] LoadParallel(IReadOnlyList<byte[]> data, IReadOnlyList<string>? names)
+	{
+		var count = data.Count;
+		var handles = new GCHandle[count];
+		var memory = new nint[count];
+		var lengths = new int[count];
+		var outputs = new nint[count];
+		var widths = new int[count];
+		var heights = new int[count];
+
+		try
+		{
+			for (int i = 0; i < count; i++)
+			{
+				handles[i] = GCHandle.Alloc(data[i], GCHandleType.Pinned);
+				memory[i] = handles[i].AddrOfPinnedObject();
+				lengths[i] = data[i].Length;
+			}
+
+			fixed (nint* memoryPtr = memory)
+			fixed (int* lengthsPtr = lengths)
+			fixed (nint* outputsPtr = outputs)
+			fixed (int* widthsPtr = widths)
+			fixed (int* heightsPtr = heights)
+				Platform.FosterImageLoadMany(memoryPtr, lengthsPtr, count, outputsPtr, widthsPtr, heightsPtr);
+		}
+		finally
+		{
+			for (int i = 0; i < count; i++)
+			{
+				if (handles[i].IsAllocated)
+					handles[i].Free();
+			}
+		}
+
+		// returns invalid ptrs for images it was unable to load
+		var failed = Array.IndexOf(outputs, 0);
+		if (failed >= 0)
+		{
+			for (int i = 0; i < count; i++)
+			{
+				if (outputs[i] != 0)
+					Platform.FosterImageFree(outputs[i]);
+			}
+
+			throw new Exception(names != null ? $"Failed to load Image '{names[failed]}'" : "Failed to load Image");
+		}
+
+		var images = new Image[count];
+		for (int i = 0; i < count; i++)
+			images[i] = new Image(outputs[i], widths[i], heights[i]);
+		return images;
+	}
+
 	private unsafe void Load(Stream stream)
 	{
 		// get all the bytes
 		var data = new byte[stream.Length - stream.Position];
 		stream.Read(data);
 
-		// load image from byte data
-		nint mem;
-		int w, h;
 		fixed (byte* it = data)
-		{
-			mem = Platform.FosterImageLoad(it, data.Length, out w, out h);
-		}
+			Load(it, data.Length);
+	}
+
+	private unsafe void Load(MappedFile file)
+		=> Load((byte*)file.Pointer, checked((int)file.Length));
+
+	private unsafe void Load(byte* data, int length)
+	{
+		// load image from byte data
+		var mem = Platform.FosterImageLoad(data, length, out int w, out int h);
 
 		// returns invalid ptr if unable to load
 		if (mem == 0)
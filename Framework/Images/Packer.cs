@@ -1,3 +1,5 @@
+using System.Numerics;
+using System.Runtime.InteropServices;
 
 namespace Foster.Framework;
 
@@ -45,6 +47,51 @@ public class Packer
 	{
 		public readonly List<Image> Pages = [];
 		public readonly List<Entry> Entries = [];
+
+		/// <summary>
+		/// Creates a Texture Array holding every Page as a Layer, so that Entries from
+		/// different Pages can be drawn without switching Textures. Each Layer is the
+		/// size of the largest Page, with smaller Pages placed in the top-left.
+		/// </summary>
+		public Texture CreateTextureArray()
+		{
+			if (Pages.Count <= 0)
+				throw new Exception("There are no Pages to create a Texture Array from");
+
+			int width = 0, height = 0;
+			foreach (var page in Pages)
+			{
+				width = Math.Max(width, page.Width);
+				height = Math.Max(height, page.Height);
+			}
+
+			var texture = new Texture(width, height, Pages.Count);
+			Image? layer = null;
+
+			for (int i = 0; i < Pages.Count; i++)
+			{
+				var page = Pages[i];
+				if (page.Width == width && page.Height == height)
+				{
+					texture.SetLayerData<Color>(i, page.Data);
+					continue;
+				}
+
+				layer ??= new Image(width, height);
+				layer.Data.Clear();
+				layer.CopyPixels(page.Data, page.Width, page.Height, Point2.Zero);
+				texture.SetLayerData<Color>(i, layer.Data);
+			}
+
+			layer?.Dispose();
+			return texture;
+		}
+
+		/// <summary>
+		/// Creates a Subtexture for the Entry, from a Texture Array made with <see cref="CreateTextureArray"/>
+		/// </summary>
+		public static Subtexture GetSubtexture(Texture textureArray, in Entry entry)
+			=> new(textureArray, entry.Source, entry.Frame, entry.Page);
 	}
 
 	/// <summary>
@@ -78,6 +125,29 @@ public class Packer
 	/// </summary>
 	public bool CombineDuplicates = false;
 
+	/// <summary>
+	/// The heuristic used to place entries within each page
+	/// </summary>
+	public PackingMethod Method = PackingMethod.Tree;
+
+	/// <summary>
+	/// Heuristics used to place entries within each page
+	/// </summary>
+	public enum PackingMethod
+	{
+		/// <summary>
+		/// Grows each page from the largest entry with a binary tree, which keeps pages
+		/// close to square but can leave gaps between entries of very different sizes
+		/// </summary>
+		Tree,
+
+		/// <summary>
+		/// Places entries from tallest to shortest at the lowest point of the page's skyline.
+		/// This packs tighter than <see cref="Tree"/>, especially for many entries of similar heights
+		/// </summary>
+		Skyline,
+	}
+
 	/// <summary>
 	/// The total number of source images
 	/// </summary>
@@ -86,7 +156,7 @@ public class Packer
 	private struct Source(int index, string name)
 	{
 		public int Index = index;
-		public int Hash;
+		public ulong Hash;
 		public string Name = name;
 		public RectInt Packed;
 		public RectInt Frame;
@@ -97,6 +167,7 @@ public class Packer
 	}
 
 	private readonly List<Source> sources = [];
+	private readonly Dictionary<ulong, (int Index, int BufferIndex, Point2 Size)> hashes = [];
 	private Color[] sourceBuffer = new Color[32];
 	private int sourceBufferIndex = 0;
 
@@ -128,69 +199,60 @@ public class Packer
 
 	public int Add(int index, string name, RectInt clip, int stride, ReadOnlySpan<Color> pixels)
 	{
-		var source = new Source(index, name);
-		int top = clip.Top, left = clip.Left, right = clip.Right, bottom = clip.Bottom;
+		var trimmed = Trim ? GetTrimmedBounds(clip, stride, pixels) : clip;
+		var hash = CombineDuplicates ? HashPixels(trimmed, stride, pixels) : 0;
+		return Add(index, name, clip, trimmed, hash, stride, pixels);
+	}
+
+	/// <summary>
+	/// Adds many images at once, trimming and hashing them across multiple threads.
+	/// They're given sequential indices, in the same order as if they were added one at a time.
+	/// </summary>
+	public void AddRange(IReadOnlyList<(string Name, Image Image)> images)
+	{
+		var trimmed = new RectInt[images.Count];
+		var hashes = new ulong[images.Count];
 
-		// trim
-		if (Trim)
+		Parallel.For(0, images.Count, i =>
 		{
-			// TOP:
-			for (int y = clip.Top; y < clip.Bottom; y++)
-				for (int x = clip.Left, s = left + y * stride; x < clip.Right; x++, s++)
-					if (pixels[s].A > 0)
-					{
-						top = y;
-						goto LEFT;
-					}
-				LEFT:
-			for (int x = clip.Left; x < clip.Right; x++)
-				for (int y = top, s = x + y * stride; y < clip.Bottom; y++, s += stride)
-					if (pixels[s].A > 0)
-					{
-						left = x;
-						goto RIGHT;
-					}
-				RIGHT:
-			for (int x = clip.Right - 1; x >= left; x--)
-				for (int y = top, s = x + y * stride; y < clip.Bottom; y++, s += stride)
-					if (pixels[s].A > 0)
-					{
-						right = x + 1;
-						goto BOTTOM;
-					}
-				BOTTOM:
-			for (int y = clip.Bottom - 1; y >= top; y--)
-				for (int x = left, s = left + y * stride; x < right; x++, s++)
-					if (pixels[s].A > 0)
-					{
-						bottom = y + 1;
-						goto END;
-					}
-				END:;
+			var image = images[i].Image;
+			var clip = new RectInt(0, 0, image.Width, image.Height);
+			trimmed[i] = Trim ? GetTrimmedBounds(clip, image.Width, image.Data) : clip;
+			if (CombineDuplicates)
+				hashes[i] = HashPixels(trimmed[i], image.Width, image.Data);
+		});
+
+		for (int i = 0; i < images.Count; i++)
+		{
+			var (name, image) = images[i];
+			Add(sources.Count, name, new RectInt(0, 0, image.Width, image.Height), trimmed[i], hashes[i], image.Width, image.Data);
 		}
+	}
+
+	private int Add(int index, string name, RectInt clip, RectInt trimmed, ulong hash, int stride, ReadOnlySpan<Color> pixels)
+	{
+		var source = new Source(index, name);
+		int top = trimmed.Top, left = trimmed.Left, right = trimmed.Right, bottom = trimmed.Bottom;
 
 		// determine sizes
 		// there's a chance this image was empty in which case we have no width / height
 		if (left <= right && top <= bottom)
 		{
+			source.Packed = new RectInt(0, 0, right - left, bottom - top);
+			source.Frame = new RectInt(clip.Left - left, clip.Top - top, clip.Width, clip.Height);
+
+			// the hash only finds candidates, which must also have the same pixels to be combined.
+			// a (very unlikely) collision between different pixels is simply packed separately
+			var isNewHash = false;
 			if (CombineDuplicates)
 			{
-				source.Hash = 0;
-				for (int x = left; x < right; x++)
-					for (int y = top; y < bottom; y++)
-						source.Hash = ((source.Hash << 5) + source.Hash) + (int)pixels[x + y * stride].RGBA;
-
-				for (int i = 0; i < sources.Count; i++)
-					if (sources[i].Hash == source.Hash)
-					{
-						source.DuplicateOf = sources[i].Index;
-						break;
-					}
+				source.Hash = hash;
+				if (!hashes.TryGetValue(hash, out var existing))
+					isNewHash = true;
+				else if (IsSameImage(existing.BufferIndex, existing.Size, trimmed, stride, pixels))
+					source.DuplicateOf = existing.Index;
 			}
 
-			source.Packed = new RectInt(0, 0, right - left, bottom - top);
-			source.Frame = new RectInt(clip.Left - left, clip.Top - top, clip.Width, clip.Height);
-
 			if (!source.DuplicateOf.HasValue)
 			{
 				var append = source.Packed.Width * source.Packed.Height;
@@ -212,6 +274,9 @@ public class Packer
 					srcData.CopyTo(dstData);
 					sourceBufferIndex += len;
 				}
+
+				if (isNewHash)
+					hashes.Add(hash, (index, source.BufferIndex, source.Packed.Size));
 			}
 		}
 		else
@@ -224,6 +289,94 @@ public class Packer
 		return source.Index;
 	}
 
+	/// <summary>
+	/// Finds the bounds of the clip with transparent edges removed
+	/// </summary>
+	private static RectInt GetTrimmedBounds(RectInt clip, int stride, ReadOnlySpan<Color> pixels)
+	{
+		int top = clip.Top, left = clip.Left, right = clip.Right, bottom = clip.Bottom;
+
+		// TOP:
+		for (int y = clip.Top; y < clip.Bottom; y++)
+			for (int x = clip.Left, s = left + y * stride; x < clip.Right; x++, s++)
+				if (pixels[s].A > 0)
+				{
+					top = y;
+					goto LEFT;
+				}
+			LEFT:
+		for (int x = clip.Left; x < clip.Right; x++)
+			for (int y = top, s = x + y * stride; y < clip.Bottom; y++, s += stride)
+				if (pixels[s].A > 0)
+				{
+					left = x;
+					goto RIGHT;
+				}
+			RIGHT:
+		for (int x = clip.Right - 1; x >= left; x--)
+			for (int y = top, s = x + y * stride; y < clip.Bottom; y++, s += stride)
+				if (pixels[s].A > 0)
+				{
+					right = x + 1;
+					goto BOTTOM;
+				}
+			BOTTOM:
+		for (int y = clip.Bottom - 1; y >= top; y--)
+			for (int x = left, s = left + y * stride; x < right; x++, s++)
+				if (pixels[s].A > 0)
+				{
+					bottom = y + 1;
+					goto END;
+				}
+			END:;
+
+		return new RectInt(left, top, right - left, bottom - top);
+	}
+
+	/// <summary>
+	/// Compares buffered source pixels to the given trimmed pixels
+	/// </summary>
+	private bool IsSameImage(int bufferIndex, Point2 size, RectInt rect, int stride, ReadOnlySpan<Color> pixels)
+	{
+		if (size.X != rect.Width || size.Y != rect.Height)
+			return false;
+
+		for (int y = 0; y < rect.Height; y++)
+		{
+			var row = pixels.Slice(rect.Left + (rect.Top + y) * stride, rect.Width);
+			var existing = sourceBuffer.AsSpan(bufferIndex + y * rect.Width, rect.Width);
+			if (!MemoryMarshal.AsBytes(row).SequenceEqual(MemoryMarshal.AsBytes(existing)))
+				return false;
+		}
+
+		return true;
+	}
+
+	private static ulong HashPixels(RectInt rect, int stride, ReadOnlySpan<Color> pixels)
+	{
+		// include the size, as images of the same pixels in different shapes aren't duplicates
+		Span<int> size = [rect.Width, rect.Height];
+		var hash = Hash(HashSeed, MemoryMarshal.AsBytes(size));
+		for (int y = rect.Top; y < rect.Bottom; y++)
+			hash = Hash(hash, MemoryMarshal.AsBytes(pixels.Slice(rect.Left + y * stride, rect.Width)));
+		return hash;
+	}
+
+	private const ulong HashSeed = 14695981039346656037UL;
+
+	/// <summary>
+	/// A fast hash whose results are stable between runs, so they can be cached to disk
+	/// </summary>
+	private static ulong Hash(ulong hash, ReadOnlySpan<byte> data)
+	{
+		var words = MemoryMarshal.Cast<byte, ulong>(data);
+		foreach (var word in words)
+			hash = BitOperations.RotateLeft(hash ^ word, 29) * 0x9E3779B97F4A7C15UL;
+		for (int i = words.Length * sizeof(ulong); i < data.Length; i++)
+			hash = (hash ^ data[i]) * 1099511628211UL;
+		return hash;
+	}
+
 	private struct PackingNode
 	{
 		public bool Used;
@@ -232,7 +385,7 @@ public class Packer
 		public unsafe PackingNode* Down;
 	};
 
-	public unsafe Output Pack()
+	public Output Pack()
 	{
 		Output result = new();
 
@@ -243,10 +396,59 @@ public class Packer
 		// sort the sources by size
 		sources.Sort((a, b) => b.Packed.Width * b.Packed.Height - a.Packed.Width * a.Packed.Height);
 
-		// make sure the largest isn't too large
-		if (sources[0].Packed.Width > MaxSize || sources[0].Packed.Height > MaxSize)
-			throw new Exception("Source image is larger than max atlas size");
+		// make sure the largest isn't too large, including the padding placed around it
+		var padding = Math.Max(0, Padding);
+		foreach (var source in sources)
+			if (!source.Empty && (source.Packed.Width + padding > MaxSize || source.Packed.Height + padding > MaxSize))
+				throw new Exception("Source image is larger than max atlas size");
+
+		if (Method == PackingMethod.Skyline)
+			PackSkyline(result);
+		else
+			PackTree(result);
+
+		// make sure duplicates have entries
+		if (CombineDuplicates)
+		{
+			var packed = new Dictionary<int, Entry>(result.Entries.Count);
+			foreach (var entry in result.Entries)
+				packed[entry.Index] = entry;
+
+			foreach (var source in sources)
+			{
+				if (source.DuplicateOf.HasValue && packed.TryGetValue(source.DuplicateOf.Value, out var entry))
+					result.Entries.Add(new(source.Index, source.Name, entry.Page, entry.Source, source.Frame));
+			}
+		}
+
+		return result;
+	}
+
+	/// <summary>
+	/// Packs the sources, or loads the result of the last time they were packed from a cache file.
+	/// The cache is only used if the source images, their names, and the Packer's settings are all unchanged,
+	/// and otherwise the sources are packed and the cache file is rewritten.
+	/// </summary>
+	public Output Pack(string cachePath)
+	{
+		var hash = GetContentHash();
+
+		if (File.Exists(cachePath) && TryReadCache(cachePath, hash, out var cached))
+			return cached;
+
+		var result = Pack();
+
+		var directory = Path.GetDirectoryName(cachePath);
+		if (!string.IsNullOrEmpty(directory))
+			Directory.CreateDirectory(directory);
+
+		using var stream = File.Create(cachePath);
+		WriteCache(stream, hash, result);
+		return result;
+	}
 
+	private unsafe void PackTree(Output result)
+	{
 		// TODO: why do we sometimes need more than source images * 3?
 		// for safety I've just made it 4 ... but it should really only be 3?
 
@@ -351,63 +553,12 @@ public class Packer
 					pageHeight = rootPtr->Rect.Height;
 				}
 
-				// create each page
-				{
-					var bmp = new Image(pageWidth, pageHeight);
-					result.Pages.Add(bmp);
-
-					// create each entry for this page and copy its image data
-					for (int i = from; i < packed; i++)
-					{
-						var source = sources[i];
-
-						// do not pack duplicate entries yet
-						if (source.DuplicateOf.HasValue)
-							continue;
-
-						result.Entries.Add(new(source.Index, source.Name, page, source.Packed, source.Frame));
-
-						if (source.Empty || source.BufferLength <= 0)
-							continue;
-
-						var data = sourceBuffer.AsSpan(source.BufferIndex, source.BufferLength);
-						bmp.CopyPixels(data, source.Packed.Width, source.Packed.Height, source.Packed.Position);
-
-						if (DuplicateEdges && padding >= 2)
-						{
-							var p = source.Packed;
-							bmp.CopyPixels(bmp, new RectInt(p.Position, new Point2(1, p.Height)), p.Position + new Point2(-1, 0)); // L
-							bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(p.Width - 1, 0), new Point2(1, p.Height)), p.Position + new Point2(p.Width, 0)); // R
-							bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(-1, 0), new Point2(p.Width + 2, 1)), p.Position + new Point2(-1, -1)); // T
-							bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(-1, p.Height - 1), new Point2(p.Width + 2, 1)), p.Position + new Point2(-1, p.Height)); // B
-						}
-					}
-				}
-
+				CreatePage(result, page, pageWidth, pageHeight, sources, from, packed);
 				page++;
 			}
 
 		}
 
-		// make sure duplicates have entries
-		if (CombineDuplicates)
-		{
-			foreach (var source in sources)
-			{
-				if (!source.DuplicateOf.HasValue)
-					continue;
-
-				foreach (var entry in result.Entries)
-					if (entry.Index == source.DuplicateOf.Value)
-					{
-						result.Entries.Add(new(source.Index, source.Name, entry.Page, entry.Source, source.Frame));
-						break;
-					}
-			}
-		}
-
-		return result;
-
 		static unsafe PackingNode* FindNode(PackingNode* root, int w, int h)
 		{
 			if (root->Used)
@@ -433,12 +584,283 @@ public class Packer
 		}
 	}
 
+	private void PackSkyline(Output result)
+	{
+		var padding = Math.Max(0, Padding);
+		var halfPadding = padding / 2;
+
+		// place the tallest first, as later (shorter) entries can fill in around them
+		var pending = new List<int>(sources.Count);
+		var empty = new List<int>();
+		long area = 0;
+		int largest = 0;
+
+		for (int i = 0; i < sources.Count; i++)
+		{
+			var source = sources[i];
+			if (source.Empty)
+				empty.Add(i);
+			else if (!source.DuplicateOf.HasValue)
+			{
+				pending.Add(i);
+				area += (long)(source.Packed.Width + padding) * (source.Packed.Height + padding);
+				largest = Math.Max(largest, source.Packed.Width + padding);
+			}
+		}
+
+		pending.Sort((a, b) =>
+		{
+			var diff = sources[b].Packed.Height - sources[a].Packed.Height;
+			return diff != 0 ? diff : sources[b].Packed.Width - sources[a].Packed.Width;
+		});
+
+		// aim for a square page, which is then trimmed to what was actually used
+		var width = Math.Max(largest, (int)Math.Ceiling(Math.Sqrt(area)));
+		if (PowerOfTwo)
+			width = (int)BitOperations.RoundUpToPowerOf2((uint)width);
+		width = Math.Min(width, MaxSize);
+
+		// the order sources are placed in, with each page's sources kept together
+		var ordered = new List<Source>(sources.Count);
+		var skyline = new List<Point2>();
+		var remaining = new List<int>();
+		int page = 0;
+
+		while (pending.Count > 0)
+		{
+			int from = ordered.Count, usedWidth = 0, usedHeight = 0;
+
+			// each point is the start of a segment of the skyline, which runs up to the next one
+			skyline.Clear();
+			skyline.Add(new(0, 0));
+			remaining.Clear();
+
+			foreach (var index in pending)
+			{
+				var it = sources[index];
+				int w = it.Packed.Width + padding;
+				int h = it.Packed.Height + padding;
+
+				// find the lowest position, preferring the left-most
+				int bestSegment = -1, bestX = 0, bestY = int.MaxValue;
+				for (int i = 0; i < skyline.Count; i++)
+				{
+					int x = skyline[i].X;
+					if (x + w > width)
+						break;
+
+					int y = 0;
+					for (int j = i; j < skyline.Count && skyline[j].X < x + w; j++)
+						y = Math.Max(y, skyline[j].Y);
+
+					if (y + h <= MaxSize && y < bestY)
+					{
+						bestSegment = i;
+						bestX = x;
+						bestY = y;
+					}
+				}
+
+				// doesn't fit in this page
+				if (bestSegment < 0)
+				{
+					remaining.Add(index);
+					continue;
+				}
+
+				// raise the skyline beneath the entry
+				int end = bestX + w;
+				int last = bestSegment;
+				while (last + 1 < skyline.Count && skyline[last + 1].X <= end)
+					last++;
+
+				var after = skyline[last].Y;
+				skyline.RemoveRange(bestSegment, last - bestSegment + 1);
+				skyline.Insert(bestSegment, new(bestX, bestY + h));
+				if (end < width && (bestSegment + 1 >= skyline.Count || skyline[bestSegment + 1].X > end))
+					skyline.Insert(bestSegment + 1, new(end, after));
+
+				it.Packed.X = bestX + halfPadding;
+				it.Packed.Y = bestY + halfPadding;
+				ordered.Add(it);
+
+				usedWidth = Math.Max(usedWidth, end);
+				usedHeight = Math.Max(usedHeight, bestY + h);
+			}
+
+			// every source fits an empty page, so this would otherwise make empty pages forever
+			if (ordered.Count == from)
+				throw new Exception("Source image is larger than max atlas size");
+
+			(pending, remaining) = (remaining, pending);
+
+			// empty sources are given entries on the last page, same as the Tree method
+			if (pending.Count <= 0)
+				foreach (var index in empty)
+					ordered.Add(sources[index]);
+
+			var to = ordered.Count;
+
+			if (PowerOfTwo)
+			{
+				usedWidth = (int)BitOperations.RoundUpToPowerOf2((uint)Math.Max(2, usedWidth));
+				usedHeight = (int)BitOperations.RoundUpToPowerOf2((uint)Math.Max(2, usedHeight));
+			}
+
+			CreatePage(result, page, usedWidth, usedHeight, ordered, from, to);
+			page++;
+		}
+	}
+
+	/// <summary>
+	/// Creates a page holding the sources in the given range, and adds their entries
+	/// </summary>
+	private void CreatePage(Output result, int page, int pageWidth, int pageHeight, List<Source> pageSources, int from, int to)
+	{
+		var padding = Math.Max(0, Padding);
+		var bmp = new Image(pageWidth, pageHeight);
+		result.Pages.Add(bmp);
+
+		// create each entry for this page and copy its image data
+		for (int i = from; i < to; i++)
+		{
+			var source = pageSources[i];
+
+			// do not pack duplicate entries yet
+			if (source.DuplicateOf.HasValue)
+				continue;
+
+			result.Entries.Add(new(source.Index, source.Name, page, source.Packed, source.Frame));
+
+			if (source.Empty || source.BufferLength <= 0)
+				continue;
+
+			var data = sourceBuffer.AsSpan(source.BufferIndex, source.BufferLength);
+			bmp.CopyPixels(data, source.Packed.Width, source.Packed.Height, source.Packed.Position);
+
+			if (DuplicateEdges && padding >= 2)
+			{
+				var p = source.Packed;
+				bmp.CopyPixels(bmp, new RectInt(p.Position, new Point2(1, p.Height)), p.Position + new Point2(-1, 0)); // L
+				bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(p.Width - 1, 0), new Point2(1, p.Height)), p.Position + new Point2(p.Width, 0)); // R
+				bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(-1, 0), new Point2(p.Width + 2, 1)), p.Position + new Point2(-1, -1)); // T
+				bmp.CopyPixels(bmp, new RectInt(p.Position + new Point2(-1, p.Height - 1), new Point2(p.Width + 2, 1)), p.Position + new Point2(-1, p.Height)); // B
+			}
+		}
+	}
+
+	private const int CacheMagic = 0x4B415046; // "FPAK"
+	private const int CacheVersion = 1;
+
+	/// <summary>
+	/// Hashes everything that affects the packed output
+	/// </summary>
+	private ulong GetContentHash()
+	{
+		var hash = HashSeed;
+		Span<int> settings = [CacheVersion, Trim ? 1 : 0, MaxSize, Padding, DuplicateEdges ? 1 : 0, PowerOfTwo ? 1 : 0, CombineDuplicates ? 1 : 0, (int)Method];
+		hash = Hash(hash, MemoryMarshal.AsBytes(settings));
+
+		// sources are reordered when packing, so hash them in the order they were added
+		var ordered = sources.ToArray();
+		Array.Sort(ordered, (a, b) => a.Index != b.Index ? a.Index - b.Index : string.CompareOrdinal(a.Name, b.Name));
+
+		foreach (var source in ordered)
+		{
+			var pixels = source.DuplicateOf.HasValue || source.BufferLength <= 0 ? 0 :
+				Hash(HashSeed, MemoryMarshal.AsBytes(sourceBuffer.AsSpan(source.BufferIndex, source.BufferLength)));
+
+			Span<int> values = [source.Index, source.DuplicateOf ?? -1, source.Packed.Width, source.Packed.Height,
+				source.Frame.X, source.Frame.Y, source.Frame.Width, source.Frame.Height];
+			hash = Hash(hash, MemoryMarshal.AsBytes(values));
+			hash = Hash(hash, MemoryMarshal.AsBytes(new ReadOnlySpan<ulong>(in pixels)));
+			hash = Hash(hash, MemoryMarshal.AsBytes(source.Name.AsSpan()));
+		}
+
+		return hash;
+	}
+
+	private static void WriteCache(Stream stream, ulong hash, in Output output)
+	{
+		using var writer = new BinaryWriter(stream);
+		writer.Write(CacheMagic);
+		writer.Write(CacheVersion);
+		writer.Write(hash);
+
+		writer.Write(output.Pages.Count);
+		using var encoded = new MemoryStream();
+		foreach (var page in output.Pages)
+		{
+			encoded.SetLength(0);
+			page.WriteQoi(encoded);
+			writer.Write((int)encoded.Length);
+			writer.Write(encoded.GetBuffer(), 0, (int)encoded.Length);
+		}
+
+		writer.Write(output.Entries.Count);
+		foreach (var entry in output.Entries)
+		{
+			writer.Write(entry.Index);
+			writer.Write(entry.Name);
+			writer.Write(entry.Page);
+			WriteRect(writer, entry.Source);
+			WriteRect(writer, entry.Frame);
+		}
+
+		static void WriteRect(BinaryWriter writer, in RectInt rect)
+		{
+			writer.Write(rect.X);
+			writer.Write(rect.Y);
+			writer.Write(rect.Width);
+			writer.Write(rect.Height);
+		}
+	}
+
+	private static bool TryReadCache(string path, ulong hash, out Output output)
+	{
+		output = new();
+
+		try
+		{
+			using var reader = new BinaryReader(File.OpenRead(path));
+			if (reader.ReadInt32() != CacheMagic || reader.ReadInt32() != CacheVersion || reader.ReadUInt64() != hash)
+				return false;
+
+			var pageCount = reader.ReadInt32();
+			for (int i = 0; i < pageCount; i++)
+			{
+				var length = reader.ReadInt32();
+				using var encoded = new MemoryStream(reader.ReadBytes(length));
+				output.Pages.Add(new Image(encoded));
+			}
+
+			var entryCount = reader.ReadInt32();
+			for (int i = 0; i < entryCount; i++)
+				output.Entries.Add(new(reader.ReadInt32(), reader.ReadString(), reader.ReadInt32(), ReadRect(reader), ReadRect(reader)));
+
+			return true;
+		}
+		catch (Exception e)
+		{
+			// a cache that can't be read is just packed again
+			Log.Warning($"Failed to read Packer cache '{path}': {e.Message}");
+			foreach (var page in output.Pages)
+				page.Dispose();
+			output = new();
+			return false;
+		}
+
+		static RectInt ReadRect(BinaryReader reader)
+			=> new(reader.ReadInt32(), reader.ReadInt32(), reader.ReadInt32(), reader.ReadInt32());
+	}
+
 	/// <summary>
 	/// Removes all source data and removes the Packed Output
 	/// </summary>
 	public void Clear()
 	{
 		sources.Clear();
+		hashes.Clear();
 		sourceBufferIndex = 0;
 	}
 }
@@ -14,6 +14,7 @@ internal static partial class Platform
 		Vsync = 1 << 1,
 		Resizable = 1 << 2,
 		MouseVisible = 1 << 3,
+		VsyncAdaptive = 1 << 4,
 	}
 
 	public enum FosterEventType : int
@@ -142,6 +143,20 @@ internal static partial class Platform
 		public int indexStart;
 		public int indexCount;
 		public int instanceCount;
+		public int instanceStart;
+		public DepthCompare compare;
+		public int depthMask;
+		public CullMode cull;
+		public BlendMode blend;
+		public nint pipeline;
+	}
+
+	[StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+	public struct FosterPipelineData
+	{
+		public nint shader;
+		public FosterVertexFormat vertexFormat;
+		public FosterVertexFormat instanceFormat;
 		public DepthCompare compare;
 		public int depthMask;
 		public CullMode cull;
@@ -159,6 +174,27 @@ internal static partial class Platform
 		public ClearMask mask;
 	}
 
+	[StructLayout(LayoutKind.Sequential)]
+	public struct FosterFrameStats
+	{
+		public int drawCalls;
+		public int stateChanges;
+		public int stateChangesSkipped;
+		public int textureBinds;
+		public long bufferBytesUploaded;
+		public long textureBytesUploaded;
+		public double gpuTime;
+		public int gpuScopeCount;
+	}
+
+	[StructLayout(LayoutKind.Sequential)]
+	public struct FosterGpuScope
+	{
+		public nint name;
+		public int depth;
+		public double time;
+	}
+
 	public static unsafe string ParseUTF8(nint s)
 	{
 		if (s == 0)
@@ -213,8 +249,26 @@ internal static partial class Platform
 	[LibraryImport(DLL)]
 	public static partial byte FosterPollEvents(out FosterEvent fosterEvent);
 	[LibraryImport(DLL)]
+	public static unsafe partial int FosterPollEventsBatch(FosterEvent* output, int capacity);
+	[LibraryImport(DLL)]
 	public static partial void FosterEndFrame();
 	[LibraryImport(DLL)]
+	public static partial void FosterGetFrameStats(out FosterFrameStats stats);
+	[LibraryImport(DLL, StringMarshalling = StringMarshalling.Utf8)]
+	public static partial void FosterGpuScopeBegin(string name);
+	[LibraryImport(DLL)]
+	public static partial void FosterGpuScopeEnd();
+	[LibraryImport(DLL)]
+	public static unsafe partial int FosterGetGpuScopes(FosterGpuScope* output, int max);
+	[LibraryImport(DLL)]
+	public static partial byte FosterTraceEnabled();
+	[LibraryImport(DLL, StringMarshalling = StringMarshalling.Utf8)]
+	public static partial void FosterTraceBegin(string name);
+	[LibraryImport(DLL)]
+	public static partial void FosterTraceEnd();
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterTraceFlush(delegate* unmanaged<nint, nint, int, void> func, IntPtr context);
+	[LibraryImport(DLL)]
 	public static partial void FosterShutdown();
 	[LibraryImport(DLL)]
 	public static partial byte FosterIsRunning();
@@ -233,6 +287,10 @@ internal static partial class Platform
 	[LibraryImport(DLL)]
 	public static partial void FosterSetCentered();
 	[LibraryImport(DLL)]
+	public static partial void FosterSetMaxQueuedFrames(int count);
+	[LibraryImport(DLL)]
+	public static partial void FosterSleep(double seconds);
+	[LibraryImport(DLL)]
 	public static partial nint FosterGetUserPath();
 	[LibraryImport(DLL, StringMarshalling = StringMarshalling.Utf8)]
 	public static partial void FosterSetClipboard(string ptr);
@@ -245,6 +303,8 @@ internal static partial class Platform
 	[LibraryImport(DLL)]
 	public static partial void FosterImageFree(nint data);
 	[LibraryImport(DLL)]
+	public static unsafe partial void FosterImageLoadMany(nint* memory, int* lengths, int count, nint* outputs, int* widths, int* heights);
+	[LibraryImport(DLL)]
 	public static unsafe partial byte FosterImageWrite(delegate* unmanaged<nint, nint, int, void> func, IntPtr context, ImageWriteFormat format, int w, int h, IntPtr data);
 	[LibraryImport(DLL)]
 	public static partial nint FosterFontInit(nint data, int length);
@@ -261,16 +321,48 @@ internal static partial class Platform
 	[LibraryImport(DLL)]
 	public static partial void FosterFontGetPixels(nint font, nint dest, int glyph, int width, int height, float scale);
 	[LibraryImport(DLL)]
+	public static partial nint FosterFontGetSDF(nint font, int glyph, float scale, int padding, byte onEdgeValue, float pixelDistScale, out int width, out int height, out int offsetX, out int offsetY);
+	[LibraryImport(DLL)]
+	public static partial void FosterFontFreeSDF(nint data);
+	[LibraryImport(DLL)]
 	public static partial void FosterFontFree(nint font);
 	[LibraryImport(DLL)]
 	public static partial Renderers FosterGetRenderer();
 	[LibraryImport(DLL)]
 	public static partial nint FosterTextureCreate(int width, int height, TextureFormat format);
 	[LibraryImport(DLL)]
+	public static partial byte FosterTextureFormatSupported(TextureFormat format);
+	[LibraryImport(DLL)]
 	public static unsafe partial void FosterTextureSetData(nint texture, void* data, int length);
 	[LibraryImport(DLL)]
+	public static partial nint FosterTextureCreateArray(int width, int height, int layers, TextureFormat format);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterTextureSetLayerData(nint texture, int layer, void* data, int length);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterTextureSetLevelData(nint texture, int level, void* data, int length);
+	[LibraryImport(DLL)]
+	public static partial void FosterTextureGenerateMipmaps(nint texture);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterTextureSetSubData(nint texture, FosterRect rect, void* data, int length);
+	[LibraryImport(DLL)]
+	public static partial nint FosterTextureUploadBegin(nint texture, FosterRect rect);
+	[LibraryImport(DLL)]
+	public static partial nint FosterTextureUploadGetData(nint upload);
+	[LibraryImport(DLL)]
+	public static partial void FosterTextureUploadSubmit(nint upload);
+	[LibraryImport(DLL)]
+	public static partial void FosterTextureUploadCancel(nint upload);
+	[LibraryImport(DLL)]
 	public static unsafe partial void FosterTextureGetData(nint texture, void* data, int length);
 	[LibraryImport(DLL)]
+	public static partial nint FosterTextureReadAsync(nint texture, FosterRect rect);
+	[LibraryImport(DLL)]
+	public static partial byte FosterReadbackPoll(nint readback);
+	[LibraryImport(DLL)]
+	public static unsafe partial byte FosterReadbackGet(nint readback, void* data, int length);
+	[LibraryImport(DLL)]
+	public static partial void FosterReadbackDestroy(nint readback);
+	[LibraryImport(DLL)]
 	public static partial void FosterTextureDestroy(nint texture);
 	[LibraryImport(DLL)]
 	public static partial nint FosterTargetCreate(int width, int height, TextureFormat[] formats, int formatCount);
@@ -278,8 +370,20 @@ internal static partial class Platform
 	public static partial nint FosterTargetGetAttachment(nint target, int index);
 	[LibraryImport(DLL)]
 	public static partial void FosterTargetDestroy(nint target);
+	[LibraryImport(DLL)]
+	public static partial nint FosterTargetAcquire(int width, int height, TextureFormat[] formats, int formatCount);
+	[LibraryImport(DLL)]
+	public static partial void FosterTargetRelease(nint target);
+	[LibraryImport(DLL)]
+	public static partial void FosterTargetDiscard(nint target);
 	[DllImport(DLL)]
 	public static extern nint FosterShaderCreate(ref FosterShaderData data);
+	[DllImport(DLL)]
+	public static extern nint FosterShaderCreateAsync(ref FosterShaderData data);
+	[LibraryImport(DLL)]
+	public static partial byte FosterShaderIsReady(nint shader);
+	[LibraryImport(DLL)]
+	public static partial byte FosterShaderWait(nint shader);
 	[LibraryImport(DLL)]
 	public static unsafe partial void FosterShaderGetUniforms(IntPtr shader, FosterUniformInfo* output, out int count, int max);
 	[LibraryImport(DLL)]
@@ -291,21 +395,93 @@ internal static partial class Platform
 	[LibraryImport(DLL)]
 	public static partial void FosterShaderDestroy(IntPtr shader);
 	[LibraryImport(DLL)]
+	public static partial void FosterShaderSetUniformBuffer(IntPtr shader, int index, IntPtr buffer);
+	[LibraryImport(DLL)]
+	public static partial IntPtr FosterUniformBufferCreate(int size);
+	[LibraryImport(DLL)]
+	public static partial void FosterUniformBufferSetData(IntPtr buffer, IntPtr data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterUniformBufferDestroy(IntPtr buffer);
+	[LibraryImport(DLL)]
 	public static partial nint FosterMeshCreate();
 	[LibraryImport(DLL)]
+	public static partial nint FosterMeshCreateStreaming();
+	[LibraryImport(DLL)]
 	public static partial void FosterMeshSetVertexFormat(nint mesh, ref FosterVertexFormat format);
 	[LibraryImport(DLL)]
 	public static partial void FosterMeshSetVertexData(nint mesh, nint data, int dataSize, int dataDestOffset);
 	[LibraryImport(DLL)]
+	public static partial nint FosterMeshMapVertexData(nint mesh, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterMeshUnmapVertexData(nint mesh);
+	[LibraryImport(DLL)]
+	public static partial void FosterMeshSetInstanceFormat(nint mesh, ref FosterVertexFormat format);
+	[LibraryImport(DLL)]
+	public static partial void FosterMeshSetInstanceData(nint mesh, nint data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
 	public static partial void FosterMeshSetIndexFormat(nint mesh, IndexFormat format);
 	[LibraryImport(DLL)]
 	public static partial void FosterMeshSetIndexData(nint mesh, nint data, int dataSize, int dataDestOffset);
 	[LibraryImport(DLL)]
+	public static partial nint FosterMeshMapIndexData(nint mesh, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterMeshUnmapIndexData(nint mesh);
+	[LibraryImport(DLL)]
+	public static partial void FosterMeshSetQuadIndices(nint mesh, int quadCount);
+	[LibraryImport(DLL)]
 	public static partial void FosterMeshDestroy(nint mesh);
 	[LibraryImport(DLL)]
+	public static partial nint FosterPipelineCreate(ref FosterPipelineData data);
+	[LibraryImport(DLL)]
+	public static partial void FosterPipelineDestroy(nint pipeline);
+	[LibraryImport(DLL)]
 	public static unsafe partial void FosterDraw(FosterDrawCommand* command);
 	[LibraryImport(DLL)]
+	public static unsafe partial void FosterDrawBatch(FosterDrawCommand* commands, int count);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterDrawList(FosterDrawCommand* command, DrawRange* ranges, int rangeCount);
+	[LibraryImport(DLL)]
 	public static unsafe partial void FosterClear(FosterClearCommand* command);
+	[LibraryImport(DLL)]
+	public static partial nint FosterCommandListCreate();
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListReset(nint list);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListDestroy(nint list);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListShaderSetUniform(nint list, IntPtr shader, int index, float* values, int count);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListShaderSetTexture(nint list, IntPtr shader, int index, IntPtr* values, int count);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListShaderSetSampler(nint list, IntPtr shader, int index, TextureSampler* values, int count);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListShaderSetUniformBuffer(nint list, IntPtr shader, int index, IntPtr buffer);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListUniformBufferSetData(nint list, IntPtr buffer, IntPtr data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetVertexFormat(nint list, nint mesh, ref FosterVertexFormat format);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetVertexData(nint list, nint mesh, nint data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetInstanceFormat(nint list, nint mesh, ref FosterVertexFormat format);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetInstanceData(nint list, nint mesh, nint data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetIndexFormat(nint list, nint mesh, IndexFormat format);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetIndexData(nint list, nint mesh, nint data, int dataSize, int dataDestOffset);
+	[LibraryImport(DLL)]
+	public static partial void FosterCommandListMeshSetQuadIndices(nint list, nint mesh, int quadCount);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListDraw(nint list, FosterDrawCommand* command);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListDrawBatch(nint list, FosterDrawCommand* commands, int count);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListDrawList(nint list, FosterDrawCommand* command, DrawRange* ranges, int rangeCount);
+	[LibraryImport(DLL)]
+	public static unsafe partial void FosterCommandListClear(nint list, FosterClearCommand* clear);
+	[LibraryImport(DLL)]
+	public static partial void FosterExecuteCommandList(nint list);
 
 	// Non-Foster Calls:
 
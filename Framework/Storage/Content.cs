@@ -47,6 +47,16 @@ public abstract class Content
 		return buffer;
 	}
 
+	/// <summary>
+	/// Maps the File in the Content at the given path into memory, so it can be passed to the Platform
+	/// without copying it. By default this reads the whole File, unless the Content can memory-map it.
+	/// </summary>
+	public virtual MappedFile Map(string path)
+	{
+		using var stream = OpenRead(path);
+		return new MappedFile(stream);
+	}
+
 	/// <summary>
 	/// Reads all the contents of the File in the Content at the given path and returns it as a string.
 	/// </summary>
@@ -35,6 +35,9 @@ public class ContentStorage(string contentPath, bool writable) : Content
 	public override Stream OpenRead(string path)
 		=> File.OpenRead(Path.Combine(ContentPath, path));
 
+	public override MappedFile Map(string path)
+		=> new(Path.Combine(ContentPath, path));
+
 	public override void CreateDirectory(string path)
 		=> Directory.CreateDirectory(Path.Combine(ContentPath, path));
 
@@ -0,0 +1,128 @@
+using System.IO.MemoryMappedFiles;
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// A read-only view of a File's contents in memory, which can be passed directly to the
+/// Platform without copying it. Files are memory-mapped, so only the parts that are actually
+/// read are loaded from disk. The memory is valid until the MappedFile is disposed.
+/// </summary>
+public sealed unsafe class MappedFile : IDisposable
+{
+	/// <summary>
+	/// Pointer to the start of the File's contents, or 0 if it's empty
+	/// </summary>
+	public nint Pointer { get; private set; }
+
+	/// <summary>
+	/// The length of the File's contents, in bytes
+	/// </summary>
+	public readonly long Length;
+
+	/// <summary>
+	/// The File's contents
+	/// </summary>
+	public ReadOnlySpan<byte> Span
+	{
+		get
+		{
+			if (IsDisposed)
+				throw new ObjectDisposedException(nameof(MappedFile));
+			return new((void*)Pointer, checked((int)Length));
+		}
+	}
+
+	/// <summary>
+	/// If the MappedFile has been disposed, after which its memory is no longer valid
+	/// </summary>
+	public bool IsDisposed { get; private set; }
+
+	private readonly MemoryMappedFile? file;
+	private readonly MemoryMappedViewAccessor? view;
+	private readonly bool native;
+
+	/// <summary>
+	/// Memory-maps the File at the given path
+	/// </summary>
+	public MappedFile(string path)
+	{
+		Length = new FileInfo(path).Length;
+
+		// empty files can't be mapped, but also have nothing to map
+		if (Length <= 0)
+			return;
+
+		file = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+		view = file.CreateViewAccessor(0, Length, MemoryMappedFileAccess.Read);
+
+		byte* ptr = null;
+		view.SafeMemoryMappedViewHandle.AcquirePointer(ref ptr);
+		Pointer = (nint)(ptr + view.PointerOffset);
+	}
+
+	/// <summary>
+	/// Reads the rest of the Stream into unmanaged memory.
+	/// This is used for Streams that aren't backed by a File which could be mapped.
+	/// </summary>
+	public MappedFile(Stream stream)
+	{
+		Length = stream.Length - stream.Position;
+		if (Length <= 0)
+			return;
+
+		Pointer = (nint)NativeMemory.Alloc((nuint)Length);
+		native = true;
+		stream.ReadExactly(new Span<byte>((void*)Pointer, checked((int)Length)));
+	}
+
+	~MappedFile() => Dispose(false);
+
+	/// <summary>
+	/// Creates a Stream reading a range of the File's contents, without copying it
+	/// </summary>
+	public Stream CreateStream(long offset, long length)
+	{
+		if (IsDisposed)
+			throw new ObjectDisposedException(nameof(MappedFile));
+		if (offset < 0 || length < 0 || offset + length > Length)
+			throw new ArgumentOutOfRangeException(nameof(offset));
+		return new UnmanagedMemoryStream((byte*)Pointer + offset, length);
+	}
+
+	/// <summary>
+	/// Creates a Stream reading the File's contents, without copying it
+	/// </summary>
+	public Stream CreateStream()
+		=> CreateStream(0, Length);
+
+	public void Dispose()
+	{
+		Dispose(true);
+		GC.SuppressFinalize(this);
+	}
+
+	private void Dispose(bool disposing)
+	{
+		if (IsDisposed)
+			return;
+		IsDisposed = true;
+
+		// the view's handle is a critical finalizer, so it's still valid to release from our own finalizer
+		if (native)
+		{
+			NativeMemory.Free((void*)Pointer);
+		}
+		else if (view != null)
+		{
+			view.SafeMemoryMappedViewHandle.ReleasePointer();
+			if (disposing)
+			{
+				view.Dispose();
+				file?.Dispose();
+			}
+		}
+
+		Pointer = 0;
+	}
+}
@@ -0,0 +1,83 @@
+using System.Runtime.InteropServices;
+
+namespace Foster.Framework;
+
+/// <summary>
+/// Tracing zones, recorded alongside the Platform's own zones.
+/// These are only recorded when the Platform library is built with the
+/// FOSTER_TRACE CMake option, and otherwise do nothing.
+/// </summary>
+public static class Tracing
+{
+	/// <summary>
+	/// If the Platform library records tracing zones
+	/// </summary>
+	public static readonly bool Enabled = Platform.FosterTraceEnabled() != 0;
+
+	/// <summary>
+	/// Begins a tracing zone on the current thread, which can be nested
+	/// </summary>
+	public static void Begin(string name)
+	{
+		if (Enabled)
+			Platform.FosterTraceBegin(name);
+	}
+
+	/// <summary>
+	/// Ends the most recent tracing zone begun on the current thread
+	/// </summary>
+	public static void End()
+	{
+		if (Enabled)
+			Platform.FosterTraceEnd();
+	}
+
+	/// <summary>
+	/// Begins a tracing zone that ends when the returned value is disposed
+	/// </summary>
+	public static Zone Scope(string name)
+	{
+		Begin(name);
+		return new Zone();
+	}
+
+	/// <summary>
+	/// Writes the zones recorded since the last time this was called to
+	/// a Chrome Trace JSON file, which can be opened in Perfetto or chrome://tracing.
+	/// Does nothing when the Platform records to Tracy instead.
+	/// </summary>
+	public static void Write(string path)
+	{
+		using var stream = File.Create(path);
+		Write(stream);
+	}
+
+	/// <summary>
+	/// Writes the zones recorded since the last time this was called as Chrome Trace JSON
+	/// </summary>
+	public static unsafe void Write(Stream stream)
+	{
+		if (!Enabled)
+			return;
+
+		[UnmanagedCallersOnly]
+		static unsafe void Write(IntPtr context, IntPtr data, int size)
+		{
+			var stream = GCHandle.FromIntPtr(context).Target as Stream;
+			var ptr = (byte*)data.ToPointer();
+			stream?.Write(new ReadOnlySpan<byte>(ptr, size));
+		}
+
+		GCHandle handle = GCHandle.Alloc(stream);
+		Platform.FosterTraceFlush(&Write, GCHandle.ToIntPtr(handle));
+		handle.Free();
+	}
+
+	/// <summary>
+	/// A tracing zone begun with <see cref="Scope(string)"/>
+	/// </summary>
+	public readonly struct Zone : IDisposable
+	{
+		public void Dispose() => End();
+	}
+}
@@ -0,0 +1,347 @@
+#include "foster_platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Benchmarks the Platform's hot paths directly, without the C# Framework on top.
+// Results are written as JSON, to stdout or the file given with --output, so they
+// can be compared across releases. Run with --headless to skip the benchmarks that
+// need a window and renderer.
+
+#define BENCH_MAX_RESULTS 32
+#define BENCH_IMAGE_SIZE 512
+#define BENCH_DRAW_COUNT 10000
+
+typedef struct BenchResult
+{
+	const char* name;
+	int operations;
+	int iterations;
+	double mean;
+	double median;
+	double min;
+	double max;
+} BenchResult;
+
+typedef struct BenchBuffer
+{
+	unsigned char* data;
+	int length;
+	int capacity;
+} BenchBuffer;
+
+typedef void (*BenchFn)(void* context);
+
+BenchResult benchResults[BENCH_MAX_RESULTS];
+int benchResultCount = 0;
+int benchIterations = 50;
+FosterRenderers benchRenderer = FOSTER_RENDERER_NONE;
+const char* benchFilter = NULL;
+
+double BenchNow()
+{
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (double)counter.QuadPart * 1000.0 / (double)frequency.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+#endif
+}
+
+int BenchCompare(const void* a, const void* b)
+{
+	double x = *(const double*)a;
+	double y = *(const double*)b;
+	return (x > y) - (x < y);
+}
+
+void BenchRun(const char* name, int operations, BenchFn fn, void* context)
+{
+	if (benchFilter != NULL && strstr(name, benchFilter) == NULL)
+		return;
+	if (benchResultCount >= BENCH_MAX_RESULTS)
+		return;
+
+	double* samples = (double*)malloc(sizeof(double) * benchIterations);
+	if (samples == NULL)
+		return;
+
+	// warm up caches and any lazily created state first
+	for (int i = 0; i < 3; i ++)
+		fn(context);
+
+	for (int i = 0; i < benchIterations; i ++)
+	{
+		double start = BenchNow();
+		fn(context);
+		samples[i] = BenchNow() - start;
+	}
+
+	qsort(samples, benchIterations, sizeof(double), BenchCompare);
+
+	BenchResult* result = &benchResults[benchResultCount++];
+	result->name = name;
+	result->operations = operations;
+	result->iterations = benchIterations;
+	result->min = samples[0];
+	result->max = samples[benchIterations - 1];
+	result->median = samples[benchIterations / 2];
+	result->mean = 0;
+	for (int i = 0; i < benchIterations; i ++)
+		result->mean += samples[i];
+	result->mean /= benchIterations;
+
+	fprintf(stderr, "%-32s %10.3f ms (median %.3f ms)\n", name, result->mean, result->median);
+	free(samples);
+}
+
+void BenchWriteResults(FILE* out)
+{
+	fprintf(out, "{\n");
+	fprintf(out, "\t\"suite\": \"FosterPlatform\",\n");
+	fprintf(out, "\t\"renderer\": %d,\n", (int)benchRenderer);
+	fprintf(out, "\t\"results\": [\n");
+	for (int i = 0; i < benchResultCount; i ++)
+	{
+		BenchResult* it = &benchResults[i];
+		fprintf(out, "\t\t{ \"name\": \"%s\", \"operations\": %d, \"iterations\": %d, "
+			"\"meanMs\": %.6f, \"medianMs\": %.6f, \"minMs\": %.6f, \"maxMs\": %.6f, \"opsPerSecond\": %.1f }%s\n",
+			it->name, it->operations, it->iterations,
+			it->mean, it->median, it->min, it->max,
+			it->mean > 0 ? it->operations * 1000.0 / it->mean : 0.0,
+			i < benchResultCount - 1 ? "," : "");
+	}
+	fprintf(out, "\t]\n");
+	fprintf(out, "}\n");
+}
+
+void FOSTER_CALL BenchBufferWrite(void* context, void* data, int size)
+{
+	BenchBuffer* buffer = (BenchBuffer*)context;
+	if (buffer->length + size > buffer->capacity)
+	{
+		int capacity = buffer->capacity > 0 ? buffer->capacity : 1024;
+		while (capacity < buffer->length + size)
+			capacity *= 2;
+		unsigned char* resized = (unsigned char*)realloc(buffer->data, capacity);
+		if (resized == NULL)
+			return;
+		buffer->data = resized;
+		buffer->capacity = capacity;
+	}
+	memcpy(buffer->data + buffer->length, data, size);
+	buffer->length += size;
+}
+
+// Noisy gradient, so the encoders can't collapse the whole image into a few runs
+void BenchCreatePixels(FosterColor* pixels, int w, int h)
+{
+	unsigned int seed = 1234;
+	for (int y = 0; y < h; y ++)
+	for (int x = 0; x < w; x ++)
+	{
+		seed = seed * 1103515245u + 12345u;
+		FosterColor* it = &pixels[x + y * w];
+		it->r = (unsigned char)(x * 255 / w);
+		it->g = (unsigned char)(y * 255 / h);
+		it->b = (unsigned char)((seed >> 16) & 0x3f);
+		it->a = 255;
+	}
+}
+
+void BenchImageLoad(void* context)
+{
+	BenchBuffer* buffer = (BenchBuffer*)context;
+	int w, h;
+	unsigned char* pixels = FosterImageLoad(buffer->data, buffer->length, &w, &h);
+	if (pixels != NULL)
+		FosterImageFree(pixels);
+}
+
+typedef struct BenchDraw
+{
+	FosterShader* shader;
+	FosterMesh* mesh;
+	FosterTarget* target;
+} BenchDraw;
+
+void BenchDrawCommands(void* context)
+{
+	BenchDraw* state = (BenchDraw*)context;
+
+	FosterDrawCommand command;
+	memset(&command, 0, sizeof(command));
+	command.target = state->target;
+	command.mesh = state->mesh;
+	command.shader = state->shader;
+	command.indexCount = 6;
+	command.compare = FOSTER_COMPARE_NONE;
+	command.cull = FOSTER_CULL_NONE;
+	command.blend.colorOp = FOSTER_BLEND_OP_ADD;
+	command.blend.colorSrc = FOSTER_BLEND_FACTOR_One;
+	command.blend.colorDst = FOSTER_BLEND_FACTOR_OneMinusSrcAlpha;
+	command.blend.alphaOp = FOSTER_BLEND_OP_ADD;
+	command.blend.alphaSrc = FOSTER_BLEND_FACTOR_One;
+	command.blend.alphaDst = FOSTER_BLEND_FACTOR_OneMinusSrcAlpha;
+	command.blend.mask = FOSTER_BLEND_MASK_R | FOSTER_BLEND_MASK_G | FOSTER_BLEND_MASK_B | FOSTER_BLEND_MASK_A;
+	command.blend.rgba = 0xffffffff;
+
+	for (int i = 0; i < BENCH_DRAW_COUNT; i ++)
+	{
+		// alternate the scissor so consecutive draws can't be merged into one
+		command.hasScissor = i & 1;
+		command.scissor.w = 64;
+		command.scissor.h = 64;
+		FosterDraw(&command);
+	}
+
+	// make sure the draws actually reach the GPU as part of the measured time
+	FosterEndFrame();
+	FosterBeginFrame();
+}
+
+void BenchRenderer()
+{
+	// the shaders here are GLSL, so only the OpenGL renderer can run these
+	benchRenderer = FosterGetRenderer();
+	if (benchRenderer != FOSTER_RENDERER_OPENGL)
+	{
+		fprintf(stderr, "Skipping FosterDraw benchmarks, they require the OpenGL renderer\n");
+		return;
+	}
+
+	const char* vertexShader =
+		"#version 330\n"
+		"layout(location=0) in vec2 a_position;\n"
+		"void main(void) { gl_Position = vec4(a_position, 0, 1); }\n";
+	const char* fragmentShader =
+		"#version 330\n"
+		"out vec4 o_color;\n"
+		"void main(void) { o_color = vec4(1, 1, 1, 0.1); }\n";
+
+	FosterShaderData shaderData;
+	shaderData.vertexShader = (void*)vertexShader;
+	shaderData.fragmentShader = (void*)fragmentShader;
+
+	float vertices[] = { -0.1f, -0.1f, 0.1f, -0.1f, 0.1f, 0.1f, -0.1f, 0.1f };
+	int indices[] = { 0, 1, 2, 0, 2, 3 };
+	FosterVertexFormatElement element = { 0, FOSTER_VERTEX_TYPE_FLOAT2, 0 };
+	FosterVertexFormat format = { &element, 1, sizeof(float) * 2 };
+	FosterTextureFormat attachment = FOSTER_TEXTURE_FORMAT_R8G8B8A8;
+
+	BenchDraw state;
+	state.shader = FosterShaderCreate(&shaderData);
+	state.mesh = FosterMeshCreate();
+	state.target = FosterTargetCreate(1280, 720, &attachment, 1);
+
+	if (state.shader != NULL && state.mesh != NULL && state.target != NULL)
+	{
+		FosterMeshSetVertexFormat(state.mesh, &format);
+		FosterMeshSetVertexData(state.mesh, vertices, sizeof(vertices), 0);
+		FosterMeshSetIndexFormat(state.mesh, FOSTER_INDEX_FORMAT_THIRTY_TWO);
+		FosterMeshSetIndexData(state.mesh, indices, sizeof(indices), 0);
+
+		FosterBeginFrame();
+		BenchRun("FosterDraw", BENCH_DRAW_COUNT, BenchDrawCommands, &state);
+		FosterEndFrame();
+	}
+
+	if (state.target != NULL)
+		FosterTargetDestroy(state.target);
+	if (state.mesh != NULL)
+		FosterMeshDestroy(state.mesh);
+	if (state.shader != NULL)
+		FosterShaderDestroy(state.shader);
+}
+
+int main(int argc, char** argv)
+{
+	FosterBool headless = 0;
+	const char* output = NULL;
+
+	for (int i = 1; i < argc; i ++)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+			headless = 1;
+		else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+			output = argv[++i];
+		else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+			benchFilter = argv[++i];
+		else if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+		{
+			int count = atoi(argv[++i]);
+			if (count > 0)
+				benchIterations = count;
+		}
+		else
+		{
+			fprintf(stderr, "Usage: %s [--headless] [--output <file>] [--filter <name>] [--iterations <count>]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	// encode the same image with each format, and time decoding them
+	{
+		FosterColor* pixels = (FosterColor*)malloc(sizeof(FosterColor) * BENCH_IMAGE_SIZE * BENCH_IMAGE_SIZE);
+		BenchBuffer png = { NULL, 0, 0 };
+		BenchBuffer qoi = { NULL, 0, 0 };
+
+		if (pixels != NULL)
+		{
+			BenchCreatePixels(pixels, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE);
+			FosterImageWrite((FosterWriteFn*)BenchBufferWrite, &png, FOSTER_IMAGE_WRITE_FORMAT_PNG, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, pixels);
+			FosterImageWrite((FosterWriteFn*)BenchBufferWrite, &qoi, FOSTER_IMAGE_WRITE_FORMAT_QOI, BENCH_IMAGE_SIZE, BENCH_IMAGE_SIZE, pixels);
+			free(pixels);
+		}
+
+		if (png.length > 0)
+			BenchRun("FosterImageLoad/PNG", 1, BenchImageLoad, &png);
+		if (qoi.length > 0)
+			BenchRun("FosterImageLoad/QOI", 1, BenchImageLoad, &qoi);
+
+		free(png.data);
+		free(qoi.data);
+	}
+
+	if (!headless)
+	{
+		FosterDesc desc;
+		memset(&desc, 0, sizeof(desc));
+		desc.windowTitle = "Foster Benchmarks";
+		desc.applicationName = "FosterBenchmarks";
+		desc.width = 1280;
+		desc.height = 720;
+		desc.renderer = FOSTER_RENDERER_OPENGL;
+		desc.flags = 0;
+
+		FosterStartup(desc);
+		if (FosterIsRunning())
+		{
+			BenchRenderer();
+			FosterShutdown();
+		}
+	}
+
+	FILE* out = output != NULL ? fopen(output, "w") : stdout;
+	if (out == NULL)
+	{
+		fprintf(stderr, "Failed to open %s\n", output);
+		return 1;
+	}
+	BenchWriteResults(out);
+	if (out != stdout)
+		fclose(out);
+
+	return 0;
+}
@@ -20,7 +20,10 @@
 #define FOSTER_MAX_VERTEX_FORMAT_ELEMENTS 16
 #define FOSTER_MAX_UNIFORM_NAME 64
 #define FOSTER_MAX_UNIFORM_TEXTURES 32
+#define FOSTER_MAX_UNIFORM_BUFFERS 12
 #define FOSTER_MAX_CONTROLLERS 32
+#define FOSTER_MAX_QUADS_SIXTEEN_BIT 16384
+#define FOSTER_MAX_QUEUED_FRAMES 3
 
 typedef uint8_t FosterBool;
 
@@ -37,6 +40,7 @@ typedef enum FosterFlags
 	FOSTER_FLAG_VSYNC         = 1 << 1,
 	FOSTER_FLAG_RESIZABLE     = 1 << 2,
 	FOSTER_FLAG_MOUSE_VISIBLE = 1 << 3,
+	FOSTER_FLAG_VSYNC_ADAPTIVE = 1 << 4,
 } FosterFlags;
 
 typedef enum FosterKeys
@@ -349,6 +353,13 @@ typedef enum FosterTextureFilter
 	FOSTER_TEXTURE_FILTER_LINEAR
 } FosterTextureFilter;
 
+typedef enum FosterTextureMipFilter
+{
+	FOSTER_TEXTURE_MIP_FILTER_NONE,
+	FOSTER_TEXTURE_MIP_FILTER_NEAREST,
+	FOSTER_TEXTURE_MIP_FILTER_LINEAR
+} FosterTextureMipFilter;
+
 typedef enum FosterTextureWrap
 {
 	FOSTER_TEXTURE_WRAP_REPEAT,
@@ -362,6 +373,11 @@ typedef enum FosterTextureFormat
 	FOSTER_TEXTURE_FORMAT_R8G8B8A8,
 	FOSTER_TEXTURE_FORMAT_R8,
 	FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8,
+	FOSTER_TEXTURE_FORMAT_BC1,
+	FOSTER_TEXTURE_FORMAT_BC3,
+	FOSTER_TEXTURE_FORMAT_BC7,
+	FOSTER_TEXTURE_FORMAT_ETC2,
+	FOSTER_TEXTURE_FORMAT_ASTC_4X4,
 } FosterTextureFormat;
 
 typedef enum FosterClearMask
@@ -383,7 +399,9 @@ typedef enum FosterUniformType
 	FOSTER_UNIFORM_TYPE_MAT3X2,
 	FOSTER_UNIFORM_TYPE_MAT4X4,
 	FOSTER_UNIFORM_TYPE_TEXTURE2D,
-	FOSTER_UNIFORM_TYPE_SAMPLER2D
+	FOSTER_UNIFORM_TYPE_SAMPLER2D,
+	FOSTER_UNIFORM_TYPE_UNIFORM_BUFFER,
+	FOSTER_UNIFORM_TYPE_TEXTURE2D_ARRAY
 } FosterUniformType;
 
 typedef enum FosterVertexType
@@ -449,6 +467,11 @@ typedef struct FosterTexture FosterTexture;
 typedef struct FosterTarget FosterTarget; 
 typedef struct FosterShader FosterShader; 
 typedef struct FosterMesh FosterMesh; 
+typedef struct FosterUniformBuffer FosterUniformBuffer;
+typedef struct FosterTextureUpload FosterTextureUpload;
+typedef struct FosterReadback FosterReadback;
+typedef struct FosterPipeline FosterPipeline;
+typedef struct FosterCommandList FosterCommandList;
 
 typedef struct FosterDesc
 {
@@ -524,6 +547,8 @@ typedef struct FosterTextureSampler
 	FosterTextureFilter filter;
 	FosterTextureWrap wrapX;
 	FosterTextureWrap wrapY;
+	FosterTextureMipFilter mipFilter;
+	int anisotropy;
 } FosterTextureSampler;
 
 typedef struct FosterVertexFormatElement
@@ -560,6 +585,19 @@ typedef struct FosterBlend
 	uint32_t rgba;
 } FosterBlend;
 
+// The state a Pipeline bakes in ahead of time. The vertex and instance
+// formats are those of the Meshes it will be drawn with.
+typedef struct FosterPipelineData
+{
+	FosterShader* shader;
+	FosterVertexFormat vertexFormat;
+	FosterVertexFormat instanceFormat;
+	FosterCompare compare;
+	int depthMask;
+	FosterCull cull;
+	FosterBlend blend;
+} FosterPipelineData;
+
 typedef struct FosterDrawCommand
 {
 	FosterTarget* target;
@@ -572,12 +610,22 @@ typedef struct FosterDrawCommand
 	int indexStart;
 	int indexCount;
 	int instanceCount;
+	int instanceStart;
 	FosterCompare compare;
 	int depthMask;
 	FosterCull cull;
 	FosterBlend blend;
+	// optional, and when assigned replaces the shader, compare, depthMask, cull and blend
+	FosterPipeline* pipeline;
 } FosterDrawCommand;
 
+typedef struct FosterDrawRange
+{
+	int indexStart;
+	int indexCount;
+	int baseVertex;
+} FosterDrawRange;
+
 typedef struct FosterClearCommand
 {
 	FosterTarget* target;
@@ -588,6 +636,29 @@ typedef struct FosterClearCommand
 	FosterClearMask mask;
 } FosterClearCommand;
 
+// Render statistics of the last completed frame
+typedef struct FosterFrameStats
+{
+	int drawCalls;
+	int stateChanges;
+	int stateChangesSkipped;
+	int textureBinds;
+	int64_t bufferBytesUploaded;
+	int64_t textureBytesUploaded;
+	// GPU time of the frame, in milliseconds, or -1 if the Renderer can't time it.
+	// GPU results trail the CPU by a few frames, so this is the latest one available.
+	double gpuTime;
+	int gpuScopeCount;
+} FosterFrameStats;
+
+// GPU time of a labeled scope, within the frame reported by FosterFrameStats
+typedef struct FosterGpuScope
+{
+	const char* name;
+	int depth;
+	double time;
+} FosterGpuScope;
+
 typedef struct FosterFont FosterFont;
 
 #if __cplusplus
@@ -602,8 +673,34 @@ FOSTER_API void FosterBeginFrame();
 
 FOSTER_API FosterBool FosterPollEvents(FosterEvent* ev);
 
+// Polls up to capacity events into the output array, returning how many were written.
+// If it returns the full capacity there may be more events to poll.
+FOSTER_API int FosterPollEventsBatch(FosterEvent* output, int capacity);
+
 FOSTER_API void FosterEndFrame();
 
+FOSTER_API void FosterGetFrameStats(FosterFrameStats* stats);
+
+FOSTER_API void FosterGpuScopeBegin(const char* name);
+
+FOSTER_API void FosterGpuScopeEnd();
+
+FOSTER_API int FosterGetGpuScopes(FosterGpuScope* output, int max);
+
+// Tracing zones are only recorded when the Platform is built with the
+// FOSTER_TRACE CMake option, and otherwise do nothing. Zones can be begun on
+// any thread, and must be ended on the thread that began them.
+
+FOSTER_API FosterBool FosterTraceEnabled();
+
+FOSTER_API void FosterTraceBegin(const char* name);
+
+FOSTER_API void FosterTraceEnd();
+
+// Writes the zones recorded since the last flush as Chrome Trace JSON. This
+// can't be called from multiple threads at once, and does nothing with Tracy.
+FOSTER_API void FosterTraceFlush(FosterWriteFn func, void* context);
+
 FOSTER_API void FosterShutdown();
 
 FOSTER_API FosterBool FosterIsRunning();
@@ -620,6 +717,14 @@ FOSTER_API void FosterGetDisplaySize(int* width, int* height);
 
 FOSTER_API void FosterSetFlags(FosterFlags flags);
 
+// Limits how many frames the CPU can submit before the GPU has finished them, which lowers
+// input latency at the cost of throughput. 0 leaves it up to the driver.
+FOSTER_API void FosterSetMaxQueuedFrames(int count);
+
+// Sleeps the calling thread for the given number of seconds, with sub-millisecond precision.
+// On Windows this uses a high resolution waitable timer where available.
+FOSTER_API void FosterSleep(double seconds);
+
 FOSTER_API void FosterSetCentered();
 
 FOSTER_API const char* FosterGetUserPath();
@@ -632,6 +737,10 @@ FOSTER_API FosterBool FosterGetFocused();
 
 FOSTER_API unsigned char* FosterImageLoad(const unsigned char* memory, int length, int* w, int* h);
 
+// Loads many images at once, spread across worker threads. Each output is
+// assigned the same as FosterImageLoad would have, and is NULL if it failed to load.
+FOSTER_API void FosterImageLoadMany(const unsigned char** memory, const int* lengths, int count, unsigned char** outputs, int* widths, int* heights);
+
 FOSTER_API void FosterImageFree(unsigned char* data);
 
 FOSTER_API FosterBool FosterImageWrite(FosterWriteFn* func, void* context, FosterImageWriteFormat format, int w, int h, const void* data);
@@ -650,16 +759,50 @@ FOSTER_API void FosterFontGetCharacter(FosterFont* font, int glyph, float scale,
 
 FOSTER_API void FosterFontGetPixels(FosterFont* font, unsigned char* dest, int glyph, int width, int height, float scale);
 
+// Renders a glyph as a single channel signed distance field, including padding on every side.
+// Returns NULL if the glyph has no shape (ex. a space), and otherwise must be freed with FosterFontFreeSDF.
+FOSTER_API unsigned char* FosterFontGetSDF(FosterFont* font, int glyph, float scale, int padding, unsigned char onEdgeValue, float pixelDistScale, int* width, int* height, int* offsetX, int* offsetY);
+
+FOSTER_API void FosterFontFreeSDF(unsigned char* data);
+
 FOSTER_API void FosterFontFree(FosterFont* font);
 
 FOSTER_API FosterRenderers FosterGetRenderer();
 
+FOSTER_API FosterBool FosterTextureFormatSupported(FosterTextureFormat format);
+
 FOSTER_API FosterTexture* FosterTextureCreate(int width, int height, FosterTextureFormat format);
 
+FOSTER_API FosterTexture* FosterTextureCreateArray(int width, int height, int layers, FosterTextureFormat format);
+
 FOSTER_API void FosterTextureSetData(FosterTexture* texture, void* data, int length);
 
+FOSTER_API void FosterTextureSetLayerData(FosterTexture* texture, int layer, void* data, int length);
+
+FOSTER_API void FosterTextureSetSubData(FosterTexture* texture, FosterRect rect, void* data, int length);
+
+FOSTER_API void FosterTextureSetLevelData(FosterTexture* texture, int level, void* data, int length);
+
+FOSTER_API void FosterTextureGenerateMipmaps(FosterTexture* texture);
+
+FOSTER_API FosterTextureUpload* FosterTextureUploadBegin(FosterTexture* texture, FosterRect rect);
+
+FOSTER_API void* FosterTextureUploadGetData(FosterTextureUpload* upload);
+
+FOSTER_API void FosterTextureUploadSubmit(FosterTextureUpload* upload);
+
+FOSTER_API void FosterTextureUploadCancel(FosterTextureUpload* upload);
+
 FOSTER_API void FosterTextureGetData(FosterTexture* texture, void* data, int length);
 
+FOSTER_API FosterReadback* FosterTextureReadAsync(FosterTexture* texture, FosterRect rect);
+
+FOSTER_API FosterBool FosterReadbackPoll(FosterReadback* readback);
+
+FOSTER_API FosterBool FosterReadbackGet(FosterReadback* readback, void* data, int length);
+
+FOSTER_API void FosterReadbackDestroy(FosterReadback* readback);
+
 FOSTER_API void FosterTextureDestroy(FosterTexture* texture);
 
 FOSTER_API FosterTarget* FosterTargetCreate(int width, int height, FosterTextureFormat* attachments, int attachmentCount);
@@ -668,8 +811,27 @@ FOSTER_API FosterTexture* FosterTargetGetAttachment(FosterTarget* target, int in
 
 FOSTER_API void FosterTargetDestroy(FosterTarget* target);
 
+// Gets a Target from the pool matching the size and attachment formats, or creates one.
+// Its contents are undefined until it's cleared or drawn to.
+FOSTER_API FosterTarget* FosterTargetAcquire(int width, int height, FosterTextureFormat* attachments, int attachmentCount);
+
+// Returns an acquired Target to the pool, discarding its contents. The Target can then be
+// acquired again later in the same frame, so transient Targets share memory between passes.
+// Targets left unused for a number of frames are destroyed.
+FOSTER_API void FosterTargetRelease(FosterTarget* target);
+
+// Hints that the contents of the Target are no longer needed, which saves
+// tile-based GPUs from writing them back to memory.
+FOSTER_API void FosterTargetDiscard(FosterTarget* target);
+
 FOSTER_API FosterShader* FosterShaderCreate(FosterShaderData* data);
 
+FOSTER_API FosterShader* FosterShaderCreateAsync(FosterShaderData* data);
+
+FOSTER_API FosterBool FosterShaderIsReady(FosterShader* shader);
+
+FOSTER_API FosterBool FosterShaderWait(FosterShader* shader);
+
 FOSTER_API void FosterShaderGetUniforms(FosterShader* shader, FosterUniformInfo* output, int* count, int max);
 
 FOSTER_API void FosterShaderSetUniform(FosterShader* shader, int index, float* values);
@@ -678,24 +840,101 @@ FOSTER_API void FosterShaderSetTexture(FosterShader* shader, int index, FosterTe
 
 FOSTER_API void FosterShaderSetSampler(FosterShader* shader, int index, FosterTextureSampler* values);
 
+FOSTER_API void FosterShaderSetUniformBuffer(FosterShader* shader, int index, FosterUniformBuffer* buffer);
+
 FOSTER_API void FosterShaderDestroy(FosterShader* shader);
 
+FOSTER_API FosterUniformBuffer* FosterUniformBufferCreate(int size);
+
+FOSTER_API void FosterUniformBufferSetData(FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterUniformBufferDestroy(FosterUniformBuffer* buffer);
+
 FOSTER_API FosterMesh* FosterMeshCreate();
 
+FOSTER_API FosterMesh* FosterMeshCreateStreaming();
+
 FOSTER_API void FosterMeshSetVertexFormat(FosterMesh* mesh, FosterVertexFormat* format);
 
 FOSTER_API void FosterMeshSetVertexData(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
 
+FOSTER_API void* FosterMeshMapVertexData(FosterMesh* mesh, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterMeshUnmapVertexData(FosterMesh* mesh);
+
+FOSTER_API void FosterMeshSetInstanceFormat(FosterMesh* mesh, FosterVertexFormat* format);
+
+FOSTER_API void FosterMeshSetInstanceData(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+
 FOSTER_API void FosterMeshSetIndexFormat(FosterMesh* mesh, FosterIndexFormat format);
 
 FOSTER_API void FosterMeshSetIndexData(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
 
+FOSTER_API void* FosterMeshMapIndexData(FosterMesh* mesh, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterMeshUnmapIndexData(FosterMesh* mesh);
+
+FOSTER_API void FosterMeshSetQuadIndices(FosterMesh* mesh, int quadCount);
+
 FOSTER_API void FosterMeshDestroy(FosterMesh* mesh);
 
+FOSTER_API FosterPipeline* FosterPipelineCreate(FosterPipelineData* data);
+
+FOSTER_API void FosterPipelineDestroy(FosterPipeline* pipeline);
+
 FOSTER_API void FosterDraw(FosterDrawCommand* command);
 
+FOSTER_API void FosterDrawBatch(FosterDrawCommand* commands, int count);
+
+FOSTER_API void FosterDrawList(FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount);
+
 FOSTER_API void FosterClear(FosterClearCommand* clear);
 
+// Command Lists record draws, clears and data uploads without touching the
+// Renderer, so they can be filled from any thread (one thread per list at a
+// time) and then executed on the main thread. Data is copied when recorded,
+// but the resources it references must stay alive until it's executed.
+
+FOSTER_API FosterCommandList* FosterCommandListCreate();
+
+FOSTER_API void FosterCommandListReset(FosterCommandList* list);
+
+FOSTER_API void FosterCommandListDestroy(FosterCommandList* list);
+
+FOSTER_API void FosterCommandListShaderSetUniform(FosterCommandList* list, FosterShader* shader, int index, float* values, int count);
+
+FOSTER_API void FosterCommandListShaderSetTexture(FosterCommandList* list, FosterShader* shader, int index, FosterTexture** values, int count);
+
+FOSTER_API void FosterCommandListShaderSetSampler(FosterCommandList* list, FosterShader* shader, int index, FosterTextureSampler* values, int count);
+
+FOSTER_API void FosterCommandListShaderSetUniformBuffer(FosterCommandList* list, FosterShader* shader, int index, FosterUniformBuffer* buffer);
+
+FOSTER_API void FosterCommandListUniformBufferSetData(FosterCommandList* list, FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterCommandListMeshSetVertexFormat(FosterCommandList* list, FosterMesh* mesh, FosterVertexFormat* format);
+
+FOSTER_API void FosterCommandListMeshSetVertexData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterCommandListMeshSetInstanceFormat(FosterCommandList* list, FosterMesh* mesh, FosterVertexFormat* format);
+
+FOSTER_API void FosterCommandListMeshSetInstanceData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterCommandListMeshSetIndexFormat(FosterCommandList* list, FosterMesh* mesh, FosterIndexFormat format);
+
+FOSTER_API void FosterCommandListMeshSetIndexData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+
+FOSTER_API void FosterCommandListMeshSetQuadIndices(FosterCommandList* list, FosterMesh* mesh, int quadCount);
+
+FOSTER_API void FosterCommandListDraw(FosterCommandList* list, FosterDrawCommand* command);
+
+FOSTER_API void FosterCommandListDrawBatch(FosterCommandList* list, FosterDrawCommand* commands, int count);
+
+FOSTER_API void FosterCommandListDrawList(FosterCommandList* list, FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount);
+
+FOSTER_API void FosterCommandListClear(FosterCommandList* list, FosterClearCommand* clear);
+
+FOSTER_API void FosterExecuteCommandList(FosterCommandList* list);
+
 #if __cplusplus
 }
 #endif
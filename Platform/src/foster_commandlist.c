@@ -0,0 +1,353 @@
+#include "foster_platform.h"
+#include "foster_internal.h"
+#include <SDL.h>
+
+// recorded data is aligned so it can be passed straight to the Renderer
+#define FOSTER_COMMAND_ALIGN 16
+#define FOSTER_COMMAND_ALIGN_SIZE(size) (((size) + FOSTER_COMMAND_ALIGN - 1) & ~(FOSTER_COMMAND_ALIGN - 1))
+
+typedef enum FosterCommandType
+{
+	FOSTER_COMMAND_SHADER_UNIFORM,
+	FOSTER_COMMAND_SHADER_TEXTURE,
+	FOSTER_COMMAND_SHADER_SAMPLER,
+	FOSTER_COMMAND_SHADER_UNIFORM_BUFFER,
+	FOSTER_COMMAND_UNIFORM_BUFFER_DATA,
+	FOSTER_COMMAND_MESH_VERTEX_FORMAT,
+	FOSTER_COMMAND_MESH_VERTEX_DATA,
+	FOSTER_COMMAND_MESH_INSTANCE_FORMAT,
+	FOSTER_COMMAND_MESH_INSTANCE_DATA,
+	FOSTER_COMMAND_MESH_INDEX_FORMAT,
+	FOSTER_COMMAND_MESH_INDEX_DATA,
+	FOSTER_COMMAND_MESH_QUAD_INDICES,
+	FOSTER_COMMAND_DRAW_BATCH,
+	FOSTER_COMMAND_DRAW_LIST,
+	FOSTER_COMMAND_CLEAR,
+} FosterCommandType;
+
+// A recorded command, followed by 'size' bytes of its data.
+// Draws are stored separately so that a run of them can be executed as a
+// single batch, in which case 'index' is the first draw and 'count' is how many.
+typedef struct FosterCommand
+{
+	FosterCommandType type;
+	void* resource;
+	void* value;
+	int index;
+	int count;
+	int offset;
+	int size;
+	int hasData;
+} FosterCommand;
+
+typedef struct FosterCommandList
+{
+	unsigned char* data;
+	int dataLength;
+	int dataCapacity;
+	FosterDrawCommand* draws;
+	int drawCount;
+	int drawCapacity;
+	int lastCommand;
+} FosterCommandList;
+
+FosterCommand* FosterCommandListPush(FosterCommandList* list, FosterCommandType type, void* resource, const void* data, int size)
+{
+	int headerSize = FOSTER_COMMAND_ALIGN_SIZE((int)sizeof(FosterCommand));
+	int length = headerSize + FOSTER_COMMAND_ALIGN_SIZE(size);
+
+	if (list->dataLength + length > list->dataCapacity)
+	{
+		int capacity = list->dataCapacity > 0 ? list->dataCapacity : 4096;
+		while (list->dataLength + length > capacity)
+			capacity *= 2;
+
+		unsigned char* next = (unsigned char*)SDL_realloc(list->data, capacity);
+		if (next == NULL)
+		{
+			FOSTER_LOG_ERROR("Failed to grow Command List to %i bytes", capacity);
+			return NULL;
+		}
+
+		list->data = next;
+		list->dataCapacity = capacity;
+	}
+
+	FosterCommand* command = (FosterCommand*)(list->data + list->dataLength);
+	SDL_memset(command, 0, sizeof(FosterCommand));
+	command->type = type;
+	command->resource = resource;
+	command->size = size;
+	command->hasData = data != NULL;
+	if (data != NULL && size > 0)
+		SDL_memcpy(list->data + list->dataLength + headerSize, data, size);
+
+	list->lastCommand = list->dataLength;
+	list->dataLength += length;
+	return command;
+}
+
+void* FosterCommandGetData(FosterCommand* command)
+{
+	if (!command->hasData)
+		return NULL;
+	return (unsigned char*)command + FOSTER_COMMAND_ALIGN_SIZE((int)sizeof(FosterCommand));
+}
+
+FosterCommandList* FosterCommandListCreate()
+{
+	FosterCommandList* list = (FosterCommandList*)SDL_malloc(sizeof(FosterCommandList));
+	SDL_memset(list, 0, sizeof(FosterCommandList));
+	list->lastCommand = -1;
+	return list;
+}
+
+void FosterCommandListReset(FosterCommandList* list)
+{
+	// keep the memory around, as lists are usually refilled every frame
+	list->dataLength = 0;
+	list->drawCount = 0;
+	list->lastCommand = -1;
+}
+
+void FosterCommandListDestroy(FosterCommandList* list)
+{
+	SDL_free(list->data);
+	SDL_free(list->draws);
+	SDL_free(list);
+}
+
+void FosterCommandListShaderSetUniform(FosterCommandList* list, FosterShader* shader, int index, float* values, int count)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_SHADER_UNIFORM, shader, values, sizeof(float) * count);
+	if (command != NULL)
+		command->index = index;
+}
+
+void FosterCommandListShaderSetTexture(FosterCommandList* list, FosterShader* shader, int index, FosterTexture** values, int count)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_SHADER_TEXTURE, shader, values, sizeof(FosterTexture*) * count);
+	if (command != NULL)
+		command->index = index;
+}
+
+void FosterCommandListShaderSetSampler(FosterCommandList* list, FosterShader* shader, int index, FosterTextureSampler* values, int count)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_SHADER_SAMPLER, shader, values, sizeof(FosterTextureSampler) * count);
+	if (command != NULL)
+		command->index = index;
+}
+
+void FosterCommandListShaderSetUniformBuffer(FosterCommandList* list, FosterShader* shader, int index, FosterUniformBuffer* buffer)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_SHADER_UNIFORM_BUFFER, shader, NULL, 0);
+	if (command != NULL)
+	{
+		command->index = index;
+		command->value = buffer;
+	}
+}
+
+void FosterCommandListUniformBufferSetData(FosterCommandList* list, FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_UNIFORM_BUFFER_DATA, buffer, data, dataSize);
+	if (command != NULL)
+		command->offset = dataDestOffset;
+}
+
+void FosterCommandListMeshSetFormat(FosterCommandList* list, FosterCommandType type, FosterMesh* mesh, FosterVertexFormat* format)
+{
+	FosterCommand* command = FosterCommandListPush(list, type, mesh, format->elements, sizeof(FosterVertexFormatElement) * format->elementCount);
+	if (command != NULL)
+	{
+		command->count = format->elementCount;
+		command->offset = format->stride;
+	}
+}
+
+void FosterCommandListMeshSetVertexFormat(FosterCommandList* list, FosterMesh* mesh, FosterVertexFormat* format)
+{
+	FosterCommandListMeshSetFormat(list, FOSTER_COMMAND_MESH_VERTEX_FORMAT, mesh, format);
+}
+
+void FosterCommandListMeshSetVertexData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_MESH_VERTEX_DATA, mesh, data, dataSize);
+	if (command != NULL)
+		command->offset = dataDestOffset;
+}
+
+void FosterCommandListMeshSetInstanceFormat(FosterCommandList* list, FosterMesh* mesh, FosterVertexFormat* format)
+{
+	FosterCommandListMeshSetFormat(list, FOSTER_COMMAND_MESH_INSTANCE_FORMAT, mesh, format);
+}
+
+void FosterCommandListMeshSetInstanceData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_MESH_INSTANCE_DATA, mesh, data, dataSize);
+	if (command != NULL)
+		command->offset = dataDestOffset;
+}
+
+void FosterCommandListMeshSetIndexFormat(FosterCommandList* list, FosterMesh* mesh, FosterIndexFormat format)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_MESH_INDEX_FORMAT, mesh, NULL, 0);
+	if (command != NULL)
+		command->index = (int)format;
+}
+
+void FosterCommandListMeshSetIndexData(FosterCommandList* list, FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_MESH_INDEX_DATA, mesh, data, dataSize);
+	if (command != NULL)
+		command->offset = dataDestOffset;
+}
+
+void FosterCommandListMeshSetQuadIndices(FosterCommandList* list, FosterMesh* mesh, int quadCount)
+{
+	FosterCommand* command = FosterCommandListPush(list, FOSTER_COMMAND_MESH_QUAD_INDICES, mesh, NULL, 0);
+	if (command != NULL)
+		command->count = quadCount;
+}
+
+void FosterCommandListDraw(FosterCommandList* list, FosterDrawCommand* command)
+{
+	FosterCommandListDrawBatch(list, command, 1);
+}
+
+void FosterCommandListDrawBatch(FosterCommandList* list, FosterDrawCommand* commands, int count)
+{
+	if (count <= 0)
+		return;
+
+	if (list->drawCount + count > list->drawCapacity)
+	{
+		int capacity = list->drawCapacity > 0 ? list->drawCapacity : 64;
+		while (list->drawCount + count > capacity)
+			capacity *= 2;
+
+		FosterDrawCommand* next = (FosterDrawCommand*)SDL_realloc(list->draws, sizeof(FosterDrawCommand) * capacity);
+		if (next == NULL)
+		{
+			FOSTER_LOG_ERROR("Failed to grow Command List to %i Draw Commands", capacity);
+			return;
+		}
+
+		list->draws = next;
+		list->drawCapacity = capacity;
+	}
+
+	// draws following other draws join their batch, so the Renderer
+	// only has to change the state that differs between them
+	FosterCommand* last = list->lastCommand >= 0 ? (FosterCommand*)(list->data + list->lastCommand) : NULL;
+	if (last == NULL || last->type != FOSTER_COMMAND_DRAW_BATCH)
+	{
+		last = FosterCommandListPush(list, FOSTER_COMMAND_DRAW_BATCH, NULL, NULL, 0);
+		if (last == NULL)
+			return;
+		last->index = list->drawCount;
+	}
+
+	SDL_memcpy(list->draws + list->drawCount, commands, sizeof(FosterDrawCommand) * count);
+	list->drawCount += count;
+	last->count += count;
+}
+
+void FosterCommandListDrawList(FosterCommandList* list, FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount)
+{
+	if (rangeCount <= 0)
+		return;
+
+	int rangesOffset = FOSTER_COMMAND_ALIGN_SIZE((int)sizeof(FosterDrawCommand));
+	FosterCommand* it = FosterCommandListPush(list, FOSTER_COMMAND_DRAW_LIST, NULL, NULL, rangesOffset + sizeof(FosterDrawRange) * rangeCount);
+	if (it != NULL)
+	{
+		it->hasData = 1;
+		it->count = rangeCount;
+
+		unsigned char* data = (unsigned char*)FosterCommandGetData(it);
+		SDL_memcpy(data, command, sizeof(FosterDrawCommand));
+		SDL_memcpy(data + rangesOffset, ranges, sizeof(FosterDrawRange) * rangeCount);
+	}
+}
+
+void FosterCommandListClear(FosterCommandList* list, FosterClearCommand* clear)
+{
+	FosterCommandListPush(list, FOSTER_COMMAND_CLEAR, NULL, clear, sizeof(FosterClearCommand));
+}
+
+void FosterExecuteCommandList(FosterCommandList* list)
+{
+	if (!FosterIsRunning())
+	{
+		FOSTER_LOG_ERROR("Failed '%s', Foster is not running", "FosterExecuteCommandList");
+		return;
+	}
+
+	int position = 0;
+	while (position < list->dataLength)
+	{
+		FosterCommand* command = (FosterCommand*)(list->data + position);
+		void* data = FosterCommandGetData(command);
+		position += FOSTER_COMMAND_ALIGN_SIZE((int)sizeof(FosterCommand)) + FOSTER_COMMAND_ALIGN_SIZE(command->size);
+
+		switch (command->type)
+		{
+		case FOSTER_COMMAND_SHADER_UNIFORM:
+			FosterShaderSetUniform((FosterShader*)command->resource, command->index, (float*)data);
+			break;
+		case FOSTER_COMMAND_SHADER_TEXTURE:
+			FosterShaderSetTexture((FosterShader*)command->resource, command->index, (FosterTexture**)data);
+			break;
+		case FOSTER_COMMAND_SHADER_SAMPLER:
+			FosterShaderSetSampler((FosterShader*)command->resource, command->index, (FosterTextureSampler*)data);
+			break;
+		case FOSTER_COMMAND_SHADER_UNIFORM_BUFFER:
+			FosterShaderSetUniformBuffer((FosterShader*)command->resource, command->index, (FosterUniformBuffer*)command->value);
+			break;
+		case FOSTER_COMMAND_UNIFORM_BUFFER_DATA:
+			FosterUniformBufferSetData((FosterUniformBuffer*)command->resource, data, command->size, command->offset);
+			break;
+		case FOSTER_COMMAND_MESH_VERTEX_FORMAT:
+		case FOSTER_COMMAND_MESH_INSTANCE_FORMAT:
+		{
+			FosterVertexFormat format;
+			format.elements = (FosterVertexFormatElement*)data;
+			format.elementCount = command->count;
+			format.stride = command->offset;
+			if (command->type == FOSTER_COMMAND_MESH_VERTEX_FORMAT)
+				FosterMeshSetVertexFormat((FosterMesh*)command->resource, &format);
+			else
+				FosterMeshSetInstanceFormat((FosterMesh*)command->resource, &format);
+			break;
+		}
+		case FOSTER_COMMAND_MESH_VERTEX_DATA:
+			FosterMeshSetVertexData((FosterMesh*)command->resource, data, command->size, command->offset);
+			break;
+		case FOSTER_COMMAND_MESH_INSTANCE_DATA:
+			FosterMeshSetInstanceData((FosterMesh*)command->resource, data, command->size, command->offset);
+			break;
+		case FOSTER_COMMAND_MESH_INDEX_FORMAT:
+			FosterMeshSetIndexFormat((FosterMesh*)command->resource, (FosterIndexFormat)command->index);
+			break;
+		case FOSTER_COMMAND_MESH_INDEX_DATA:
+			FosterMeshSetIndexData((FosterMesh*)command->resource, data, command->size, command->offset);
+			break;
+		case FOSTER_COMMAND_MESH_QUAD_INDICES:
+			FosterMeshSetQuadIndices((FosterMesh*)command->resource, command->count);
+			break;
+		case FOSTER_COMMAND_DRAW_BATCH:
+			FosterDrawBatch(list->draws + command->index, command->count);
+			break;
+		case FOSTER_COMMAND_DRAW_LIST:
+			FosterDrawList(
+				(FosterDrawCommand*)data,
+				(FosterDrawRange*)((unsigned char*)data + FOSTER_COMMAND_ALIGN_SIZE((int)sizeof(FosterDrawCommand))),
+				command->count);
+			break;
+		case FOSTER_COMMAND_CLEAR:
+			FosterClear((FosterClearCommand*)data);
+			break;
+		}
+	}
+}
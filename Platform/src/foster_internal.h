@@ -3,12 +3,28 @@
 
 #include "foster_platform.h"
 #include "foster_renderer.h"
+#include "foster_trace.h"
 #include <SDL.h>
 
 #define FOSTER_LOG_INFO(...) FosterLog(FOSTER_LOG_LEVEL_INFO, __VA_ARGS__)
 #define FOSTER_LOG_WARN(...) FosterLog(FOSTER_LOG_LEVEL_WARNING, __VA_ARGS__)
 #define FOSTER_LOG_ERROR(...) FosterLog(FOSTER_LOG_LEVEL_ERROR, __VA_ARGS__)
 
+// number of frames a pooled Target can sit unused before it's destroyed
+#define FOSTER_TARGET_POOL_IDLE_FRAMES 30
+
+// a Target owned by the Target pool, which is either acquired or idle
+typedef struct
+{
+	FosterTarget* target;
+	int width;
+	int height;
+	int attachmentCount;
+	FosterTextureFormat attachments[FOSTER_MAX_TARGET_ATTACHMENTS];
+	FosterBool acquired;
+	Uint64 lastFrame;
+} FosterTargetPoolEntry;
+
 // foster global state
 typedef struct
 {
@@ -25,10 +41,24 @@ typedef struct
 	FosterLogFn logFn;
 	FosterLogFilter logFilter;
 	FosterBool polledMouseMovement;
+	FosterFrameStats frameStats;
+	FosterFrameStats frameStatsLast;
+	Uint64 frame;
+	int maxQueuedFrames;
+	void* waitTimer;
+	FosterTargetPoolEntry* targetPool;
+	int targetPoolCount;
+	int targetPoolCapacity;
 } FosterState;
 
 FosterState* FosterGetState();
 
+// adds to a counter of the frame currently being rendered
+#define FOSTER_STAT_ADD(name, amount) (FosterGetState()->frameStats.name += (amount))
+
+// counts a cached render state that was either applied or already current
+#define FOSTER_STAT_STATE(applied) ((applied) ? FOSTER_STAT_ADD(stateChanges, 1) : FOSTER_STAT_ADD(stateChangesSkipped, 1))
+
 void FosterLog(FosterLogLevel level, const char* fmt, ...);
 
 #endif
@@ -3,6 +3,18 @@
 #include "foster_internal.h"
 #include <SDL.h>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#elif !defined(__EMSCRIPTEN__)
+#include <time.h>
+#include <errno.h>
+#endif
+
 #define STBTT_STATIC
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "third_party/stb_truetype.h"
@@ -163,6 +175,7 @@ FosterBool FosterPollEvents(FosterEvent* output)
 	FOSTER_ASSERT_RUNNING_RET(FosterPollEvents, 0);
 
 	SDL_Event event;
+	int polled = 0;
 	*output = (FosterEvent){ 0 };
 	output->eventType = FOSTER_EVENT_TYPE_NONE;
 
@@ -188,7 +201,12 @@ FosterBool FosterPollEvents(FosterEvent* output)
 
 	// get next SDL event, or return false if no more found
 NEXT_EVENT:
-	if (!SDL_PollEvent(&event))
+	{
+		FOSTER_TRACE_ZONE("FosterPollEvents");
+		polled = SDL_PollEvent(&event);
+		FOSTER_TRACE_ZONE_END();
+	}
+	if (!polled)
 	{
 		fstate.polledMouseMovement = 0;
 		return 0;
@@ -350,24 +368,94 @@ NEXT_EVENT:
 	return 1;
 }
 
+int FosterPollEventsBatch(FosterEvent* output, int capacity)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterPollEventsBatch, 0);
+
+	int count = 0;
+	while (count < capacity && FosterPollEvents(&output[count]))
+		count++;
+	return count;
+}
+
 void FosterEndFrame()
 {
 	FOSTER_ASSERT_RUNNING(FosterEndFrame);
 
 	if (fstate.device.frameEnd)
 		fstate.device.frameEnd();
+
+	fstate.frameStatsLast = fstate.frameStats;
+	SDL_memset(&fstate.frameStats, 0, sizeof(FosterFrameStats));
+	fstate.frame++;
+
+	// destroy pooled Targets that haven't been used in a while
+	for (int i = fstate.targetPoolCount - 1; i >= 0; i--)
+	{
+		FosterTargetPoolEntry* entry = &fstate.targetPool[i];
+		if (!entry->acquired && fstate.frame - entry->lastFrame > FOSTER_TARGET_POOL_IDLE_FRAMES)
+		{
+			fstate.device.targetDestroy(entry->target);
+			fstate.targetPool[i] = fstate.targetPool[--fstate.targetPoolCount];
+		}
+	}
+}
+
+void FosterGetFrameStats(FosterFrameStats* stats)
+{
+	FOSTER_ASSERT_RUNNING(FosterGetFrameStats);
+
+	*stats = fstate.frameStatsLast;
+	stats->gpuTime = fstate.device.gpuFrameTime ? fstate.device.gpuFrameTime() : -1;
+	stats->gpuScopeCount = fstate.device.gpuScopes ? fstate.device.gpuScopes(NULL, 0) : 0;
+}
+
+void FosterGpuScopeBegin(const char* name)
+{
+	FOSTER_ASSERT_RUNNING(FosterGpuScopeBegin);
+
+	// timing is optional, so there's no error when it's unsupported
+	if (fstate.device.gpuScopeBegin)
+		fstate.device.gpuScopeBegin(name);
+}
+
+void FosterGpuScopeEnd()
+{
+	FOSTER_ASSERT_RUNNING(FosterGpuScopeEnd);
+
+	if (fstate.device.gpuScopeEnd)
+		fstate.device.gpuScopeEnd();
+}
+
+int FosterGetGpuScopes(FosterGpuScope* output, int max)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterGetGpuScopes, 0);
+
+	if (fstate.device.gpuScopes)
+		return fstate.device.gpuScopes(output, max);
+	return 0;
 }
 
 void FosterShutdown()
 {
 	if (!fstate.running)
 		return;
+	for (int i = 0; i < fstate.targetPoolCount; i++)
+		fstate.device.targetDestroy(fstate.targetPool[i].target);
+	SDL_free(fstate.targetPool);
+	fstate.targetPool = NULL;
+	fstate.targetPoolCount = fstate.targetPoolCapacity = 0;
 	if (fstate.device.shutdown)
 		fstate.device.shutdown();
 	if (fstate.clipboardText != NULL)
 		SDL_free(fstate.clipboardText);
 	if (fstate.userPath != NULL)
 		SDL_free(fstate.userPath);
+#if defined(_WIN32)
+	if (fstate.waitTimer != NULL)
+		CloseHandle((HANDLE)fstate.waitTimer);
+	fstate.waitTimer = NULL;
+#endif
 	fstate.clipboardText = NULL;
 	fstate.running = false;
 	SDL_DestroyWindow(fstate.window);
@@ -436,8 +524,19 @@ void FosterSetFlags(FosterFlags flags)
 		// vsync
 		if (fstate.device.renderer == FOSTER_RENDERER_OPENGL)
 		{
-			int result = SDL_GL_SetSwapInterval(FOSTER_CHECK(flags, FOSTER_FLAG_VSYNC) ? 1 : 0);
-			if (result != 0)
+			int interval = FOSTER_CHECK(flags, FOSTER_FLAG_VSYNC) ? 1 : 0;
+
+			// adaptive vsync tears instead of waiting when a frame misses the refresh,
+			// and not every driver supports it
+			if (interval == 1 && FOSTER_CHECK(flags, FOSTER_FLAG_VSYNC_ADAPTIVE))
+			{
+				if (SDL_GL_SetSwapInterval(-1) == 0)
+					interval = -1;
+				else
+					FOSTER_LOG_WARN("Adaptive V-Sync unsupported, falling back to V-Sync: %s", SDL_GetError());
+			}
+
+			if (interval != -1 && SDL_GL_SetSwapInterval(interval) != 0)
 				FOSTER_LOG_WARN("Setting V-Sync Failed: %s", SDL_GetError());
 		}
 
@@ -445,6 +544,50 @@ void FosterSetFlags(FosterFlags flags)
 	}
 }
 
+void FosterSetMaxQueuedFrames(int count)
+{
+	FOSTER_ASSERT_RUNNING(FosterSetMaxQueuedFrames);
+
+	if (count < 0)
+		count = 0;
+	if (count > FOSTER_MAX_QUEUED_FRAMES)
+		count = FOSTER_MAX_QUEUED_FRAMES;
+	fstate.maxQueuedFrames = count;
+}
+
+void FosterSleep(double seconds)
+{
+	FOSTER_ASSERT_RUNNING(FosterSleep);
+
+	if (seconds <= 0)
+		return;
+
+#if defined(_WIN32)
+	// high resolution timers (Windows 10 1803+) don't depend on the system timer period.
+	// older versions get a regular timer, which is only as precise as the 1ms period SDL requests.
+	if (fstate.waitTimer == NULL)
+		fstate.waitTimer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (fstate.waitTimer == NULL)
+		fstate.waitTimer = CreateWaitableTimerExW(NULL, NULL, 0, TIMER_ALL_ACCESS);
+
+	// negative due times are relative, in 100ns units
+	LARGE_INTEGER due;
+	due.QuadPart = -(LONGLONG)(seconds * 10000000.0);
+
+	if (fstate.waitTimer != NULL && SetWaitableTimer((HANDLE)fstate.waitTimer, &due, 0, NULL, NULL, FALSE))
+		WaitForSingleObject((HANDLE)fstate.waitTimer, INFINITE);
+	else
+		SDL_Delay((Uint32)(seconds * 1000.0));
+#elif defined(__EMSCRIPTEN__)
+	SDL_Delay((Uint32)(seconds * 1000.0));
+#else
+	struct timespec time;
+	time.tv_sec = (time_t)seconds;
+	time.tv_nsec = (long)((seconds - (double)time.tv_sec) * 1000000000.0);
+	while (nanosleep(&time, &time) != 0 && errno == EINTR);
+#endif
+}
+
 void FosterSetCentered()
 {
 	FOSTER_ASSERT_RUNNING(FosterSetCentered);
@@ -568,6 +711,19 @@ void FosterFontGetPixels(FosterFont* font, unsigned char* dest, int glyph, int w
 	}
 }
 
+unsigned char* FosterFontGetSDF(FosterFont* font, int glyph, float scale, int padding, unsigned char onEdgeValue, float pixelDistScale, int* width, int* height, int* offsetX, int* offsetY)
+{
+	stbtt_fontinfo* info = (stbtt_fontinfo*)font;
+
+	*width = *height = *offsetX = *offsetY = 0;
+	return stbtt_GetGlyphSDF(info, scale, glyph, padding, onEdgeValue, pixelDistScale, width, height, offsetX, offsetY);
+}
+
+void FosterFontFreeSDF(unsigned char* data)
+{
+	stbtt_FreeSDF(data, NULL);
+}
+
 void FosterFontFree(FosterFont* font)
 {
 	stbtt_fontinfo* info = (stbtt_fontinfo*)font;
@@ -580,16 +736,119 @@ FosterRenderers FosterGetRenderer()
 	return fstate.device.renderer;
 }
 
+FosterBool FosterTextureFormatSupported(FosterTextureFormat format)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTextureFormatSupported, 0);
+	if (fstate.device.textureFormatSupported == NULL)
+	{
+		return
+			format == FOSTER_TEXTURE_FORMAT_R8G8B8A8 ||
+			format == FOSTER_TEXTURE_FORMAT_R8 ||
+			format == FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8;
+	}
+	return fstate.device.textureFormatSupported(format);
+}
+
 FosterTexture* FosterTextureCreate(int width, int height, FosterTextureFormat format)
 {
 	FOSTER_ASSERT_RUNNING_RET(FosterTextureCreate, NULL);
 	return fstate.device.textureCreate(width, height, format);
 }
 
+FosterTexture* FosterTextureCreateArray(int width, int height, int layers, FosterTextureFormat format)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTextureCreateArray, NULL);
+	if (fstate.device.textureCreateArray == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Arrays are not supported by the current Renderer");
+		return NULL;
+	}
+	return fstate.device.textureCreateArray(width, height, layers, format);
+}
+
 void FosterTextureSetData(FosterTexture* texture, void* data, int length)
 {
 	FOSTER_ASSERT_RUNNING(FosterTextureSetData);
+	FOSTER_TRACE_ZONE("FosterTextureSetData");
 	fstate.device.textureSetData(texture, data, length);
+	FOSTER_TRACE_ZONE_END();
+}
+
+void FosterTextureSetLayerData(FosterTexture* texture, int layer, void* data, int length)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureSetLayerData);
+	if (fstate.device.textureSetLayerData == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Arrays are not supported by the current Renderer");
+		return;
+	}
+	fstate.device.textureSetLayerData(texture, layer, data, length);
+}
+
+void FosterTextureSetLevelData(FosterTexture* texture, int level, void* data, int length)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureSetLevelData);
+	if (fstate.device.textureSetLevelData == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Mipmaps are not supported by the current Renderer");
+		return;
+	}
+	fstate.device.textureSetLevelData(texture, level, data, length);
+}
+
+void FosterTextureGenerateMipmaps(FosterTexture* texture)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureGenerateMipmaps);
+	if (fstate.device.textureGenerateMipmaps == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Mipmaps are not supported by the current Renderer");
+		return;
+	}
+	fstate.device.textureGenerateMipmaps(texture);
+}
+
+void FosterTextureSetSubData(FosterTexture* texture, FosterRect rect, void* data, int length)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureSetSubData);
+	if (fstate.device.textureSetSubData == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Sub Data is not supported by the current Renderer");
+		return;
+	}
+	fstate.device.textureSetSubData(texture, rect, data, length);
+}
+
+FosterTextureUpload* FosterTextureUploadBegin(FosterTexture* texture, FosterRect rect)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTextureUploadBegin, NULL);
+	if (fstate.device.textureUploadBegin == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Uploads are not supported by the current Renderer");
+		return NULL;
+	}
+	return fstate.device.textureUploadBegin(texture, rect);
+}
+
+void* FosterTextureUploadGetData(FosterTextureUpload* upload)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTextureUploadGetData, NULL);
+	if (fstate.device.textureUploadGetData == NULL)
+		return NULL;
+	return fstate.device.textureUploadGetData(upload);
+}
+
+void FosterTextureUploadSubmit(FosterTextureUpload* upload)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureUploadSubmit);
+	if (fstate.device.textureUploadSubmit != NULL)
+		fstate.device.textureUploadSubmit(upload);
+}
+
+void FosterTextureUploadCancel(FosterTextureUpload* upload)
+{
+	FOSTER_ASSERT_RUNNING(FosterTextureUploadCancel);
+	if (fstate.device.textureUploadCancel != NULL)
+		fstate.device.textureUploadCancel(upload);
 }
 
 void FosterTextureGetData(FosterTexture* texture, void* data, int length)
@@ -598,6 +857,40 @@ void FosterTextureGetData(FosterTexture* texture, void* data, int length)
 	fstate.device.textureGetData(texture, data, length);
 }
 
+FosterReadback* FosterTextureReadAsync(FosterTexture* texture, FosterRect rect)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTextureReadAsync, NULL);
+	if (fstate.device.textureReadAsync == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Readbacks are not supported by the current Renderer");
+		return NULL;
+	}
+	return fstate.device.textureReadAsync(texture, rect);
+}
+
+FosterBool FosterReadbackPoll(FosterReadback* readback)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterReadbackPoll, false);
+	if (fstate.device.readbackPoll == NULL)
+		return false;
+	return fstate.device.readbackPoll(readback);
+}
+
+FosterBool FosterReadbackGet(FosterReadback* readback, void* data, int length)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterReadbackGet, false);
+	if (fstate.device.readbackGet == NULL)
+		return false;
+	return fstate.device.readbackGet(readback, data, length);
+}
+
+void FosterReadbackDestroy(FosterReadback* readback)
+{
+	FOSTER_ASSERT_RUNNING(FosterReadbackDestroy);
+	if (fstate.device.readbackDestroy != NULL)
+		fstate.device.readbackDestroy(readback);
+}
+
 void FosterTextureDestroy(FosterTexture* texture)
 {
 	FOSTER_ASSERT_RUNNING(FosterTextureDestroy);
@@ -626,10 +919,113 @@ void FosterTargetDestroy(FosterTarget* target)
 	fstate.device.targetDestroy(target);
 }
 
+FosterTarget* FosterTargetAcquire(int width, int height, FosterTextureFormat* attachments, int attachmentCount)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterTargetAcquire, NULL);
+
+	if (attachmentCount <= 0 || attachmentCount > FOSTER_MAX_TARGET_ATTACHMENTS)
+	{
+		FOSTER_LOG_ERROR("Failed to acquire Target, invalid attachment count");
+		return NULL;
+	}
+
+	// reuse an idle Target with the same size and formats
+	for (int i = 0; i < fstate.targetPoolCount; i++)
+	{
+		FosterTargetPoolEntry* entry = &fstate.targetPool[i];
+		if (entry->acquired || entry->width != width || entry->height != height || entry->attachmentCount != attachmentCount)
+			continue;
+		if (SDL_memcmp(entry->attachments, attachments, sizeof(FosterTextureFormat) * attachmentCount) != 0)
+			continue;
+
+		entry->acquired = 1;
+		entry->lastFrame = fstate.frame;
+		return entry->target;
+	}
+
+	FosterTarget* target = fstate.device.targetCreate(width, height, attachments, attachmentCount);
+	if (target == NULL)
+		return NULL;
+
+	if (fstate.targetPoolCount >= fstate.targetPoolCapacity)
+	{
+		int capacity = fstate.targetPoolCapacity > 0 ? fstate.targetPoolCapacity * 2 : 8;
+		fstate.targetPool = (FosterTargetPoolEntry*)SDL_realloc(fstate.targetPool, sizeof(FosterTargetPoolEntry) * capacity);
+		fstate.targetPoolCapacity = capacity;
+	}
+
+	FosterTargetPoolEntry* entry = &fstate.targetPool[fstate.targetPoolCount++];
+	SDL_memset(entry, 0, sizeof(FosterTargetPoolEntry));
+	entry->target = target;
+	entry->width = width;
+	entry->height = height;
+	entry->attachmentCount = attachmentCount;
+	SDL_memcpy(entry->attachments, attachments, sizeof(FosterTextureFormat) * attachmentCount);
+	entry->acquired = 1;
+	entry->lastFrame = fstate.frame;
+	return target;
+}
+
+void FosterTargetRelease(FosterTarget* target)
+{
+	FOSTER_ASSERT_RUNNING(FosterTargetRelease);
+
+	for (int i = 0; i < fstate.targetPoolCount; i++)
+	{
+		FosterTargetPoolEntry* entry = &fstate.targetPool[i];
+		if (entry->target != target)
+			continue;
+
+		if (fstate.device.targetDiscard)
+			fstate.device.targetDiscard(target);
+		entry->acquired = 0;
+		entry->lastFrame = fstate.frame;
+		return;
+	}
+
+	FOSTER_LOG_WARN("Released a Target that wasn't acquired from the pool");
+}
+
+void FosterTargetDiscard(FosterTarget* target)
+{
+	FOSTER_ASSERT_RUNNING(FosterTargetDiscard);
+
+	// discarding is only a hint, so there's no error when it's unsupported
+	if (fstate.device.targetDiscard)
+		fstate.device.targetDiscard(target);
+}
+
 FosterShader* FosterShaderCreate(FosterShaderData* data)
 {
 	FOSTER_ASSERT_RUNNING_RET(FosterShaderCreate, NULL);
-	return fstate.device.shaderCreate(data);
+	FOSTER_TRACE_ZONE("FosterShaderCreate");
+	FosterShader* result = fstate.device.shaderCreate(data);
+	FOSTER_TRACE_ZONE_END();
+	return result;
+}
+
+FosterShader* FosterShaderCreateAsync(FosterShaderData* data)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterShaderCreateAsync, NULL);
+	if (fstate.device.shaderCreateAsync == NULL)
+		return fstate.device.shaderCreate(data);
+	return fstate.device.shaderCreateAsync(data);
+}
+
+FosterBool FosterShaderIsReady(FosterShader* shader)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterShaderIsReady, 0);
+	if (fstate.device.shaderIsReady == NULL)
+		return 1;
+	return fstate.device.shaderIsReady(shader);
+}
+
+FosterBool FosterShaderWait(FosterShader* shader)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterShaderWait, 0);
+	if (fstate.device.shaderWait == NULL)
+		return 1;
+	return fstate.device.shaderWait(shader);
 }
 
 void FosterShaderGetUniforms(FosterShader* shader, FosterUniformInfo* output, int* count, int max)
@@ -656,18 +1052,56 @@ void FosterShaderSetSampler(FosterShader* shader, int index, FosterTextureSample
 	fstate.device.shaderSetSampler(shader, index, values);
 }
 
+void FosterShaderSetUniformBuffer(FosterShader* shader, int index, FosterUniformBuffer* buffer)
+{
+	FOSTER_ASSERT_RUNNING(FosterShaderSetUniformBuffer);
+	if (fstate.device.shaderSetUniformBuffer != NULL)
+		fstate.device.shaderSetUniformBuffer(shader, index, buffer);
+}
+
 void FosterShaderDestroy(FosterShader* shader)
 {
 	FOSTER_ASSERT_RUNNING(FosterShaderDestroy);
 	fstate.device.shaderDestroy(shader);
 }
 
+FosterUniformBuffer* FosterUniformBufferCreate(int size)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterUniformBufferCreate, NULL);
+	if (fstate.device.uniformBufferCreate == NULL)
+	{
+		FOSTER_LOG_ERROR("Uniform Buffers are not supported by the current Renderer");
+		return NULL;
+	}
+	return fstate.device.uniformBufferCreate(size);
+}
+
+void FosterUniformBufferSetData(FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset)
+{
+	FOSTER_ASSERT_RUNNING(FosterUniformBufferSetData);
+	fstate.device.uniformBufferSetData(buffer, data, dataSize, dataDestOffset);
+}
+
+void FosterUniformBufferDestroy(FosterUniformBuffer* buffer)
+{
+	FOSTER_ASSERT_RUNNING(FosterUniformBufferDestroy);
+	fstate.device.uniformBufferDestroy(buffer);
+}
+
 FosterMesh* FosterMeshCreate()
 {
 	FOSTER_ASSERT_RUNNING_RET(FosterMeshCreate, NULL);
 	return fstate.device.meshCreate();
 }
 
+FosterMesh* FosterMeshCreateStreaming()
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterMeshCreateStreaming, NULL);
+	if (fstate.device.meshCreateStreaming != NULL)
+		return fstate.device.meshCreateStreaming();
+	return fstate.device.meshCreate();
+}
+
 void FosterMeshSetVertexFormat(FosterMesh* mesh, FosterVertexFormat* format)
 {
 	FOSTER_ASSERT_RUNNING(FosterMeshSetVertexFormat);
@@ -680,6 +1114,39 @@ void FosterMeshSetVertexData(FosterMesh* mesh, void* data, int dataSize, int dat
 	fstate.device.meshSetVertexData(mesh, data, dataSize, dataDestOffset);
 }
 
+void* FosterMeshMapVertexData(FosterMesh* mesh, int dataSize, int dataDestOffset)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterMeshMapVertexData, NULL);
+	if (fstate.device.meshMapVertexData == NULL)
+		return NULL;
+	return fstate.device.meshMapVertexData(mesh, dataSize, dataDestOffset);
+}
+
+void FosterMeshUnmapVertexData(FosterMesh* mesh)
+{
+	FOSTER_ASSERT_RUNNING(FosterMeshUnmapVertexData);
+	if (fstate.device.meshUnmapVertexData != NULL)
+		fstate.device.meshUnmapVertexData(mesh);
+}
+
+void FosterMeshSetInstanceFormat(FosterMesh* mesh, FosterVertexFormat* format)
+{
+	FOSTER_ASSERT_RUNNING(FosterMeshSetInstanceFormat);
+	if (fstate.device.meshSetInstanceFormat == NULL)
+	{
+		FOSTER_LOG_ERROR("Mesh Instancing is not supported by the current Renderer");
+		return;
+	}
+	fstate.device.meshSetInstanceFormat(mesh, format);
+}
+
+void FosterMeshSetInstanceData(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FOSTER_ASSERT_RUNNING(FosterMeshSetInstanceData);
+	if (fstate.device.meshSetInstanceData != NULL)
+		fstate.device.meshSetInstanceData(mesh, data, dataSize, dataDestOffset);
+}
+
 void FosterMeshSetIndexFormat(FosterMesh* mesh, FosterIndexFormat format)
 {
 	FOSTER_ASSERT_RUNNING(FosterMeshSetIndexFormat);
@@ -692,16 +1159,139 @@ void FosterMeshSetIndexData(FosterMesh* mesh, void* data, int dataSize, int data
 	fstate.device.meshSetIndexData(mesh, data, dataSize, dataDestOffset);
 }
 
+void* FosterMeshMapIndexData(FosterMesh* mesh, int dataSize, int dataDestOffset)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterMeshMapIndexData, NULL);
+	if (fstate.device.meshMapIndexData == NULL)
+		return NULL;
+	return fstate.device.meshMapIndexData(mesh, dataSize, dataDestOffset);
+}
+
+void FosterMeshUnmapIndexData(FosterMesh* mesh)
+{
+	FOSTER_ASSERT_RUNNING(FosterMeshUnmapIndexData);
+	if (fstate.device.meshUnmapIndexData != NULL)
+		fstate.device.meshUnmapIndexData(mesh);
+}
+
+void FosterMeshSetQuadIndices(FosterMesh* mesh, int quadCount)
+{
+	FOSTER_ASSERT_RUNNING(FosterMeshSetQuadIndices);
+
+	if (fstate.device.meshSetQuadIndices != NULL)
+	{
+		fstate.device.meshSetQuadIndices(mesh, quadCount);
+		return;
+	}
+
+	// renderer doesn't share quad indices, so upload them to the mesh
+	int sixteenBit = quadCount <= FOSTER_MAX_QUADS_SIXTEEN_BIT;
+	int indexSize = sixteenBit ? 2 : 4;
+	void* data = SDL_malloc(quadCount * 6 * indexSize);
+	for (int i = 0; i < quadCount; i++)
+	{
+		uint32_t v = (uint32_t)i * 4;
+		uint32_t quad[6] = { v + 0, v + 1, v + 2, v + 0, v + 2, v + 3 };
+
+		for (int n = 0; n < 6; n++)
+		{
+			if (sixteenBit)
+				((uint16_t*)data)[i * 6 + n] = (uint16_t)quad[n];
+			else
+				((uint32_t*)data)[i * 6 + n] = quad[n];
+		}
+	}
+
+	fstate.device.meshSetIndexFormat(mesh, sixteenBit ? FOSTER_INDEX_FORMAT_SIXTEEN : FOSTER_INDEX_FORMAT_THIRTY_TWO);
+	fstate.device.meshSetIndexData(mesh, data, quadCount * 6 * indexSize, 0);
+	SDL_free(data);
+}
+
 void FosterMeshDestroy(FosterMesh* mesh)
 {
 	FOSTER_ASSERT_RUNNING(FosterMeshDestroy);
 	fstate.device.meshDestroy(mesh);
 }
 
+FosterPipeline* FosterPipelineCreate(FosterPipelineData* data)
+{
+	FOSTER_ASSERT_RUNNING_RET(FosterPipelineCreate, NULL);
+	if (fstate.device.pipelineCreate == NULL)
+	{
+		FOSTER_LOG_ERROR("Pipelines are not supported by the current Renderer");
+		return NULL;
+	}
+
+	if (data->shader == NULL)
+	{
+		FOSTER_LOG_ERROR("Pipelines must have a Shader");
+		return NULL;
+	}
+
+	if (data->vertexFormat.elementCount > FOSTER_MAX_VERTEX_FORMAT_ELEMENTS ||
+		data->instanceFormat.elementCount > FOSTER_MAX_VERTEX_FORMAT_ELEMENTS)
+	{
+		FOSTER_LOG_ERROR("Pipeline Vertex Format has too many elements");
+		return NULL;
+	}
+
+	return fstate.device.pipelineCreate(data);
+}
+
+void FosterPipelineDestroy(FosterPipeline* pipeline)
+{
+	FOSTER_ASSERT_RUNNING(FosterPipelineDestroy);
+	if (fstate.device.pipelineDestroy != NULL)
+		fstate.device.pipelineDestroy(pipeline);
+}
+
 void FosterDraw(FosterDrawCommand* command)
 {
 	FOSTER_ASSERT_RUNNING(FosterDraw);
+	FOSTER_TRACE_ZONE("FosterDraw");
 	fstate.device.draw(command);
+	FOSTER_TRACE_ZONE_END();
+}
+
+void FosterDrawBatch(FosterDrawCommand* commands, int count)
+{
+	FOSTER_ASSERT_RUNNING(FosterDrawBatch);
+
+	if (fstate.device.drawBatch)
+	{
+		fstate.device.drawBatch(commands, count);
+	}
+	else
+	{
+		for (int i = 0; i < count; i++)
+			fstate.device.draw(commands + i);
+	}
+}
+
+void FosterDrawList(FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount)
+{
+	FOSTER_ASSERT_RUNNING(FosterDrawList);
+
+	if (fstate.device.drawList)
+	{
+		fstate.device.drawList(command, ranges, rangeCount);
+	}
+	else
+	{
+		FosterDrawCommand range = *command;
+		for (int i = 0; i < rangeCount; i++)
+		{
+			if (ranges[i].baseVertex != 0)
+			{
+				FOSTER_LOG_ERROR("Draw Range Base Vertices are not supported by the current Renderer");
+				continue;
+			}
+
+			range.indexStart = ranges[i].indexStart;
+			range.indexCount = ranges[i].indexCount;
+			fstate.device.draw(&range);
+		}
+	}
 }
 
 void FosterClear(FosterClearCommand* clear)
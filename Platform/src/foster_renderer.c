@@ -1,4 +1,5 @@
 #include "foster_renderer.h"
+#include <string.h>
 
 bool FosterGetDevice(FosterRenderers preferred, FosterRenderDevice* device)
 {
@@ -27,3 +28,69 @@ bool FosterGetDevice(FosterRenderers preferred, FosterRenderDevice* device)
 
 	return false;
 }
+
+uint64_t FosterPipelineHash(uint64_t hash, const void* data, size_t length)
+{
+	// FNV-1a
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+void FosterPipelineStateInit(FosterPipelineState* state, FosterPipelineData* data)
+{
+	state->shader = data->shader;
+	state->compare = data->compare;
+	state->depthMask = data->depthMask;
+	state->cull = data->cull;
+	state->blend = data->blend;
+
+	uint64_t hash = 14695981039346656037ULL;
+	hash = FosterPipelineHash(hash, &state->shader, sizeof(state->shader));
+	hash = FosterPipelineHash(hash, &state->compare, sizeof(state->compare));
+	hash = FosterPipelineHash(hash, &state->depthMask, sizeof(state->depthMask));
+	hash = FosterPipelineHash(hash, &state->cull, sizeof(state->cull));
+	hash = FosterPipelineHash(hash, &state->blend, sizeof(state->blend));
+	state->hash = hash;
+}
+
+void FosterDrawCommandGetState(FosterDrawCommand* command, FosterPipelineState* state)
+{
+	if (command->pipeline != NULL)
+	{
+		*state = *(FosterPipelineState*)command->pipeline;
+		return;
+	}
+
+	state->hash = 0;
+	state->shader = command->shader;
+	state->compare = command->compare;
+	state->depthMask = command->depthMask;
+	state->cull = command->cull;
+	state->blend = command->blend;
+}
+
+bool FosterDrawCommandStateEqual(FosterDrawCommand* a, FosterDrawCommand* b)
+{
+	// the same Pipeline always has the same state
+	if (a->pipeline != NULL && a->pipeline == b->pipeline)
+		return true;
+
+	FosterPipelineState sa, sb;
+	FosterDrawCommandGetState(a, &sa);
+	FosterDrawCommandGetState(b, &sb);
+
+	if (a->pipeline != NULL && b->pipeline != NULL && sa.hash != sb.hash)
+		return false;
+
+	return
+		sa.shader == sb.shader &&
+		sa.compare == sb.compare &&
+		sa.depthMask == sb.depthMask &&
+		sa.cull == sb.cull &&
+		memcmp(&sa.blend, &sb.blend, sizeof(FosterBlend)) == 0;
+}
@@ -4,6 +4,18 @@
 #include "foster_platform.h"
 #include <stdbool.h>
 
+// The fixed-function state of a Pipeline. Every renderer's Pipeline begins
+// with this, so Draw Commands can be compared without knowing the renderer.
+typedef struct FosterPipelineState
+{
+	uint64_t hash;
+	FosterShader* shader;
+	FosterCompare compare;
+	int depthMask;
+	FosterCull cull;
+	FosterBlend blend;
+} FosterPipelineState;
+
 typedef struct FosterRenderDevice
 {
 	FosterRenderers renderer;
@@ -14,9 +26,23 @@ typedef struct FosterRenderDevice
 	void (*frameBegin)();
 	void (*frameEnd)();
 	
+	FosterBool (*textureFormatSupported)(FosterTextureFormat format);
 	FosterTexture* (*textureCreate)(int width, int height, FosterTextureFormat format);
+	FosterTexture* (*textureCreateArray)(int width, int height, int layers, FosterTextureFormat format);
 	void (*textureSetData)(FosterTexture* texture, void* data, int length);
+	void (*textureSetLayerData)(FosterTexture* texture, int layer, void* data, int length);
+	void (*textureSetLevelData)(FosterTexture* texture, int level, void* data, int length);
+	void (*textureGenerateMipmaps)(FosterTexture* texture);
+	void (*textureSetSubData)(FosterTexture* texture, FosterRect rect, void* data, int length);
+	FosterTextureUpload* (*textureUploadBegin)(FosterTexture* texture, FosterRect rect);
+	void* (*textureUploadGetData)(FosterTextureUpload* upload);
+	void (*textureUploadSubmit)(FosterTextureUpload* upload);
+	void (*textureUploadCancel)(FosterTextureUpload* upload);
 	void (*textureGetData)(FosterTexture* texture, void* data, int length);
+	FosterReadback* (*textureReadAsync)(FosterTexture* texture, FosterRect rect);
+	FosterBool (*readbackPoll)(FosterReadback* readback);
+	FosterBool (*readbackGet)(FosterReadback* readback, void* data, int length);
+	void (*readbackDestroy)(FosterReadback* readback);
 	void (*textureDestroy)(FosterTexture* texture);
 
 	FosterTarget* (*targetCreate)(int width, int height, FosterTextureFormat* formats, int format_count);
@@ -24,25 +50,65 @@ typedef struct FosterRenderDevice
 	void (*targetDestroy)(FosterTarget* target);
 
 	FosterShader* (*shaderCreate)(FosterShaderData* data);
+	FosterShader* (*shaderCreateAsync)(FosterShaderData* data);
+	FosterBool (*shaderIsReady)(FosterShader* shader);
+	FosterBool (*shaderWait)(FosterShader* shader);
 	void (*shaderSetUniform)(FosterShader* shader, int index, float* values);
 	void (*shaderSetTexture)(FosterShader* shader, int index, FosterTexture** values);
 	void (*shaderSetSampler)(FosterShader* shader, int index, FosterTextureSampler* values);
+	void (*shaderSetUniformBuffer)(FosterShader* shader, int index, FosterUniformBuffer* buffer);
 	void (*shaderGetUniforms)(FosterShader* shader, FosterUniformInfo* output, int* count, int max);
 	void (*shaderDestroy)(FosterShader* shader);
 
+	FosterUniformBuffer* (*uniformBufferCreate)(int size);
+	void (*uniformBufferSetData)(FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset);
+	void (*uniformBufferDestroy)(FosterUniformBuffer* buffer);
+
 	FosterMesh* (*meshCreate)();
+	FosterMesh* (*meshCreateStreaming)();
 	void (*meshSetVertexFormat)(FosterMesh* mesh, FosterVertexFormat* format);
 	void (*meshSetVertexData)(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+	void* (*meshMapVertexData)(FosterMesh* mesh, int dataSize, int dataDestOffset);
+	void (*meshUnmapVertexData)(FosterMesh* mesh);
+	void (*meshSetInstanceFormat)(FosterMesh* mesh, FosterVertexFormat* format);
+	void (*meshSetInstanceData)(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
 	void (*meshSetIndexFormat)(FosterMesh* mesh, FosterIndexFormat format);
 	void (*meshSetIndexData)(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset);
+	void (*meshSetQuadIndices)(FosterMesh* mesh, int quadCount);
+	void* (*meshMapIndexData)(FosterMesh* mesh, int dataSize, int dataDestOffset);
+	void (*meshUnmapIndexData)(FosterMesh* mesh);
 	void (*meshDestroy)(FosterMesh* mesh);
 
+	FosterPipeline* (*pipelineCreate)(FosterPipelineData* data);
+	void (*pipelineDestroy)(FosterPipeline* pipeline);
+
 	void (*draw)(FosterDrawCommand* command);
+	void (*drawBatch)(FosterDrawCommand* commands, int count);
+	void (*drawList)(FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount);
 	void (*clear)(FosterClearCommand* clear);
+
+	// optional GPU timing, where results are of the latest frame available
+	double (*gpuFrameTime)();
+	void (*gpuScopeBegin)(const char* name);
+	void (*gpuScopeEnd)();
+	int (*gpuScopes)(FosterGpuScope* output, int max);
+
+	// optional hint that a Target's contents are no longer needed
+	void (*targetDiscard)(FosterTarget* target);
 } FosterRenderDevice;
 
 bool FosterGetDevice(FosterRenderers preferred, FosterRenderDevice* device);
 bool FosterGetDevice_D3D11(FosterRenderDevice* device);
 bool FosterGetDevice_OpenGL(FosterRenderDevice* device);
 
+// Fills in a Pipeline's state from its data, hashing it so that Pipelines
+// with different state can be told apart without comparing every field
+void FosterPipelineStateInit(FosterPipelineState* state, FosterPipelineData* data);
+
+// Gets the fixed-function state used by a Draw Command, from its Pipeline if it has one
+void FosterDrawCommandGetState(FosterDrawCommand* command, FosterPipelineState* state);
+
+// If two Draw Commands use the same fixed-function state
+bool FosterDrawCommandStateEqual(FosterDrawCommand* a, FosterDrawCommand* b);
+
 #endif
@@ -32,6 +32,8 @@ typedef float            GLclampf;    /* single precision float in [0,1] */
 typedef double           GLdouble;    /* double precision float */
 typedef double           GLclampd;    /* double precision float in [0,1] */
 typedef char             GLchar;
+typedef uint64_t         GLuint64;
+typedef struct __GLsync* GLsync;
 
 // OpenGL Constants
 #define GL_DONT_CARE 0x1100
@@ -72,6 +74,12 @@ typedef char             GLchar;
 #define GL_POLYGON_OFFSET_FILL 0x8037
 #define GL_TEXTURE_2D 0x0DE1
 #define GL_TEXTURE_3D 0x806F
+#define GL_TEXTURE_2D_ARRAY 0x8C1A
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
 #define GL_TEXTURE_CUBE_MAP 0x8513
 #define GL_TEXTURE_CUBE_MAP_POSITIVE_X 0x8515
 #define GL_BLEND 0x0BE2
@@ -160,6 +168,7 @@ typedef char             GLchar;
 #define GL_TEXTURE_MAG_FILTER 0x2800
 #define GL_TEXTURE_MIN_FILTER 0x2801
 #define GL_TEXTURE_MAX_ANISOTROPY_EXT 0x84FE
+#define GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT 0x84FF
 #define GL_TEXTURE_BASE_LEVEL 0x813C
 #define GL_TEXTURE_MAX_LEVEL 0x813D
 #define GL_TEXTURE_LOD_BIAS 0x8501
@@ -173,8 +182,16 @@ typedef char             GLchar;
 #define GL_STREAM_DRAW 0x88E0
 #define GL_STATIC_DRAW 0x88E4
 #define GL_DYNAMIC_DRAW 0x88E8
+#define GL_COPY_READ_BUFFER 0x8F36
+#define GL_COPY_WRITE_BUFFER 0x8F37
+#define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+#define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#define GL_ACTIVE_UNIFORM_BLOCKS 0x8A36
 #define GL_MAX_VERTEX_ATTRIBS 0x8869
 #define GL_FRAMEBUFFER 0x8D40
+#define GL_MAJOR_VERSION 0x821B
+#define GL_MINOR_VERSION 0x821C
 #define GL_READ_FRAMEBUFFER 0x8CA8
 #define GL_DRAW_FRAMEBUFFER 0x8CA9
 #define GL_RENDERBUFFER 0x8D41
@@ -198,6 +215,7 @@ typedef char             GLchar;
 #define GL_FLOAT_VEC3 0x8B51
 #define GL_FLOAT_VEC4 0x8B52
 #define GL_SAMPLER_2D 0x8B5E
+#define GL_SAMPLER_2D_ARRAY 0x8DC1
 #define GL_FLOAT_MAT3x2 0x8B67
 #define GL_FLOAT_MAT4 0x8B5C
 #define GL_NUM_EXTENSIONS 0x821D
@@ -224,12 +242,35 @@ typedef char             GLchar;
 #define GL_DEBUG_OUTPUT_SYNCHRONOUS 0x8242
 #define GL_COMPILE_STATUS 0x8B81
 #define GL_LINK_STATUS 0x8B82
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#define GL_MAP_WRITE_BIT 0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT 0x0004
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#define GL_MAP_UNSYNCHRONIZED_BIT 0x0020
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_TIMEOUT_IGNORED 0xFFFFFFFFFFFFFFFFull
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_TIMEOUT_EXPIRED 0x911B
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_WAIT_FAILED 0x911D
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#define GL_STREAM_READ 0x88E1
+#define GL_MAP_READ_BIT 0x0001
+#define GL_TIMESTAMP 0x8E28
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
 
 // OpenGL Functions
 #define GL_FUNCTIONS \
 	GL_FUNC(DebugMessageCallback, void, DEBUGPROC callback, const void* userParam) \
 	GL_FUNC(GetString, const GLubyte*, GLenum name) \
 	GL_FUNC(Flush, void, void) \
+	GL_FUNC(Finish, void, void) \
 	GL_FUNC(Enable, void, GLenum mode) \
 	GL_FUNC(Disable, void, GLenum mode) \
 	GL_FUNC(Clear, void, GLenum mask) \
@@ -256,13 +297,27 @@ typedef char             GLchar;
 	GL_FUNC(BindRenderbuffer, void, GLenum target, GLuint id) \
 	GL_FUNC(BindFramebuffer, void, GLenum target, GLuint id) \
 	GL_FUNC(TexImage2D, void, GLenum target, GLint level, GLenum internalFormat, GLint width, GLint height, GLint border, GLenum format, GLenum type, const void* data) \
+	GL_FUNC(CompressedTexImage2D, void, GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void* data) \
+	GL_FUNC(TexImage3D, void, GLenum target, GLint level, GLenum internalFormat, GLint width, GLint height, GLint depth, GLint border, GLenum format, GLenum type, const void* data) \
+	GL_FUNC(TexSubImage3D, void, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* data) \
+	GL_FUNC(GenSamplers, void, GLsizei n, GLuint* samplers) \
+	GL_FUNC(DeleteSamplers, void, GLsizei n, const GLuint* samplers) \
+	GL_FUNC(BindSampler, void, GLuint unit, GLuint sampler) \
+	GL_FUNC(SamplerParameteri, void, GLuint sampler, GLenum name, GLint param) \
+	GL_FUNC(ReadPixels, void, GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void* data) \
+	GL_FUNC(ReadBuffer, void, GLenum mode) \
+	GL_FUNC(TexSubImage2D, void, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void* data) \
 	GL_FUNC(FramebufferRenderbuffer, void, GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) \
 	GL_FUNC(FramebufferTexture2D, void, GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) \
 	GL_FUNC(TexParameteri, void, GLenum target, GLenum name, GLint param) \
+	GL_FUNC(GenerateMipmap, void, GLenum target) \
 	GL_FUNC(RenderbufferStorage, void, GLenum target, GLenum internalformat, GLint width, GLint height) \
 	GL_FUNC(GetTexImage, void, GLenum target, GLint level, GLenum format, GLenum type, void* data) \
 	GL_FUNC(DrawElements, void, GLenum mode, GLint count, GLenum type, void* indices) \
 	GL_FUNC(DrawElementsInstanced, void, GLenum mode, GLint count, GLenum type, void* indices, GLint amount) \
+	GL_FUNC(DrawElementsBaseVertex, void, GLenum mode, GLsizei count, GLenum type, void* indices, GLint basevertex) \
+	GL_FUNC(DrawElementsInstancedBaseVertex, void, GLenum mode, GLsizei count, GLenum type, void* indices, GLsizei amount, GLint basevertex) \
+	GL_FUNC(MultiDrawElementsBaseVertex, void, GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount, const GLint* basevertex) \
 	GL_FUNC(DrawBuffers, void, GLsizei n, const GLenum* bufs) \
 	GL_FUNC(DeleteTextures, void, GLint n, GLuint* textures) \
 	GL_FUNC(DeleteRenderbuffers, void, GLint n, GLuint* renderbuffers) \
@@ -273,6 +328,18 @@ typedef char             GLchar;
 	GL_FUNC(BindBuffer, void, GLenum target, GLuint buffer) \
 	GL_FUNC(BufferData, void, GLenum target, GLsizeiptr size, const void* data, GLenum usage) \
 	GL_FUNC(BufferSubData, void, GLenum target, GLintptr offset, GLsizeiptr size, const void* data) \
+	GL_FUNC(MapBufferRange, void*, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) \
+	GL_FUNC(UnmapBuffer, GLboolean, GLenum target) \
+	GL_FUNC(CopyBufferSubData, void, GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) \
+	GL_FUNC(FenceSync, GLsync, GLenum condition, GLbitfield flags) \
+	GL_FUNC(ClientWaitSync, GLenum, GLsync sync, GLbitfield flags, GLuint64 timeout) \
+	GL_FUNC(DeleteSync, void, GLsync sync) \
+	GL_FUNC(GenQueries, void, GLsizei n, GLuint* ids) \
+	GL_FUNC(DeleteQueries, void, GLsizei n, const GLuint* ids) \
+	GL_FUNC(QueryCounter, void, GLuint id, GLenum target) \
+	GL_FUNC(GetQueryObjectiv, void, GLuint id, GLenum pname, GLint* params) \
+	GL_FUNC(GetQueryObjectui64v, void, GLuint id, GLenum pname, GLuint64* params) \
+	GL_FUNC(InvalidateFramebuffer, void, GLenum target, GLsizei numAttachments, const GLenum* attachments) \
 	GL_FUNC(DeleteBuffers, void, GLint n, GLuint* buffers) \
 	GL_FUNC(DeleteVertexArrays, void, GLint n, GLuint* arrays) \
 	GL_FUNC(EnableVertexAttribArray, void, GLuint location) \
@@ -290,9 +357,18 @@ typedef char             GLchar;
 	GL_FUNC(CreateProgram, GLuint, ) \
 	GL_FUNC(DeleteProgram, void, GLuint program) \
 	GL_FUNC(LinkProgram, void, GLuint program) \
+	GL_FUNC(ProgramParameteri, void, GLuint program, GLenum pname, GLint value) \
+	GL_FUNC(GetProgramBinary, void, GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary) \
+	GL_FUNC(ProgramBinary, void, GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) \
+	GL_FUNC(MaxShaderCompilerThreadsKHR, void, GLuint count) \
 	GL_FUNC(GetProgramiv, void, GLuint program, GLenum pname, GLint* result) \
 	GL_FUNC(GetProgramInfoLog, void, GLuint program, GLint maxLength, GLsizei* length, GLchar* infoLog) \
 	GL_FUNC(GetActiveUniform, void, GLuint program, GLuint index, GLint bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) \
+	GL_FUNC(GetActiveUniformsiv, void, GLuint program, GLsizei count, const GLuint* indices, GLenum pname, GLint* params) \
+	GL_FUNC(GetActiveUniformBlockiv, void, GLuint program, GLuint index, GLenum pname, GLint* params) \
+	GL_FUNC(GetActiveUniformBlockName, void, GLuint program, GLuint index, GLsizei bufSize, GLsizei* length, GLchar* name) \
+	GL_FUNC(UniformBlockBinding, void, GLuint program, GLuint index, GLuint binding) \
+	GL_FUNC(BindBufferBase, void, GLenum target, GLuint index, GLuint buffer) \
 	GL_FUNC(GetActiveAttrib, void, GLuint program, GLuint index, GLint bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) \
 	GL_FUNC(UseProgram, void, GLuint program) \
 	GL_FUNC(GetUniformLocation, GLint, GLuint program, const GLchar* name) \
@@ -353,7 +429,10 @@ typedef struct FosterTexture_OpenGL
 	GLuint id;
 	int width;
 	int height;
+	int layers;
+	int mipLevels;
 	FosterTextureFormat format;
+	GLenum glTarget;
 	GLenum glInternalFormat;
 	GLenum glFormat;
 	GLenum glType;
@@ -368,6 +447,52 @@ typedef struct FosterTexture_OpenGL
 	int disposed;
 } FosterTexture_OpenGL;
 
+// Asynchronous Texture uploads cycle through this many pixel buffers, so that
+// new uploads can be staged while the GPU is still copying previous ones
+#define FOSTER_TEXTURE_UPLOAD_SLOTS 4
+
+typedef struct FosterTextureUploadSlot_OpenGL
+{
+	GLuint id;
+	int size;
+	int mapped;
+	GLsync fence;
+} FosterTextureUploadSlot_OpenGL;
+
+typedef struct FosterTextureUpload_OpenGL
+{
+	FosterTexture_OpenGL* texture;
+	FosterRect rect;
+	int length;
+	void* data;
+
+	// the pixel buffer slot this upload was mapped from, or -1 if the data
+	// was allocated on the CPU because no pixel buffer was available
+	int slot;
+} FosterTextureUpload_OpenGL;
+
+typedef struct FosterReadback_OpenGL
+{
+	GLuint buffer;
+	GLsync fence;
+	int length;
+	int ready;
+
+	// used instead of the pixel buffer when buffers can't be mapped, in which
+	// case the read happens immediately
+	void* data;
+} FosterReadback_OpenGL;
+
+// Sampler objects are shared between every Texture, so there is one for each
+// unique sampler state that has been used
+#define FOSTER_MAX_SAMPLER_OBJECTS 64
+
+typedef struct FosterSamplerObject_OpenGL
+{
+	GLuint id;
+	FosterTextureSampler sampler;
+} FosterSamplerObject_OpenGL;
+
 typedef struct FosterTarget_OpenGL
 {
 	GLuint id;
@@ -386,18 +511,64 @@ typedef struct FosterUniform_OpenGL
 	GLsizei glSize;
 	GLenum glType;
 	int samplerIndex;
+	int bufferBinding;
 } FosterUniform_OpenGL;
 
+typedef struct FosterUniformBuffer_OpenGL
+{
+	GLuint id;
+	int size;
+
+	// Shaders hold on to assigned Uniform Buffers in the same way as Textures
+	int refCount;
+	int disposed;
+} FosterUniformBuffer_OpenGL;
+
 typedef struct FosterShader_OpenGL
 {
 	GLuint id;
+
+	// shaders that are still compiling, when created asynchronously
+	GLuint pendingVertex;
+	GLuint pendingFragment;
+	Uint64 cacheKey;
+	int pending;
+	int failed;
+
 	GLint uniformCount;
 	GLint samplerCount;
+	GLint uniformBufferCount;
 	FosterUniform_OpenGL* uniforms;
 	FosterTexture_OpenGL* textures[FOSTER_MAX_UNIFORM_TEXTURES];
 	FosterTextureSampler samplers[FOSTER_MAX_UNIFORM_TEXTURES];
+	FosterUniformBuffer_OpenGL* uniformBuffers[FOSTER_MAX_UNIFORM_BUFFERS];
 } FosterShader_OpenGL;
 
+// Streaming Meshes cycle through this many sets of buffers, so that new data
+// can be written while the GPU is still reading from previous frames
+#define FOSTER_MESH_STREAM_SLOTS 3
+
+typedef struct FosterMeshStreamSlot_OpenGL
+{
+	GLuint id;
+	GLuint indexBuffer;
+	GLuint vertexBuffer;
+	GLuint instanceBuffer;
+	int vertexBufferSize;
+	int indexBufferSize;
+	int instanceBufferSize;
+	int instanceStart;
+	GLsync fence;
+} FosterMeshStreamSlot_OpenGL;
+
+// which of a Mesh's buffers is being written to
+typedef enum FosterMeshBuffer_OpenGL
+{
+	FOSTER_MESH_BUFFER_VERTEX,
+	FOSTER_MESH_BUFFER_INDEX,
+	FOSTER_MESH_BUFFER_INSTANCE,
+} FosterMeshBuffer_OpenGL;
+
 typedef struct FosterMesh_OpenGL
 {
 	GLuint id;
@@ -412,8 +583,57 @@ typedef struct FosterMesh_OpenGL
 	int indexSize;
 	int vertexBufferSize;
 	int indexBufferSize;
+	int instanceBufferSize;
+
+	// Instance attributes are pointed at the first instance being drawn, as
+	// there's no way to offset instances when drawing in OpenGL 3.3
+	FosterVertexFormatElement instanceElements[32];
+	FosterVertexFormat instanceFormat;
+	int instanceStart;
+
+	// Streaming Meshes swap the above id & buffers with the next slot when
+	// they are written to after having been drawn
+	int vertexMapped;
+	int indexMapped;
+	int streaming;
+	int streamSlot;
+	int streamSlotDrawn;
+	FosterMeshStreamSlot_OpenGL streamSlots[FOSTER_MESH_STREAM_SLOTS];
 } FosterMesh_OpenGL;
 
+#define FOSTER_GPU_TIMING_FRAMES 4
+#define FOSTER_MAX_GPU_SCOPES 32
+#define FOSTER_MAX_GPU_SCOPE_DEPTH 16
+#define FOSTER_MAX_GPU_SCOPE_NAME 32
+
+// Scopes are timed with a timestamp at each end, instead of GL_TIME_ELAPSED
+// queries, as those can't be nested
+typedef struct FosterGpuScope_OpenGL
+{
+	char name[FOSTER_MAX_GPU_SCOPE_NAME];
+	int depth;
+	GLuint begin;
+	GLuint end;
+} FosterGpuScope_OpenGL;
+
+// The timing of a frame is read back a few frames later, once the GPU
+// has finished it, so that reading it never stalls
+typedef struct FosterGpuFrame_OpenGL
+{
+	GLuint begin;
+	GLuint end;
+	int pending;
+	int scopeCount;
+	FosterGpuScope_OpenGL scopes[FOSTER_MAX_GPU_SCOPES];
+} FosterGpuFrame_OpenGL;
+
+// Vertex formats belong to each Mesh's Vertex Array in OpenGL, so a
+// Pipeline only holds the fixed-function state
+typedef struct FosterPipeline_OpenGL
+{
+	FosterPipelineState state;
+} FosterPipeline_OpenGL;
+
 typedef struct
 {
 	// GL function pointers
@@ -428,6 +648,8 @@ typedef struct
 	int stateInitializing;
 	int stateActiveTextureSlot;
 	GLuint stateTextureSlots[FOSTER_MAX_UNIFORM_TEXTURES];
+	GLuint stateSamplerSlots[FOSTER_MAX_UNIFORM_TEXTURES];
+	GLuint stateUniformBuffers[FOSTER_MAX_UNIFORM_BUFFERS];
 	GLuint stateProgram;
 	GLuint stateFrameBuffer;
 	GLuint stateVertexArray;
@@ -443,6 +665,74 @@ typedef struct
 	FosterBlend stateBlend;
 	int stateDepthMask;
 
+	// whether buffers can be written to with glMapBufferRange
+	int supportsBufferMapping;
+
+	// whether sampler state is applied with sampler objects, instead of
+	// being assigned to each Texture
+	int supportsSamplerObjects;
+
+	// whether linked programs are cached to disk with glGetProgramBinary,
+	// and a hash of the driver that wrote them
+	int supportsProgramBinary;
+	Uint64 programBinaryDriver;
+
+	// whether shader compile status can be polled without blocking
+	int supportsParallelShaderCompile;
+
+	// whether the GPU time of frames and scopes can be measured with timestamp queries
+	int supportsTimerQueries;
+
+	// whether the CPU can wait on fences for the GPU to finish frames
+	int supportsFrameFences;
+
+	// whether Target contents can be discarded with glInvalidateFramebuffer,
+	// which saves tile-based GPUs from writing them back to memory
+	int supportsInvalidateFramebuffer;
+
+	// compressed texture formats, which depend on the driver
+	int supportsS3TC;
+	int supportsBPTC;
+	int supportsETC2;
+	int supportsASTC;
+	FosterSamplerObject_OpenGL samplerObjects[FOSTER_MAX_SAMPLER_OBJECTS];
+	int samplerObjectCount;
+
+	// index buffers shared by every Mesh that only draws quads
+	GLuint quadIndexBuffer16;
+	GLuint quadIndexBuffer32;
+	int quadIndexCapacity16;
+	int quadIndexCapacity32;
+
+	// pixel buffers used by asynchronous Texture uploads
+	FosterTextureUploadSlot_OpenGL uploadSlots[FOSTER_TEXTURE_UPLOAD_SLOTS];
+	int uploadSlotNext;
+
+	// frame buffer used to read back the contents of Textures
+	GLuint readbackFrameBuffer;
+
+	// ring of frames being timed on the GPU, and the latest results
+	FosterGpuFrame_OpenGL gpuFrames[FOSTER_GPU_TIMING_FRAMES];
+	int gpuFrameIndex;
+	int gpuFrameTiming;
+	int gpuScopeStack[FOSTER_MAX_GPU_SCOPE_DEPTH];
+	int gpuScopeDepth;
+	double gpuFrameTime;
+	FosterGpuScope gpuScopeResults[FOSTER_MAX_GPU_SCOPES];
+	char gpuScopeResultNames[FOSTER_MAX_GPU_SCOPES][FOSTER_MAX_GPU_SCOPE_NAME];
+	int gpuScopeResultCount;
+
+	// ring of fences inserted after each swap, used to limit queued frames
+	GLsync frameFences[FOSTER_MAX_QUEUED_FRAMES];
+	int frameFenceIndex;
+
+	// scratch memory used to submit multiple index ranges in one draw
+	FosterDrawRange* drawRanges;
+	GLsizei* drawCounts;
+	void** drawOffsets;
+	GLint* drawBaseVertices;
+	int drawRangeCapacity;
+
 	// info
 	int max_color_attachments;
 	int max_element_indices;
@@ -451,6 +741,8 @@ typedef struct
 	int max_samples;
 	int max_texture_image_units;
 	int max_texture_size;
+	int max_array_texture_layers;
+	int max_texture_anisotropy;
 } FosterOpenGLState;
 
 static FosterOpenGLState fgl;
@@ -510,6 +802,20 @@ GLenum FosterWrapToGL(FosterTextureWrap wrap)
 	}
 }
 
+// FNV-1a, used to key cached data
+#define FOSTER_HASH_SEED 14695981039346656037ULL
+
+Uint64 FosterHash_OpenGL(Uint64 hash, const void* data, size_t length)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	for (size_t i = 0; i < length; i ++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
 GLenum FosterFilterToGL(FosterTextureFilter filter)
 {
 	switch (filter)
@@ -520,6 +826,26 @@ GLenum FosterFilterToGL(FosterTextureFilter filter)
 	}
 }
 
+GLenum FosterMinFilterToGL(FosterTextureFilter filter, FosterTextureMipFilter mipFilter)
+{
+	int linear = filter == FOSTER_TEXTURE_FILTER_LINEAR;
+
+	switch (mipFilter)
+	{
+		case FOSTER_TEXTURE_MIP_FILTER_NEAREST: return linear ? GL_LINEAR_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_NEAREST;
+		case FOSTER_TEXTURE_MIP_FILTER_LINEAR: return linear ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR;
+		default: return FosterFilterToGL(filter);
+	}
+}
+
+// clamps the requested anisotropy to what the driver supports, where 1 is off
+int FosterAnisotropyToGL(int anisotropy)
+{
+	if (anisotropy > fgl.max_texture_anisotropy)
+		anisotropy = fgl.max_texture_anisotropy;
+	return anisotropy < 1 ? 1 : anisotropy;
+}
+
 GLenum FosterBlendOpToGL(FosterBlendOp operation)
 {
 	switch (operation)
@@ -572,12 +898,18 @@ FosterUniformType FosterUniformTypeFromGL(GLenum value)
 		case GL_FLOAT_MAT3x2: return FOSTER_UNIFORM_TYPE_MAT3X2;
 		case GL_FLOAT_MAT4: return FOSTER_UNIFORM_TYPE_MAT4X4;
 		case GL_SAMPLER_2D: return FOSTER_UNIFORM_TYPE_SAMPLER2D;
+		case GL_SAMPLER_2D_ARRAY: return FOSTER_UNIFORM_TYPE_SAMPLER2D;
 	};
 
 	return FOSTER_UNIFORM_TYPE_NONE;
 }
 
-GLuint FosterMeshAssignAttributes_OpenGL(GLuint buffer, GLenum bufferType, FosterVertexFormat* format, GLint divisor)
+int FosterIsSamplerType_OpenGL(GLenum value)
+{
+	return value == GL_SAMPLER_2D || value == GL_SAMPLER_2D_ARRAY;
+}
+
+GLuint FosterMeshAssignAttributes_OpenGL(GLuint buffer, GLenum bufferType, FosterVertexFormat* format, GLint divisor, size_t offset)
 {
 	// bind
 	switch (bufferType)
@@ -605,7 +937,7 @@ GLuint FosterMeshAssignAttributes_OpenGL(GLuint buffer, GLenum bufferType, Foste
 	// ...
 
 	// enable attributes
-	size_t ptr = 0;
+	size_t ptr = offset;
 	for (int n = 0; n < format->elementCount; n++)
 	{
 		FosterVertexFormatElement element = format->elements[n];
@@ -711,25 +1043,34 @@ void FosterBindFrameBuffer(FosterTarget_OpenGL* target)
 			fgl.glDrawBuffers(target->colorAttachmentCount, attachments);
 		}
 
+		FOSTER_STAT_ADD(stateChanges, 1);
+	}
+	else
+	{
+		FOSTER_STAT_ADD(stateChangesSkipped, 1);
 	}
 	fgl.stateFrameBuffer = framebuffer;
 }
 
 void FosterBindProgram(GLuint id)
 {
-	if (fgl.stateInitializing || fgl.stateProgram != id)
+	int changed = fgl.stateInitializing || fgl.stateProgram != id;
+	if (changed)
 		fgl.glUseProgram(id);
+	FOSTER_STAT_STATE(changed);
 	fgl.stateProgram = id;
 }
 
 void FosterBindArray(GLuint id)
 {
-	if (fgl.stateInitializing || fgl.stateVertexArray != id)
+	int changed = fgl.stateInitializing || fgl.stateVertexArray != id;
+	if (changed)
 		fgl.glBindVertexArray(id);
+	FOSTER_STAT_STATE(changed);
 	fgl.stateVertexArray = id;
 }
 
-void FosterBindTexture(int slot, GLuint id)
+void FosterBindTexture(int slot, GLenum target, GLuint id)
 {
 	if (fgl.stateActiveTextureSlot != slot)
 	{
@@ -739,14 +1080,15 @@ void FosterBindTexture(int slot, GLuint id)
 
 	if (fgl.stateTextureSlots[slot] != id)
 	{
-		fgl.glBindTexture(GL_TEXTURE_2D, id);
+		fgl.glBindTexture(target, id);
 		fgl.stateTextureSlots[slot] = id;
+		FOSTER_STAT_ADD(textureBinds, 1);
 	}
 }
 
 // Same as FosterBindTexture, except it the resulting global state doesn't
 // necessarily have the slot active or texture bound, if no changes were required.
-void FosterEnsureTextureSlotIs(int slot, GLuint id)
+void FosterEnsureTextureSlotIs(int slot, GLenum target, GLuint id)
 {
 	if (fgl.stateTextureSlots[slot] != id)
 	{
@@ -756,9 +1098,58 @@ void FosterEnsureTextureSlotIs(int slot, GLuint id)
 			fgl.stateActiveTextureSlot = slot;
 		}
 
-		fgl.glBindTexture(GL_TEXTURE_2D, id);
+		fgl.glBindTexture(target, id);
 		fgl.stateTextureSlots[slot] = id;
+		FOSTER_STAT_ADD(textureBinds, 1);
+	}
+}
+
+GLuint FosterGetSamplerObject(FosterTextureSampler sampler)
+{
+	for (int i = 0; i < fgl.samplerObjectCount; i ++)
+	{
+		FosterSamplerObject_OpenGL* it = &fgl.samplerObjects[i];
+		if (it->sampler.filter == sampler.filter &&
+			it->sampler.wrapX == sampler.wrapX &&
+			it->sampler.wrapY == sampler.wrapY &&
+			it->sampler.mipFilter == sampler.mipFilter &&
+			it->sampler.anisotropy == sampler.anisotropy)
+			return it->id;
+	}
+
+	if (fgl.samplerObjectCount >= FOSTER_MAX_SAMPLER_OBJECTS)
+	{
+		FOSTER_LOG_ERROR("Exceeded Max Sampler Objects of %i", FOSTER_MAX_SAMPLER_OBJECTS);
+		return 0;
+	}
+
+	GLuint id = 0;
+	fgl.glGenSamplers(1, &id);
+	if (id == 0)
+		return 0;
+
+	fgl.glSamplerParameteri(id, GL_TEXTURE_MIN_FILTER, FosterMinFilterToGL(sampler.filter, sampler.mipFilter));
+	fgl.glSamplerParameteri(id, GL_TEXTURE_MAG_FILTER, FosterFilterToGL(sampler.filter));
+	fgl.glSamplerParameteri(id, GL_TEXTURE_WRAP_S, FosterWrapToGL(sampler.wrapX));
+	fgl.glSamplerParameteri(id, GL_TEXTURE_WRAP_T, FosterWrapToGL(sampler.wrapY));
+	if (fgl.max_texture_anisotropy > 0)
+		fgl.glSamplerParameteri(id, GL_TEXTURE_MAX_ANISOTROPY_EXT, FosterAnisotropyToGL(sampler.anisotropy));
+
+	FosterSamplerObject_OpenGL* it = &fgl.samplerObjects[fgl.samplerObjectCount++];
+	it->id = id;
+	it->sampler = sampler;
+	return id;
+}
+
+void FosterEnsureSamplerSlotIs(int slot, GLuint id)
+{
+	int changed = fgl.stateSamplerSlots[slot] != id;
+	if (changed)
+	{
+		fgl.glBindSampler(slot, id);
+		fgl.stateSamplerSlots[slot] = id;
 	}
+	FOSTER_STAT_STATE(changed);
 }
 
 void FosterSetTextureSampler(FosterTexture_OpenGL* tex, FosterTextureSampler sampler)
@@ -766,21 +1157,26 @@ void FosterSetTextureSampler(FosterTexture_OpenGL* tex, FosterTextureSampler sam
 	if (!tex->disposed && (
 		tex->sampler.filter != sampler.filter ||
 		tex->sampler.wrapX != sampler.wrapX ||
-		tex->sampler.wrapY != sampler.wrapY))
+		tex->sampler.wrapY != sampler.wrapY ||
+		tex->sampler.mipFilter != sampler.mipFilter ||
+		tex->sampler.anisotropy != sampler.anisotropy))
 	{
-		FosterBindTexture(0, tex->id);
+		FosterBindTexture(0, tex->glTarget, tex->id);
 
-		if (tex->sampler.filter != sampler.filter)
+		if (tex->sampler.filter != sampler.filter || tex->sampler.mipFilter != sampler.mipFilter)
 		{
-			fgl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, FosterFilterToGL(sampler.filter));
-			fgl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, FosterFilterToGL(sampler.filter));
+			fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_MIN_FILTER, FosterMinFilterToGL(sampler.filter, sampler.mipFilter));
+			fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_MAG_FILTER, FosterFilterToGL(sampler.filter));
 		}
 
+		if (tex->sampler.anisotropy != sampler.anisotropy && fgl.max_texture_anisotropy > 0)
+			fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_MAX_ANISOTROPY_EXT, FosterAnisotropyToGL(sampler.anisotropy));
+
 		if (tex->sampler.wrapX != sampler.wrapX)
-			fgl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, FosterWrapToGL(sampler.wrapX));
+			fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_WRAP_S, FosterWrapToGL(sampler.wrapX));
 
 		if (tex->sampler.wrapY != sampler.wrapY)
-			fgl.glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, FosterWrapToGL(sampler.wrapY));
+			fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_WRAP_T, FosterWrapToGL(sampler.wrapY));
 
 		tex->sampler = sampler;
 	}
@@ -823,11 +1219,13 @@ void FosterSetViewport(int enabled, FosterRect rect)
 		viewport.h = fgl.stateFrameBufferHeight;
 	}
 
-	if (fgl.stateInitializing || !FOSTER_RECT_EQUAL(viewport, fgl.stateViewport))
+	int changed = fgl.stateInitializing || !FOSTER_RECT_EQUAL(viewport, fgl.stateViewport);
+	if (changed)
 	{
 		fgl.glViewport((GLint)viewport.x, (GLint)viewport.y, (GLint)viewport.w, (GLint)viewport.h);
 		fgl.stateViewport = viewport;
 	}
+	FOSTER_STAT_STATE(changed);
 }
 
 void FosterSetScissor(int enabled, FosterRect rect)
@@ -839,9 +1237,12 @@ void FosterSetScissor(int enabled, FosterRect rect)
 	if (scissor.h < 0) scissor.h = 0;
 
 	// toggle scissor
-	if (fgl.stateInitializing ||
+	int changed = fgl.stateInitializing ||
 		enabled != fgl.stateHasScissor ||
-		(enabled && !FOSTER_RECT_EQUAL(scissor, fgl.stateScissor)))
+		(enabled && !FOSTER_RECT_EQUAL(scissor, fgl.stateScissor));
+	FOSTER_STAT_STATE(changed);
+
+	if (changed)
 	{
 		if (enabled)
 		{
@@ -861,10 +1262,13 @@ void FosterSetScissor(int enabled, FosterRect rect)
 
 void FosterSetBlend(const FosterBlend* blend)
 {
+	int changed = 0;
+
 	if (fgl.stateInitializing ||
 		fgl.stateBlend.colorOp != blend->colorOp ||
 		fgl.stateBlend.alphaOp != blend->alphaOp)
 	{
+		changed = 1;
 		GLenum colorOp = FosterBlendOpToGL(blend->colorOp);
 		GLenum alphaOp = FosterBlendOpToGL(blend->alphaOp);
 		fgl.glBlendEquationSeparate(colorOp, alphaOp);
@@ -876,6 +1280,7 @@ void FosterSetBlend(const FosterBlend* blend)
 		fgl.stateBlend.alphaSrc != blend->alphaSrc ||
 		fgl.stateBlend.alphaDst != blend->alphaDst)
 	{
+		changed = 1;
 		GLenum colorSrc = FosterBlendFactorToGL(blend->colorSrc);
 		GLenum colorDst = FosterBlendFactorToGL(blend->colorDst);
 		GLenum alphaSrc = FosterBlendFactorToGL(blend->alphaSrc);
@@ -885,6 +1290,7 @@ void FosterSetBlend(const FosterBlend* blend)
 
 	if (fgl.stateInitializing || fgl.stateBlend.mask != blend->mask)
 	{
+		changed = 1;
 		fgl.glColorMask(
 			((int)blend->mask & (int)FOSTER_BLEND_MASK_R),
 			((int)blend->mask & (int)FOSTER_BLEND_MASK_G),
@@ -894,6 +1300,7 @@ void FosterSetBlend(const FosterBlend* blend)
 
 	if (fgl.stateInitializing || fgl.stateBlend.rgba != blend->rgba)
 	{
+		changed = 1;
 		unsigned char r = blend->rgba >> 24;
 		unsigned char g = blend->rgba >> 16;
 		unsigned char b = blend->rgba >> 8;
@@ -906,6 +1313,7 @@ void FosterSetBlend(const FosterBlend* blend)
 			a / 255.0f);
 	}
 
+	FOSTER_STAT_STATE(changed);
 	fgl.stateBlend = *blend;
 }
 
@@ -937,6 +1345,7 @@ void FosterSetCompare(FosterCompare compare)
 		}
 	}
 
+	FOSTER_STAT_STATE(fgl.stateInitializing || compare != fgl.stateCompare);
 	fgl.stateCompare = compare;
 }
 
@@ -950,6 +1359,7 @@ void FosterSetDepthMask(int depthMask)
 			fgl.glDepthMask(0);
 	}
 
+	FOSTER_STAT_STATE(fgl.stateInitializing || depthMask != fgl.stateDepthMask);
 	fgl.stateDepthMask = depthMask;
 }
 
@@ -975,6 +1385,7 @@ void FosterSetCull(FosterCull cull)
 		}
 	}
 
+	FOSTER_STAT_STATE(fgl.stateInitializing || cull != fgl.stateCull);
 	fgl.stateCull = cull;
 }
 
@@ -1028,6 +1439,96 @@ bool FosterInitialize_OpenGL()
 		fgl.glDebugMessageCallback(FosterMessage_OpenGL, NULL);
 	}
 
+	// WebGL doesn't support mapping buffers, and the emulated path is slower
+	// than simply using glBufferSubData
+	#ifdef __EMSCRIPTEN__
+		fgl.supportsBufferMapping = 0;
+	#else
+		fgl.supportsBufferMapping =
+			fgl.glMapBufferRange != NULL && fgl.glUnmapBuffer != NULL &&
+			fgl.glFenceSync != NULL && fgl.glClientWaitSync != NULL && fgl.glDeleteSync != NULL;
+	#endif
+
+	fgl.supportsFrameFences =
+		fgl.glFenceSync != NULL && fgl.glClientWaitSync != NULL && fgl.glDeleteSync != NULL;
+
+	fgl.supportsSamplerObjects =
+		fgl.glGenSamplers != NULL && fgl.glDeleteSamplers != NULL &&
+		fgl.glBindSampler != NULL && fgl.glSamplerParameteri != NULL;
+
+	// ETC2 is core in GLES 3 / WebGL 2, but desktop drivers only expose it through ES3 compatibility
+	if (fgl.glCompressedTexImage2D != NULL)
+	{
+		fgl.supportsS3TC =
+			SDL_GL_ExtensionSupported("GL_EXT_texture_compression_s3tc") ||
+			SDL_GL_ExtensionSupported("GL_WEBGL_compressed_texture_s3tc");
+		fgl.supportsBPTC =
+			SDL_GL_ExtensionSupported("GL_ARB_texture_compression_bptc") ||
+			SDL_GL_ExtensionSupported("GL_EXT_texture_compression_bptc");
+		fgl.supportsETC2 =
+			SDL_GL_ExtensionSupported("GL_ARB_ES3_compatibility") ||
+			SDL_GL_ExtensionSupported("GL_WEBGL_compressed_texture_etc");
+		fgl.supportsASTC =
+			SDL_GL_ExtensionSupported("GL_KHR_texture_compression_astc_ldr") ||
+			SDL_GL_ExtensionSupported("GL_WEBGL_compressed_texture_astc");
+	}
+
+	// program binaries are only valid for the exact driver that created them,
+	// and WebGL doesn't expose them at all
+	#ifdef __EMSCRIPTEN__
+		fgl.supportsProgramBinary = 0;
+	#else
+	{
+		GLint formats = 0;
+		if (fgl.glGetProgramBinary != NULL && fgl.glProgramBinary != NULL && fgl.glProgramParameteri != NULL)
+			fgl.glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		fgl.supportsProgramBinary = formats > 0 && FosterGetUserPath() != NULL;
+	}
+	#endif
+
+	// timestamps are core in OpenGL 3.3, but WebGL only exposes them behind
+	// an extension that browsers often disable
+	#ifdef __EMSCRIPTEN__
+		fgl.supportsTimerQueries = 0;
+	#else
+		fgl.supportsTimerQueries =
+			fgl.glGenQueries != NULL && fgl.glDeleteQueries != NULL && fgl.glQueryCounter != NULL &&
+			fgl.glGetQueryObjectiv != NULL && fgl.glGetQueryObjectui64v != NULL;
+	#endif
+	fgl.gpuFrameTime = -1;
+
+	// invalidation is core in OpenGL ES 3.0 / WebGL 2, but only OpenGL 4.3 on desktop
+	#ifdef __EMSCRIPTEN__
+		fgl.supportsInvalidateFramebuffer = fgl.glInvalidateFramebuffer != NULL;
+	#else
+	{
+		GLint major = 0, minor = 0;
+		fgl.glGetIntegerv(GL_MAJOR_VERSION, &major);
+		fgl.glGetIntegerv(GL_MINOR_VERSION, &minor);
+		fgl.supportsInvalidateFramebuffer = fgl.glInvalidateFramebuffer != NULL &&
+			(major > 4 || (major == 4 && minor >= 3) || SDL_GL_ExtensionSupported("GL_ARB_invalidate_subdata"));
+	}
+	#endif
+
+	fgl.supportsParallelShaderCompile =
+		SDL_GL_ExtensionSupported("GL_KHR_parallel_shader_compile") ||
+		SDL_GL_ExtensionSupported("GL_ARB_parallel_shader_compile");
+
+	// let the driver pick how many threads to compile with
+	if (fgl.supportsParallelShaderCompile && fgl.glMaxShaderCompilerThreadsKHR != NULL)
+		fgl.glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+
+	if (fgl.supportsProgramBinary)
+	{
+		const char* vendor = (const char*)fgl.glGetString(GL_VENDOR);
+		const char* renderer = (const char*)fgl.glGetString(GL_RENDERER);
+		const char* version = (const char*)fgl.glGetString(GL_VERSION);
+
+		fgl.programBinaryDriver = FosterHash_OpenGL(FOSTER_HASH_SEED, vendor, vendor ? SDL_strlen(vendor) : 0);
+		fgl.programBinaryDriver = FosterHash_OpenGL(fgl.programBinaryDriver, renderer, renderer ? SDL_strlen(renderer) : 0);
+		fgl.programBinaryDriver = FosterHash_OpenGL(fgl.programBinaryDriver, version, version ? SDL_strlen(version) : 0);
+	}
+
 	// get opengl info
 	fgl.glGetIntegerv(0x8CDF, &fgl.max_color_attachments);
 	fgl.glGetIntegerv(0x80E9, &fgl.max_element_indices);
@@ -1036,6 +1537,13 @@ bool FosterInitialize_OpenGL()
 	fgl.glGetIntegerv(0x8D57, &fgl.max_samples);
 	fgl.glGetIntegerv(0x8872, &fgl.max_texture_image_units);
 	fgl.glGetIntegerv(0x0D33, &fgl.max_texture_size);
+	fgl.glGetIntegerv(0x88FF, &fgl.max_array_texture_layers);
+
+	// anisotropic filtering is an extension everywhere except GL 4.6
+	fgl.max_texture_anisotropy = 0;
+	if (SDL_GL_ExtensionSupported("GL_EXT_texture_filter_anisotropic") ||
+		SDL_GL_ExtensionSupported("GL_ARB_texture_filter_anisotropic"))
+		fgl.glGetIntegerv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &fgl.max_texture_anisotropy);
 
 	// don't include row padding
 	fgl.glPixelStorei(GL_PACK_ALIGNMENT, 1);
@@ -1070,6 +1578,8 @@ bool FosterInitialize_OpenGL()
 	fgl.glActiveTexture(GL_TEXTURE0);
 	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
 		fgl.stateTextureSlots[i] = 0;
+	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
+		fgl.stateSamplerSlots[i] = 0;
 
 	// log
 	FOSTER_LOG_INFO("OpenGL: v%s, %s", fgl.glGetString(GL_VERSION), fgl.glGetString(GL_RENDERER));
@@ -1078,13 +1588,175 @@ bool FosterInitialize_OpenGL()
 
 void FosterShutdown_OpenGL()
 {
+	if (fgl.quadIndexBuffer16 != 0)
+		fgl.glDeleteBuffers(1, &fgl.quadIndexBuffer16);
+	if (fgl.quadIndexBuffer32 != 0)
+		fgl.glDeleteBuffers(1, &fgl.quadIndexBuffer32);
+	fgl.quadIndexBuffer16 = fgl.quadIndexBuffer32 = 0;
+	fgl.quadIndexCapacity16 = fgl.quadIndexCapacity32 = 0;
+
+	for (int i = 0; i < fgl.samplerObjectCount; i ++)
+		fgl.glDeleteSamplers(1, &fgl.samplerObjects[i].id);
+	fgl.samplerObjectCount = 0;
+
+	if (fgl.readbackFrameBuffer != 0)
+		fgl.glDeleteFramebuffers(1, &fgl.readbackFrameBuffer);
+	fgl.readbackFrameBuffer = 0;
+
+	SDL_free(fgl.drawRanges);
+	SDL_free(fgl.drawCounts);
+	SDL_free(fgl.drawOffsets);
+	SDL_free(fgl.drawBaseVertices);
+	fgl.drawRanges = NULL;
+	fgl.drawCounts = NULL;
+	fgl.drawOffsets = NULL;
+	fgl.drawBaseVertices = NULL;
+	fgl.drawRangeCapacity = 0;
+
+	for (int i = 0; i < FOSTER_TEXTURE_UPLOAD_SLOTS; i ++)
+	{
+		FosterTextureUploadSlot_OpenGL* slot = &fgl.uploadSlots[i];
+		if (slot->fence != NULL)
+			fgl.glDeleteSync(slot->fence);
+		if (slot->id != 0)
+			fgl.glDeleteBuffers(1, &slot->id);
+		slot->fence = NULL;
+		slot->id = 0;
+		slot->size = 0;
+		slot->mapped = 0;
+	}
+
+	for (int i = 0; i < FOSTER_GPU_TIMING_FRAMES; i ++)
+	{
+		FosterGpuFrame_OpenGL* frame = &fgl.gpuFrames[i];
+		if (frame->begin != 0)
+			fgl.glDeleteQueries(1, &frame->begin);
+		if (frame->end != 0)
+			fgl.glDeleteQueries(1, &frame->end);
+		for (int j = 0; j < FOSTER_MAX_GPU_SCOPES; j ++)
+		{
+			if (frame->scopes[j].begin != 0)
+				fgl.glDeleteQueries(1, &frame->scopes[j].begin);
+			if (frame->scopes[j].end != 0)
+				fgl.glDeleteQueries(1, &frame->scopes[j].end);
+		}
+	}
+	SDL_memset(fgl.gpuFrames, 0, sizeof(fgl.gpuFrames));
+
+	for (int i = 0; i < FOSTER_MAX_QUEUED_FRAMES; i ++)
+	{
+		if (fgl.frameFences[i] != NULL)
+			fgl.glDeleteSync(fgl.frameFences[i]);
+		fgl.frameFences[i] = NULL;
+	}
+	fgl.frameFenceIndex = 0;
+	fgl.gpuFrameTiming = 0;
+	fgl.gpuScopeDepth = 0;
+	fgl.gpuScopeResultCount = 0;
+	fgl.gpuFrameTime = -1;
+
 	SDL_GL_DeleteContext(fgl.context);
 	fgl.context = NULL;
 }
 
+void FosterGpuScopeEnd_OpenGL();
+
+// Reads back the results of a timed frame if the GPU has finished it
+bool FosterGpuFrameResolve_OpenGL(FosterGpuFrame_OpenGL* frame)
+{
+	// the end of the frame is queried last, so once it's ready everything is
+	GLint available = 0;
+	fgl.glGetQueryObjectiv(frame->end, GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available)
+		return false;
+
+	GLuint64 begin = 0, end = 0;
+	fgl.glGetQueryObjectui64v(frame->begin, GL_QUERY_RESULT, &begin);
+	fgl.glGetQueryObjectui64v(frame->end, GL_QUERY_RESULT, &end);
+	fgl.gpuFrameTime = (double)(end - begin) / 1000000.0;
+
+	for (int i = 0; i < frame->scopeCount; i ++)
+	{
+		FosterGpuScope_OpenGL* scope = &frame->scopes[i];
+		fgl.glGetQueryObjectui64v(scope->begin, GL_QUERY_RESULT, &begin);
+		fgl.glGetQueryObjectui64v(scope->end, GL_QUERY_RESULT, &end);
+
+		SDL_memcpy(fgl.gpuScopeResultNames[i], scope->name, FOSTER_MAX_GPU_SCOPE_NAME);
+		fgl.gpuScopeResults[i].name = fgl.gpuScopeResultNames[i];
+		fgl.gpuScopeResults[i].depth = scope->depth;
+		fgl.gpuScopeResults[i].time = (double)(end - begin) / 1000000.0;
+	}
+	fgl.gpuScopeResultCount = frame->scopeCount;
+
+	frame->pending = 0;
+	return true;
+}
+
 void FosterFrameBegin_OpenGL()
 {
+	if (!fgl.supportsTimerQueries)
+		return;
+
+	// resolve finished frames from oldest to newest, so the newest result is kept
+	for (int i = 1; i <= FOSTER_GPU_TIMING_FRAMES; i ++)
+	{
+		FosterGpuFrame_OpenGL* it = &fgl.gpuFrames[(fgl.gpuFrameIndex + i) % FOSTER_GPU_TIMING_FRAMES];
+		if (it->pending)
+			FosterGpuFrameResolve_OpenGL(it);
+	}
+
+	// the GPU is more frames behind than the ring holds, so skip timing this one
+	FosterGpuFrame_OpenGL* frame = &fgl.gpuFrames[fgl.gpuFrameIndex];
+	if (frame->pending)
+		return;
+
+	if (frame->begin == 0)
+	{
+		fgl.glGenQueries(1, &frame->begin);
+		fgl.glGenQueries(1, &frame->end);
+	}
+
+	fgl.glQueryCounter(frame->begin, GL_TIMESTAMP);
+	frame->scopeCount = 0;
+	fgl.gpuScopeDepth = 0;
+	fgl.gpuFrameTiming = 1;
+}
+
+void FosterLimitQueuedFrames_OpenGL(int count)
+{
+	// browsers pace frames themselves, and WebGL can't block on a fence
+	#ifndef __EMSCRIPTEN__
+	FOSTER_TRACE_ZONE("FosterLimitQueuedFrames");
+
+	if (!fgl.supportsFrameFences)
+	{
+		fgl.glFinish();
+	}
+	else
+	{
+		// fence the frame that was just submitted, then wait on the one submitted
+		// count - 1 frames ago, so at most count frames are ever in flight
+		GLsync* fence = &fgl.frameFences[fgl.frameFenceIndex];
+		if (*fence != NULL)
+			fgl.glDeleteSync(*fence);
+		*fence = fgl.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		int wait = (fgl.frameFenceIndex - (count - 1) + FOSTER_MAX_QUEUED_FRAMES) % FOSTER_MAX_QUEUED_FRAMES;
+		GLsync* waitFence = &fgl.frameFences[wait];
+		if (*waitFence != NULL)
+		{
+			// time out after a second, rather than hang on a lost device
+			if (fgl.glClientWaitSync(*waitFence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull) == GL_WAIT_FAILED)
+				FOSTER_LOG_WARN("Failed waiting on a frame fence");
+			fgl.glDeleteSync(*waitFence);
+			*waitFence = NULL;
+		}
+
+		fgl.frameFenceIndex = (fgl.frameFenceIndex + 1) % FOSTER_MAX_QUEUED_FRAMES;
+	}
 
+	FOSTER_TRACE_ZONE_END();
+	#endif
 }
 
 void FosterFrameEnd_OpenGL()
@@ -1095,10 +1767,150 @@ void FosterFrameEnd_OpenGL()
 	// https://wiki.libsdl.org/SDL2/SDL_GL_SwapWindow#remarks
 	FosterBindFrameBuffer(NULL);
 
+	if (fgl.gpuFrameTiming)
+	{
+		// close any scopes that were left open
+		while (fgl.gpuScopeDepth > 0)
+			FosterGpuScopeEnd_OpenGL();
+
+		FosterGpuFrame_OpenGL* frame = &fgl.gpuFrames[fgl.gpuFrameIndex];
+		fgl.glQueryCounter(frame->end, GL_TIMESTAMP);
+		frame->pending = 1;
+		fgl.gpuFrameIndex = (fgl.gpuFrameIndex + 1) % FOSTER_GPU_TIMING_FRAMES;
+		fgl.gpuFrameTiming = 0;
+	}
+
+	FOSTER_TRACE_ZONE("SDL_GL_SwapWindow");
 	SDL_GL_SwapWindow(state->window);
+	FOSTER_TRACE_ZONE_END();
+
+	if (state->maxQueuedFrames > 0)
+		FosterLimitQueuedFrames_OpenGL(state->maxQueuedFrames);
 }
 
-FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFormat format)
+double FosterGpuFrameTime_OpenGL()
+{
+	return fgl.gpuFrameTime;
+}
+
+void FosterGpuScopeBegin_OpenGL(const char* name)
+{
+	if (!fgl.gpuFrameTiming)
+		return;
+
+	// scopes past the limits are still tracked, so that they end in the right place
+	if (fgl.gpuScopeDepth >= FOSTER_MAX_GPU_SCOPE_DEPTH)
+	{
+		fgl.gpuScopeDepth++;
+		return;
+	}
+
+	FosterGpuFrame_OpenGL* frame = &fgl.gpuFrames[fgl.gpuFrameIndex];
+	int index = -1;
+
+	if (frame->scopeCount < FOSTER_MAX_GPU_SCOPES)
+	{
+		index = frame->scopeCount++;
+
+		FosterGpuScope_OpenGL* scope = &frame->scopes[index];
+		if (scope->begin == 0)
+		{
+			fgl.glGenQueries(1, &scope->begin);
+			fgl.glGenQueries(1, &scope->end);
+		}
+
+		SDL_strlcpy(scope->name, name != NULL ? name : "", FOSTER_MAX_GPU_SCOPE_NAME);
+		scope->depth = fgl.gpuScopeDepth;
+		fgl.glQueryCounter(scope->begin, GL_TIMESTAMP);
+	}
+
+	fgl.gpuScopeStack[fgl.gpuScopeDepth++] = index;
+}
+
+void FosterGpuScopeEnd_OpenGL()
+{
+	if (!fgl.gpuFrameTiming || fgl.gpuScopeDepth <= 0)
+		return;
+
+	fgl.gpuScopeDepth--;
+	if (fgl.gpuScopeDepth >= FOSTER_MAX_GPU_SCOPE_DEPTH)
+		return;
+
+	int index = fgl.gpuScopeStack[fgl.gpuScopeDepth];
+	if (index >= 0)
+	{
+		FosterGpuFrame_OpenGL* frame = &fgl.gpuFrames[fgl.gpuFrameIndex];
+		fgl.glQueryCounter(frame->scopes[index].end, GL_TIMESTAMP);
+	}
+}
+
+int FosterGpuScopes_OpenGL(FosterGpuScope* output, int max)
+{
+	int count = fgl.gpuScopeResultCount;
+	if (output != NULL)
+	{
+		if (count > max)
+			count = max;
+		for (int i = 0; i < count; i ++)
+			output[i] = fgl.gpuScopeResults[i];
+	}
+	return count;
+}
+
+FosterBool FosterTextureFormatSupported_OpenGL(FosterTextureFormat format)
+{
+	switch (format)
+	{
+		case FOSTER_TEXTURE_FORMAT_R8G8B8A8:
+		case FOSTER_TEXTURE_FORMAT_R8:
+		case FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8:
+			return 1;
+		case FOSTER_TEXTURE_FORMAT_BC1:
+		case FOSTER_TEXTURE_FORMAT_BC3:
+			return fgl.supportsS3TC;
+		case FOSTER_TEXTURE_FORMAT_BC7:
+			return fgl.supportsBPTC;
+		case FOSTER_TEXTURE_FORMAT_ETC2:
+			return fgl.supportsETC2;
+		case FOSTER_TEXTURE_FORMAT_ASTC_4X4:
+			return fgl.supportsASTC;
+	}
+
+	return 0;
+}
+
+int FosterTextureFormatIsCompressed_OpenGL(FosterTextureFormat format)
+{
+	return
+		format == FOSTER_TEXTURE_FORMAT_BC1 ||
+		format == FOSTER_TEXTURE_FORMAT_BC3 ||
+		format == FOSTER_TEXTURE_FORMAT_BC7 ||
+		format == FOSTER_TEXTURE_FORMAT_ETC2 ||
+		format == FOSTER_TEXTURE_FORMAT_ASTC_4X4;
+}
+
+// the size in bytes of a single image of the given format
+int FosterTextureDataLength_OpenGL(FosterTextureFormat format, int width, int height)
+{
+	// every compressed format here uses 4x4 pixel blocks
+	int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+
+	switch (format)
+	{
+		case FOSTER_TEXTURE_FORMAT_R8: return width * height;
+		case FOSTER_TEXTURE_FORMAT_R8G8B8A8: return width * height * 4;
+		case FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8: return width * height * 4;
+		case FOSTER_TEXTURE_FORMAT_BC1: return blocks * 8;
+		case FOSTER_TEXTURE_FORMAT_BC3: return blocks * 16;
+		case FOSTER_TEXTURE_FORMAT_BC7: return blocks * 16;
+		case FOSTER_TEXTURE_FORMAT_ETC2: return blocks * 16;
+		case FOSTER_TEXTURE_FORMAT_ASTC_4X4: return blocks * 16;
+	}
+
+	return 0;
+}
+
+FosterTexture_OpenGL* FosterTextureAlloc_OpenGL(int width, int height, int layers, GLenum glTarget, FosterTextureFormat format)
 {
 	FosterTexture_OpenGL result;
 	FosterTexture_OpenGL* tex = NULL;
@@ -1106,7 +1918,10 @@ FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFo
 	result.id = 0;
 	result.width = width;
 	result.height = height;
+	result.layers = layers;
+	result.mipLevels = 1;
 	result.format = format;
+	result.glTarget = glTarget;
 	result.glInternalFormat = GL_RED;
 	result.glFormat = GL_RED;
 	result.glType = GL_UNSIGNED_BYTE;
@@ -1115,6 +1930,8 @@ FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFo
 	result.sampler.filter = -1;
 	result.sampler.wrapX = -1;
 	result.sampler.wrapY = -1;
+	result.sampler.mipFilter = -1;
+	result.sampler.anisotropy = -1;
 
 	if (width > fgl.max_texture_size || height > fgl.max_texture_size)
 	{
@@ -1122,6 +1939,12 @@ FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFo
 		return NULL;
 	}
 
+	if (layers > fgl.max_array_texture_layers && glTarget == GL_TEXTURE_2D_ARRAY)
+	{
+		FOSTER_LOG_ERROR("Exceeded Max Texture Array Layers of %i", fgl.max_array_texture_layers);
+		return NULL;
+	}
+
 	switch (format)
 	{
 		case FOSTER_TEXTURE_FORMAT_R8:
@@ -1139,11 +1962,39 @@ FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFo
 			result.glFormat = GL_DEPTH_STENCIL;
 			result.glType = GL_UNSIGNED_INT_24_8;
 			break;
+		case FOSTER_TEXTURE_FORMAT_BC1:
+			result.glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+			break;
+		case FOSTER_TEXTURE_FORMAT_BC3:
+			result.glInternalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			break;
+		case FOSTER_TEXTURE_FORMAT_BC7:
+			result.glInternalFormat = GL_COMPRESSED_RGBA_BPTC_UNORM;
+			break;
+		case FOSTER_TEXTURE_FORMAT_ETC2:
+			result.glInternalFormat = GL_COMPRESSED_RGBA8_ETC2_EAC;
+			break;
+		case FOSTER_TEXTURE_FORMAT_ASTC_4X4:
+			result.glInternalFormat = GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+			break;
 		default:
 			FOSTER_LOG_ERROR("Invalid Texture Format (%i)", format);
 			return NULL;
 	}
 
+	int compressed = FosterTextureFormatIsCompressed_OpenGL(format);
+	if (compressed && !FosterTextureFormatSupported_OpenGL(format))
+	{
+		FOSTER_LOG_ERROR("Texture Format (%i) is not supported by the current OpenGL context", format);
+		return NULL;
+	}
+
+	if (compressed && glTarget != GL_TEXTURE_2D)
+	{
+		FOSTER_LOG_ERROR("Compressed Texture Arrays are not supported");
+		return NULL;
+	}
+
 	fgl.glGenTextures(1, &result.id);
 	if (result.id == 0)
 	{
@@ -1151,39 +2002,490 @@ FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFo
 		return NULL;
 	}
 
-	FosterBindTexture(0, result.id);
-	fgl.glTexImage2D(GL_TEXTURE_2D, 0, result.glInternalFormat, width, height, 0, result.glFormat, result.glType, NULL);
+	FosterBindTexture(0, result.glTarget, result.id);
+	if (compressed)
+		fgl.glCompressedTexImage2D(GL_TEXTURE_2D, 0, result.glInternalFormat, width, height, 0, FosterTextureDataLength_OpenGL(format, width, height), NULL);
+	else if (glTarget == GL_TEXTURE_2D_ARRAY)
+		fgl.glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, result.glInternalFormat, width, height, layers, 0, result.glFormat, result.glType, NULL);
+	else
+		fgl.glTexImage2D(GL_TEXTURE_2D, 0, result.glInternalFormat, width, height, 0, result.glFormat, result.glType, NULL);
+
+	// only level 0 exists until mipmaps are generated or uploaded, and without
+	// this the Texture would be incomplete when sampled with a mip filter
+	fgl.glTexParameteri(result.glTarget, GL_TEXTURE_MAX_LEVEL, 0);
 
 	tex = (FosterTexture_OpenGL*)SDL_malloc(sizeof(FosterTexture_OpenGL));
 	*tex = result;
-	return (FosterTexture*)tex;
+	return tex;
 }
 
-void FosterTextureSetData_OpenGL(FosterTexture* texture, void* data, int length)
+FosterTexture* FosterTextureCreate_OpenGL(int width, int height, FosterTextureFormat format)
 {
-	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
-	FosterBindTexture(0, tex->id);
-	fgl.glTexImage2D(GL_TEXTURE_2D, 0, tex->glInternalFormat, tex->width, tex->height, 0, tex->glFormat, tex->glType, data);
+	return (FosterTexture*)FosterTextureAlloc_OpenGL(width, height, 1, GL_TEXTURE_2D, format);
 }
 
-void FosterTextureGetData_OpenGL(FosterTexture* texture, void* data, int length)
+FosterTexture* FosterTextureCreateArray_OpenGL(int width, int height, int layers, FosterTextureFormat format)
 {
-	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
-	FosterBindTexture(0, tex->id);
-	fgl.glGetTexImage(GL_TEXTURE_2D, 0, tex->glInternalFormat, tex->glType, data);
+	if (fgl.glTexImage3D == NULL || fgl.glTexSubImage3D == NULL)
+	{
+		FOSTER_LOG_ERROR("Texture Arrays are not supported by the current OpenGL context");
+		return NULL;
+	}
+
+	return (FosterTexture*)FosterTextureAlloc_OpenGL(width, height, layers, GL_TEXTURE_2D_ARRAY, format);
 }
 
-void FosterTextureDestroy_OpenGL(FosterTexture* texture)
+void FosterTextureSetData_OpenGL(FosterTexture* texture, void* data, int length)
 {
 	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
 
-	if (!tex->disposed)
+	// compressed data is uploaded as-is, so it has to cover the whole Texture
+	if (FosterTextureFormatIsCompressed_OpenGL(tex->format))
 	{
-		// make sure this isn't bound anymore
-		for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i ++)
+		int required = FosterTextureDataLength_OpenGL(tex->format, tex->width, tex->height);
+		if (length < required)
 		{
-			if (fgl.stateTextureSlots[i] == tex->id)
-				FosterBindTexture(i, 0);
+			FOSTER_LOG_ERROR("Data is smaller than the Compressed Texture");
+			return;
+		}
+
+		FosterBindTexture(0, tex->glTarget, tex->id);
+		fgl.glCompressedTexImage2D(GL_TEXTURE_2D, 0, tex->glInternalFormat, tex->width, tex->height, 0, required, data);
+		FOSTER_STAT_ADD(textureBytesUploaded, required);
+		return;
+	}
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	if (tex->glTarget == GL_TEXTURE_2D_ARRAY)
+		fgl.glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, tex->glInternalFormat, tex->width, tex->height, tex->layers, 0, tex->glFormat, tex->glType, data);
+	else
+		fgl.glTexImage2D(GL_TEXTURE_2D, 0, tex->glInternalFormat, tex->width, tex->height, 0, tex->glFormat, tex->glType, data);
+	FOSTER_STAT_ADD(textureBytesUploaded, length);
+}
+
+int FosterTextureRectLength_OpenGL(FosterTexture_OpenGL* tex, FosterRect rect)
+{
+	// array layers are only ever updated in full
+	if (tex->glTarget != GL_TEXTURE_2D)
+	{
+		FOSTER_LOG_ERROR("Texture Rectangles are not supported for Texture Arrays");
+		return 0;
+	}
+
+	if (FosterTextureFormatIsCompressed_OpenGL(tex->format))
+	{
+		FOSTER_LOG_ERROR("Texture Rectangles are not supported for Compressed Textures");
+		return 0;
+	}
+
+	if (rect.x < 0 || rect.y < 0 || rect.w <= 0 || rect.h <= 0 ||
+		rect.x + rect.w > tex->width || rect.y + rect.h > tex->height)
+	{
+		FOSTER_LOG_ERROR("Texture Rectangle is out of bounds");
+		return 0;
+	}
+
+	return FosterTextureDataLength_OpenGL(tex->format, rect.w, rect.h);
+}
+
+void FosterTextureSetLayerData_OpenGL(FosterTexture* texture, int layer, void* data, int length)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+
+	if (tex->glTarget != GL_TEXTURE_2D_ARRAY)
+	{
+		FOSTER_LOG_ERROR("Texture is not a Texture Array");
+		return;
+	}
+
+	if (layer < 0 || layer >= tex->layers)
+	{
+		FOSTER_LOG_ERROR("Texture Array Layer %i is out of bounds", layer);
+		return;
+	}
+
+	if (length < FosterTextureDataLength_OpenGL(tex->format, tex->width, tex->height))
+	{
+		FOSTER_LOG_ERROR("Data is smaller than the Texture Array Layer");
+		return;
+	}
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	fgl.glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, tex->width, tex->height, 1, tex->glFormat, tex->glType, data);
+	FOSTER_STAT_ADD(textureBytesUploaded, length);
+}
+
+// the number of levels in a full mip chain, down to 1x1
+int FosterTextureMaxMipLevels_OpenGL(FosterTexture_OpenGL* tex)
+{
+	int size = tex->width > tex->height ? tex->width : tex->height;
+	int levels = 1;
+	while (size > 1)
+	{
+		size /= 2;
+		levels++;
+	}
+	return levels;
+}
+
+void FosterTextureSetLevelData_OpenGL(FosterTexture* texture, int level, void* data, int length)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+
+	if (tex->glTarget != GL_TEXTURE_2D)
+	{
+		FOSTER_LOG_ERROR("Mip Levels can't be set for Texture Arrays");
+		return;
+	}
+
+	if (level < 0 || level >= FosterTextureMaxMipLevels_OpenGL(tex))
+	{
+		FOSTER_LOG_ERROR("Mip Level %i is out of bounds", level);
+		return;
+	}
+
+	int width = SDL_max(1, tex->width >> level);
+	int height = SDL_max(1, tex->height >> level);
+	int required = FosterTextureDataLength_OpenGL(tex->format, width, height);
+	if (length < required)
+	{
+		FOSTER_LOG_ERROR("Data is smaller than the Mip Level");
+		return;
+	}
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	if (FosterTextureFormatIsCompressed_OpenGL(tex->format))
+		fgl.glCompressedTexImage2D(GL_TEXTURE_2D, level, tex->glInternalFormat, width, height, 0, required, data);
+	else
+		fgl.glTexImage2D(GL_TEXTURE_2D, level, tex->glInternalFormat, width, height, 0, tex->glFormat, tex->glType, data);
+	FOSTER_STAT_ADD(textureBytesUploaded, required);
+
+	if (level >= tex->mipLevels)
+	{
+		tex->mipLevels = level + 1;
+		fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_MAX_LEVEL, tex->mipLevels - 1);
+	}
+}
+
+void FosterTextureGenerateMipmaps_OpenGL(FosterTexture* texture)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+
+	if (fgl.glGenerateMipmap == NULL)
+	{
+		FOSTER_LOG_ERROR("Generating Mipmaps is not supported by the current OpenGL context");
+		return;
+	}
+
+	if (FosterTextureFormatIsCompressed_OpenGL(tex->format) || tex->format == FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8)
+	{
+		FOSTER_LOG_ERROR("Mipmaps can't be generated for Texture Format (%i)", tex->format);
+		return;
+	}
+
+	tex->mipLevels = FosterTextureMaxMipLevels_OpenGL(tex);
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	fgl.glTexParameteri(tex->glTarget, GL_TEXTURE_MAX_LEVEL, tex->mipLevels - 1);
+	fgl.glGenerateMipmap(tex->glTarget);
+}
+
+void FosterTextureSetSubData_OpenGL(FosterTexture* texture, FosterRect rect, void* data, int length)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+	int required = FosterTextureRectLength_OpenGL(tex, rect);
+	if (required <= 0)
+		return;
+
+	if (length < required)
+	{
+		FOSTER_LOG_ERROR("Data is smaller than the Texture Rectangle");
+		return;
+	}
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	fgl.glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, tex->glFormat, tex->glType, data);
+	FOSTER_STAT_ADD(textureBytesUploaded, required);
+}
+
+FosterTextureUpload* FosterTextureUploadBegin_OpenGL(FosterTexture* texture, FosterRect rect)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+	int length = FosterTextureRectLength_OpenGL(tex, rect);
+	if (length <= 0)
+		return NULL;
+
+	FosterTextureUpload_OpenGL* upload = (FosterTextureUpload_OpenGL*)SDL_malloc(sizeof(FosterTextureUpload_OpenGL));
+	upload->texture = FosterTextureRequestReference(tex);
+	upload->rect = rect;
+	upload->length = length;
+	upload->data = NULL;
+	upload->slot = -1;
+
+	// find a pixel buffer that the GPU has finished copying from, without
+	// waiting on any that are still in use
+	if (fgl.supportsBufferMapping)
+	{
+		for (int i = 0; i < FOSTER_TEXTURE_UPLOAD_SLOTS && upload->data == NULL; i ++)
+		{
+			int index = (fgl.uploadSlotNext + i) % FOSTER_TEXTURE_UPLOAD_SLOTS;
+			FosterTextureUploadSlot_OpenGL* slot = &fgl.uploadSlots[index];
+
+			if (slot->mapped)
+				continue;
+
+			if (slot->fence != NULL)
+			{
+				GLenum status = fgl.glClientWaitSync(slot->fence, 0, 0);
+				if (status == GL_TIMEOUT_EXPIRED)
+					continue;
+				fgl.glDeleteSync(slot->fence);
+				slot->fence = NULL;
+			}
+
+			if (slot->id == 0)
+				fgl.glGenBuffers(1, &slot->id);
+			if (slot->id == 0)
+				continue;
+
+			fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->id);
+			if (slot->size < length)
+			{
+				fgl.glBufferData(GL_PIXEL_UNPACK_BUFFER, length, NULL, GL_STREAM_DRAW);
+				slot->size = length;
+			}
+			upload->data = fgl.glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, length, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+			fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			if (upload->data != NULL)
+			{
+				slot->mapped = 1;
+				upload->slot = index;
+				fgl.uploadSlotNext = (index + 1) % FOSTER_TEXTURE_UPLOAD_SLOTS;
+			}
+		}
+	}
+
+	// every pixel buffer is busy, so stage the data on the CPU instead
+	if (upload->data == NULL)
+		upload->data = SDL_malloc(length);
+
+	return (FosterTextureUpload*)upload;
+}
+
+void* FosterTextureUploadGetData_OpenGL(FosterTextureUpload* upload)
+{
+	return ((FosterTextureUpload_OpenGL*)upload)->data;
+}
+
+void FosterTextureUploadSubmit_OpenGL(FosterTextureUpload* upload)
+{
+	FosterTextureUpload_OpenGL* it = (FosterTextureUpload_OpenGL*)upload;
+	FosterTexture_OpenGL* tex = it->texture;
+	FosterRect rect = it->rect;
+
+	if (it->slot >= 0)
+	{
+		// copy from the pixel buffer, which the driver can do without stalling
+		FosterTextureUploadSlot_OpenGL* slot = &fgl.uploadSlots[it->slot];
+		fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->id);
+		if (!fgl.glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+		{
+			FOSTER_LOG_ERROR("Texture Upload data was lost");
+		}
+		else if (!tex->disposed)
+		{
+			FosterBindTexture(0, tex->glTarget, tex->id);
+			fgl.glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, tex->glFormat, tex->glType, (void*)0);
+			FOSTER_STAT_ADD(textureBytesUploaded, it->length);
+			slot->fence = fgl.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+		fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		slot->mapped = 0;
+	}
+	else
+	{
+		if (it->data != NULL && !tex->disposed)
+		{
+			FosterBindTexture(0, tex->glTarget, tex->id);
+			fgl.glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.w, rect.h, tex->glFormat, tex->glType, it->data);
+			FOSTER_STAT_ADD(textureBytesUploaded, it->length);
+		}
+		SDL_free(it->data);
+	}
+
+	FosterTextureReturnReference(tex);
+	SDL_free(it);
+}
+
+void FosterTextureUploadCancel_OpenGL(FosterTextureUpload* upload)
+{
+	FosterTextureUpload_OpenGL* it = (FosterTextureUpload_OpenGL*)upload;
+
+	// unmap the pixel buffer so the slot can be used again, discarding what was written
+	if (it->slot >= 0)
+	{
+		FosterTextureUploadSlot_OpenGL* slot = &fgl.uploadSlots[it->slot];
+		fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, slot->id);
+		fgl.glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		fgl.glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		slot->mapped = 0;
+	}
+	else
+	{
+		SDL_free(it->data);
+	}
+
+	FosterTextureReturnReference(it->texture);
+	SDL_free(it);
+}
+
+void FosterTextureGetData_OpenGL(FosterTexture* texture, void* data, int length)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+
+	if (FosterTextureFormatIsCompressed_OpenGL(tex->format))
+	{
+		FOSTER_LOG_ERROR("Reading Compressed Textures is not supported");
+		return;
+	}
+
+	FosterBindTexture(0, tex->glTarget, tex->id);
+	fgl.glGetTexImage(tex->glTarget, 0, tex->glInternalFormat, tex->glType, data);
+}
+
+FosterReadback* FosterTextureReadAsync_OpenGL(FosterTexture* texture, FosterRect rect)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+	int length = FosterTextureRectLength_OpenGL(tex, rect);
+	if (length <= 0)
+		return NULL;
+
+	if (fgl.readbackFrameBuffer == 0)
+		fgl.glGenFramebuffers(1, &fgl.readbackFrameBuffer);
+	if (fgl.readbackFrameBuffer == 0)
+	{
+		FOSTER_LOG_ERROR("Failed to create Readback Frame Buffer");
+		return NULL;
+	}
+
+	FosterReadback_OpenGL* readback = (FosterReadback_OpenGL*)SDL_malloc(sizeof(FosterReadback_OpenGL));
+	readback->buffer = 0;
+	readback->fence = NULL;
+	readback->length = length;
+	readback->ready = 0;
+	readback->data = NULL;
+
+	// attach the texture to our own frame buffer, leaving the bound draw frame buffer alone
+	GLenum attachment = tex->format == FOSTER_TEXTURE_FORMAT_DEPTH24_STENCIL8 ? GL_DEPTH_STENCIL_ATTACHMENT : GL_COLOR_ATTACHMENT0;
+	fgl.glBindFramebuffer(GL_READ_FRAMEBUFFER, fgl.readbackFrameBuffer);
+	fgl.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, attachment, GL_TEXTURE_2D, tex->id, 0);
+	if (attachment == GL_COLOR_ATTACHMENT0)
+		fgl.glReadBuffer(GL_COLOR_ATTACHMENT0);
+
+	if (fgl.supportsBufferMapping)
+	{
+		// read into a pixel buffer, which returns immediately, and fence it
+		// so we can tell when the GPU has actually finished the copy
+		fgl.glGenBuffers(1, &readback->buffer);
+		fgl.glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+		fgl.glBufferData(GL_PIXEL_PACK_BUFFER, length, NULL, GL_STREAM_READ);
+		fgl.glReadPixels(rect.x, rect.y, rect.w, rect.h, tex->glFormat, tex->glType, (void*)0);
+		fgl.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		readback->fence = fgl.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+	else
+	{
+		readback->data = SDL_malloc(length);
+		fgl.glReadPixels(rect.x, rect.y, rect.w, rect.h, tex->glFormat, tex->glType, readback->data);
+		readback->ready = 1;
+	}
+
+	fgl.glFramebufferTexture2D(GL_READ_FRAMEBUFFER, attachment, GL_TEXTURE_2D, 0, 0);
+	fgl.glBindFramebuffer(GL_READ_FRAMEBUFFER, fgl.stateFrameBuffer);
+
+	return (FosterReadback*)readback;
+}
+
+FosterBool FosterReadbackPoll_OpenGL(FosterReadback* readback)
+{
+	FosterReadback_OpenGL* it = (FosterReadback_OpenGL*)readback;
+
+	if (!it->ready && it->fence != NULL)
+	{
+		// flush so that the fence is guaranteed to be reached eventually
+		GLenum status = fgl.glClientWaitSync(it->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+		if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+			it->ready = 1;
+	}
+
+	return it->ready;
+}
+
+FosterBool FosterReadbackGet_OpenGL(FosterReadback* readback, void* data, int length)
+{
+	FosterReadback_OpenGL* it = (FosterReadback_OpenGL*)readback;
+
+	if (length < it->length)
+	{
+		FOSTER_LOG_ERROR("Data is smaller than the Readback");
+		return false;
+	}
+
+	if (it->data != NULL)
+	{
+		SDL_memcpy(data, it->data, it->length);
+		return true;
+	}
+
+	// this will stall if the readback hasn't been polled as ready yet
+	if (!it->ready && it->fence != NULL)
+	{
+		if (fgl.glClientWaitSync(it->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED) == GL_WAIT_FAILED)
+		{
+			FOSTER_LOG_ERROR("Failed to wait for Readback");
+			return false;
+		}
+		it->ready = 1;
+	}
+
+	FosterBool result = false;
+	fgl.glBindBuffer(GL_PIXEL_PACK_BUFFER, it->buffer);
+	void* mapped = fgl.glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, it->length, GL_MAP_READ_BIT);
+	if (mapped != NULL)
+	{
+		SDL_memcpy(data, mapped, it->length);
+		result = fgl.glUnmapBuffer(GL_PIXEL_PACK_BUFFER) ? true : false;
+	}
+	fgl.glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (!result)
+		FOSTER_LOG_ERROR("Failed to read Readback data");
+	return result;
+}
+
+void FosterReadbackDestroy_OpenGL(FosterReadback* readback)
+{
+	FosterReadback_OpenGL* it = (FosterReadback_OpenGL*)readback;
+	if (it->fence != NULL)
+		fgl.glDeleteSync(it->fence);
+	if (it->buffer != 0)
+		fgl.glDeleteBuffers(1, &it->buffer);
+	SDL_free(it->data);
+	SDL_free(it);
+}
+
+void FosterTextureDestroy_OpenGL(FosterTexture* texture)
+{
+	FosterTexture_OpenGL* tex = (FosterTexture_OpenGL*)texture;
+
+	if (!tex->disposed)
+	{
+		// make sure this isn't bound anymore
+		for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i ++)
+		{
+			if (fgl.stateTextureSlots[i] == tex->id)
+				FosterBindTexture(i, tex->glTarget, 0);
 		}
 
 		// delete it
@@ -1215,9 +2517,10 @@ FosterTarget* FosterTargetCreate_OpenGL(int width, int height, FosterTextureForm
 		if (tex == NULL)
 		{
 			for (int j = 0; j < i; j++)
-				FosterTextureDestroy_OpenGL((FosterTexture*)tex);
+				FosterTextureDestroy_OpenGL((FosterTexture*)result.attachments[j]);
 			FOSTER_LOG_ERROR("Failed to create Target Attachment");
 			FosterBindFrameBuffer(NULL);
+			fgl.glDeleteFramebuffers(1, &result.id);
 			return NULL;
 		}
 
@@ -1251,6 +2554,21 @@ FosterTexture* FosterTargetGetAttachment_OpenGL(FosterTarget* target, int index)
 	return (FosterTexture*)tar->attachments[index];
 }
 
+void FosterTargetDiscard_OpenGL(FosterTarget* target)
+{
+	FosterTarget_OpenGL* tar = (FosterTarget_OpenGL*)target;
+	GLenum attachments[FOSTER_MAX_TARGET_ATTACHMENTS];
+
+	if (!fgl.supportsInvalidateFramebuffer)
+		return;
+
+	for (int i = 0; i < tar->attachmentCount; i++)
+		attachments[i] = tar->attachments[i]->glAttachment;
+
+	FosterBindFrameBuffer(tar);
+	fgl.glInvalidateFramebuffer(GL_FRAMEBUFFER, tar->attachmentCount, attachments);
+}
+
 void FosterTargetDestroy_OpenGL(FosterTarget* target)
 {
 	FosterTarget_OpenGL* tar = (FosterTarget_OpenGL*)target;
@@ -1265,136 +2583,250 @@ void FosterTargetDestroy_OpenGL(FosterTarget* target)
 	SDL_free(tar);
 }
 
-FosterShader* FosterShaderCreate_OpenGL(FosterShaderData* data)
+// Linked programs are cached in the user path, keyed by a hash of their source.
+// Each file stores the driver it was created with, and is ignored (and later
+// replaced) if the driver has changed since.
+#define FOSTER_PROGRAM_CACHE_VERSION 1
+
+typedef struct FosterProgramCacheHeader_OpenGL
 {
-	GLchar log[1024] = { 0 };
-	GLsizei logLength = 0;
-	GLuint vertexShader;
-	GLuint fragmentShader;
-	const GLchar* source;
+	char magic[4];
+	Uint32 version;
+	Uint64 driver;
+	Uint32 format;
+	Uint32 length;
+} FosterProgramCacheHeader_OpenGL;
+
+char* FosterProgramCachePath_OpenGL(Uint64 key)
+{
+	const char* userPath = FosterGetUserPath();
+	size_t length = SDL_strlen(userPath) + 64;
+	char* path = (char*)SDL_malloc(length);
+	SDL_snprintf(path, length, "%sshader_%016llx.bin", userPath, (unsigned long long)key);
+	return path;
+}
 
-	if (data->vertexShader == NULL)
-	{
-		FOSTER_LOG_ERROR("Invalid Vertex Shader");
-		return NULL;
-	}
+GLuint FosterProgramCacheLoad_OpenGL(Uint64 key)
+{
+	char* path = FosterProgramCachePath_OpenGL(key);
+	size_t size = 0;
+	unsigned char* data = (unsigned char*)SDL_LoadFile(path, &size);
+	SDL_free(path);
 
-	if (data->fragmentShader == NULL)
-	{
-		FOSTER_LOG_ERROR("Invalid Fragment Shader");
-		return NULL;
-	}
+	if (data == NULL)
+		return 0;
 
-	vertexShader = fgl.glCreateShader(GL_VERTEX_SHADER);
+	GLuint id = 0;
+	FosterProgramCacheHeader_OpenGL header;
+	if (size >= sizeof(header))
 	{
-		source = (const GLchar*)data->vertexShader;
-		fgl.glShaderSource(vertexShader, 1, &source, NULL);
-		fgl.glCompileShader(vertexShader);
-		fgl.glGetShaderInfoLog(vertexShader, 1024, &logLength, log);
+		SDL_memcpy(&header, data, sizeof(header));
 
-		GLint params;
-		fgl.glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &params);
-
-		// validate shader
-		if (!params)
-		{
-			fgl.glDeleteShader(vertexShader);
-			if (logLength > 0)
-				FOSTER_LOG_ERROR("%s", log);
-			return NULL;
-		}
-		else if (logLength > 0)
+		if (SDL_memcmp(header.magic, "FSPB", 4) == 0 &&
+			header.version == FOSTER_PROGRAM_CACHE_VERSION &&
+			header.driver == fgl.programBinaryDriver &&
+			header.length == size - sizeof(header))
 		{
-			FOSTER_LOG_INFO("%s", log);
+			id = fgl.glCreateProgram();
+			fgl.glProgramBinary(id, header.format, data + sizeof(header), header.length);
+
+			// the driver is allowed to reject binaries for any reason
+			GLint linkResult = 0;
+			fgl.glGetProgramiv(id, GL_LINK_STATUS, &linkResult);
+			if (!linkResult)
+			{
+				fgl.glDeleteProgram(id);
+				id = 0;
+			}
 		}
 	}
 
-	fragmentShader = fgl.glCreateShader(GL_FRAGMENT_SHADER);
-	{
-		source = (const GLchar*)data->fragmentShader;
-		fgl.glShaderSource(fragmentShader, 1, &source, NULL);
-		fgl.glCompileShader(fragmentShader);
-		fgl.glGetShaderInfoLog(fragmentShader, 1024, &logLength, log);
+	SDL_free(data);
+	return id;
+}
 
-		GLint params;
-		fgl.glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &params);
+void FosterProgramCacheSave_OpenGL(Uint64 key, GLuint id)
+{
+	GLint length = 0;
+	fgl.glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
 
-		// validate shader
-		if (!params)
+	FosterProgramCacheHeader_OpenGL header;
+	SDL_memcpy(header.magic, "FSPB", 4);
+	header.version = FOSTER_PROGRAM_CACHE_VERSION;
+	header.driver = fgl.programBinaryDriver;
+	header.format = 0;
+	header.length = 0;
+
+	void* binary = SDL_malloc(length);
+	GLsizei written = 0;
+	GLenum format = 0;
+	fgl.glGetProgramBinary(id, length, &written, &format, binary);
+	header.format = format;
+	header.length = written;
+
+	if (written > 0)
+	{
+		char* path = FosterProgramCachePath_OpenGL(key);
+		SDL_RWops* file = SDL_RWFromFile(path, "wb");
+		if (file != NULL)
 		{
-			fgl.glDeleteShader(vertexShader);
-			fgl.glDeleteShader(fragmentShader);
-			if (logLength > 0)
-				FOSTER_LOG_ERROR("%s", log);
-			return NULL;
+			SDL_RWwrite(file, &header, sizeof(header), 1);
+			SDL_RWwrite(file, binary, written, 1);
+			SDL_RWclose(file);
 		}
-		else if (logLength > 0)
+		else
 		{
-			FOSTER_LOG_INFO("%s", log);
+			FOSTER_LOG_INFO("Failed to write Shader cache: %s", SDL_GetError());
 		}
+		SDL_free(path);
 	}
 
+	SDL_free(binary);
+}
+
+// Starts compiling and linking the shader from source, without waiting on
+// the results. With KHR_parallel_shader_compile the driver can do this on
+// other threads, so nothing is queried until FosterShaderCompileEnd_OpenGL.
+void FosterShaderCompileBegin_OpenGL(FosterShader_OpenGL* shader, FosterShaderData* data)
+{
+	const GLchar* source;
+
+	shader->pendingVertex = fgl.glCreateShader(GL_VERTEX_SHADER);
+	source = (const GLchar*)data->vertexShader;
+	fgl.glShaderSource(shader->pendingVertex, 1, &source, NULL);
+	fgl.glCompileShader(shader->pendingVertex);
+
+	shader->pendingFragment = fgl.glCreateShader(GL_FRAGMENT_SHADER);
+	source = (const GLchar*)data->fragmentShader;
+	fgl.glShaderSource(shader->pendingFragment, 1, &source, NULL);
+	fgl.glCompileShader(shader->pendingFragment);
+
 	// create actual shader program
-	GLuint id = fgl.glCreateProgram();
-	fgl.glAttachShader(id, vertexShader);
-	fgl.glAttachShader(id, fragmentShader);
-	fgl.glLinkProgram(id);
-	fgl.glGetProgramInfoLog(id, 1024, &logLength, log);
-	fgl.glDetachShader(id, vertexShader);
-	fgl.glDetachShader(id, fragmentShader);
-	fgl.glDeleteShader(vertexShader);
-	fgl.glDeleteShader(fragmentShader);
+	shader->id = fgl.glCreateProgram();
+	fgl.glAttachShader(shader->id, shader->pendingVertex);
+	fgl.glAttachShader(shader->id, shader->pendingFragment);
+	if (fgl.supportsProgramBinary)
+		fgl.glProgramParameteri(shader->id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, 1);
+	fgl.glLinkProgram(shader->id);
+	shader->pending = 1;
+}
+
+int FosterShaderCompileStatus_OpenGL(GLuint id)
+{
+	GLchar log[1024] = { 0 };
+	GLsizei logLength = 0;
+	GLint params;
+
+	fgl.glGetShaderInfoLog(id, 1024, &logLength, log);
+	fgl.glGetShaderiv(id, GL_COMPILE_STATUS, &params);
+
+	// validate shader
+	if (!params)
+	{
+		if (logLength > 0)
+			FOSTER_LOG_ERROR("%s", log);
+		return 0;
+	}
+	else if (logLength > 0)
+	{
+		FOSTER_LOG_INFO("%s", log);
+	}
+
+	return 1;
+}
+
+// Waits for the compile & link to finish, logs the results, and releases the
+// individual shaders. The program is deleted if anything failed.
+int FosterShaderCompileEnd_OpenGL(FosterShader_OpenGL* shader)
+{
+	GLchar log[1024] = { 0 };
+	GLsizei logLength = 0;
+
+	int compiled =
+		FosterShaderCompileStatus_OpenGL(shader->pendingVertex) &&
+		FosterShaderCompileStatus_OpenGL(shader->pendingFragment);
+
+	fgl.glGetProgramInfoLog(shader->id, 1024, &logLength, log);
+	fgl.glDetachShader(shader->id, shader->pendingVertex);
+	fgl.glDetachShader(shader->id, shader->pendingFragment);
+	fgl.glDeleteShader(shader->pendingVertex);
+	fgl.glDeleteShader(shader->pendingFragment);
+	shader->pendingVertex = 0;
+	shader->pendingFragment = 0;
 
 	// validate link status
-	GLint linkResult;
-	fgl.glGetProgramiv(id, GL_LINK_STATUS, &linkResult);
+	GLint linkResult = 0;
+	if (compiled)
+		fgl.glGetProgramiv(shader->id, GL_LINK_STATUS, &linkResult);
 
 	if (!linkResult)
 	{
-		if (logLength > 0)
+		fgl.glDeleteProgram(shader->id);
+		shader->id = 0;
+		if (compiled && logLength > 0)
 			FOSTER_LOG_ERROR("%s", log);
-		return NULL;
+		return 0;
 	}
 	else if (logLength > 0)
 	{
 		FOSTER_LOG_INFO("%s", log);
 	}
 
-	FosterShader_OpenGL* shader = (FosterShader_OpenGL*)SDL_malloc(sizeof(FosterShader_OpenGL));
-	shader->id = id;
-	shader->samplerCount = 0;
-	shader->uniformCount = 0;
-	shader->uniforms = NULL;
+	return 1;
+}
 
-	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
+void FosterShaderReflect_OpenGL(FosterShader_OpenGL* shader)
+{
+	// query uniforms and uniform blocks
+	GLint activeUniformCount = 0;
+	GLint activeBlockCount = 0;
+	fgl.glGetProgramiv(shader->id, GL_ACTIVE_UNIFORMS, &activeUniformCount);
+	if (fgl.glGetActiveUniformBlockiv != NULL)
+		fgl.glGetProgramiv(shader->id, GL_ACTIVE_UNIFORM_BLOCKS, &activeBlockCount);
+	if (activeBlockCount > FOSTER_MAX_UNIFORM_BUFFERS)
 	{
-		shader->textures[i] = NULL;
-		shader->samplers[i].filter = FOSTER_TEXTURE_FILTER_LINEAR;
-		shader->samplers[i].wrapX = FOSTER_TEXTURE_WRAP_CLAMP_TO_EDGE;
-		shader->samplers[i].wrapY = FOSTER_TEXTURE_WRAP_CLAMP_TO_EDGE;
+		FOSTER_LOG_ERROR("Shader has %i Uniform Blocks, but only %i are supported", activeBlockCount, FOSTER_MAX_UNIFORM_BUFFERS);
+		activeBlockCount = FOSTER_MAX_UNIFORM_BUFFERS;
 	}
 
-	// query uniforms and cache them
-	fgl.glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &shader->uniformCount);
+	// members of uniform blocks are set through their buffer, so skip them
+	GLint* blockIndices = NULL;
+	if (activeUniformCount > 0 && activeBlockCount > 0)
+	{
+		GLuint* indices = (GLuint*)SDL_malloc(sizeof(GLuint) * activeUniformCount);
+		blockIndices = (GLint*)SDL_malloc(sizeof(GLint) * activeUniformCount);
+		for (int i = 0; i < activeUniformCount; i++)
+			indices[i] = (GLuint)i;
+		fgl.glGetActiveUniformsiv(shader->id, activeUniformCount, indices, GL_UNIFORM_BLOCK_INDEX, blockIndices);
+		SDL_free(indices);
+	}
 
-	if (shader->uniformCount > 0)
+	// cache them
+	if (activeUniformCount + activeBlockCount > 0)
 	{
-		shader->uniforms = (FosterUniform_OpenGL*)SDL_malloc(sizeof(FosterUniform_OpenGL) * shader->uniformCount);
+		shader->uniforms = (FosterUniform_OpenGL*)SDL_malloc(sizeof(FosterUniform_OpenGL) * (activeUniformCount + activeBlockCount));
 
-		for (int i = 0; i < shader->uniformCount; i++)
+		for (int i = 0; i < activeUniformCount; i++)
 		{
-			FosterUniform_OpenGL* uniform = shader->uniforms + i;
+			if (blockIndices != NULL && blockIndices[i] >= 0)
+				continue;
+
+			FosterUniform_OpenGL* uniform = shader->uniforms + shader->uniformCount;
+			shader->uniformCount++;
 			uniform->glLocation = 0;
 			uniform->glSize = 0;
 			uniform->glType = 0;
 			uniform->name = NULL;
 			uniform->samplerName = NULL;
 			uniform->samplerIndex = 0;
+			uniform->bufferBinding = 0;
 
 			// get the name & properties
 			GLsizei nameLen;
 			char nameBuf[256];
-			fgl.glGetActiveUniform(id, i, 255, &nameLen, &uniform->glSize, &uniform->glType, nameBuf);
+			fgl.glGetActiveUniform(shader->id, i, 255, &nameLen, &uniform->glSize, &uniform->glType, nameBuf);
 
 			// array names end with "[0]", and we don't want that
 			for (int n = 0; n < nameLen - 2; n++)
@@ -1405,30 +2837,176 @@ FosterShader* FosterShaderCreate_OpenGL(FosterShaderData* data)
 					break;
 				}
 
-			// allocate enough room for the name
-			uniform->name = (char*)SDL_malloc(nameLen + 8);
-			SDL_strlcpy(uniform->name, nameBuf, nameLen + 1);
+			// allocate enough room for the name
+			uniform->name = (char*)SDL_malloc(nameLen + 8);
+			SDL_strlcpy(uniform->name, nameBuf, nameLen + 1);
+
+			// get GL location
+			uniform->glLocation = fgl.glGetUniformLocation(shader->id, uniform->name);
+
+			// if we're a sampler we need a unique sampler name + track what sampler index
+			if (FosterIsSamplerType_OpenGL(uniform->glType))
+			{
+				uniform->samplerName = (char*)SDL_malloc(nameLen + 16);
+				SDL_snprintf(uniform->samplerName, nameLen + 16, "%s_sampler", uniform->name);
+				uniform->samplerIndex = shader->samplerCount;
+				shader->samplerCount += uniform->glSize;
+			}
+		}
+
+		// each uniform block gets its own binding point, in order
+		for (int i = 0; i < activeBlockCount; i++)
+		{
+			FosterUniform_OpenGL* uniform = shader->uniforms + shader->uniformCount;
+			shader->uniformCount++;
+			uniform->glLocation = i;
+			uniform->glSize = 0;
+			uniform->glType = GL_UNIFORM_BUFFER;
+			uniform->samplerName = NULL;
+			uniform->samplerIndex = 0;
+			uniform->bufferBinding = shader->uniformBufferCount;
+			shader->uniformBufferCount++;
+
+			GLsizei nameLen;
+			char nameBuf[256];
+			fgl.glGetActiveUniformBlockName(shader->id, i, 255, &nameLen, nameBuf);
+			fgl.glGetActiveUniformBlockiv(shader->id, i, GL_UNIFORM_BLOCK_DATA_SIZE, &uniform->glSize);
+			fgl.glUniformBlockBinding(shader->id, i, uniform->bufferBinding);
+
+			uniform->name = (char*)SDL_malloc(nameLen + 1);
+			SDL_strlcpy(uniform->name, nameBuf, nameLen + 1);
+		}
+	}
+
+	SDL_free(blockIndices);
+}
+
+FosterShader_OpenGL* FosterShaderAlloc_OpenGL(FosterShaderData* data)
+{
+	if (data->vertexShader == NULL)
+	{
+		FOSTER_LOG_ERROR("Invalid Vertex Shader");
+		return NULL;
+	}
+
+	if (data->fragmentShader == NULL)
+	{
+		FOSTER_LOG_ERROR("Invalid Fragment Shader");
+		return NULL;
+	}
+
+	FosterShader_OpenGL* shader = (FosterShader_OpenGL*)SDL_malloc(sizeof(FosterShader_OpenGL));
+	shader->id = 0;
+	shader->pendingVertex = 0;
+	shader->pendingFragment = 0;
+	shader->pending = 0;
+	shader->failed = 0;
+	shader->cacheKey = 0;
+	shader->samplerCount = 0;
+	shader->uniformCount = 0;
+	shader->uniformBufferCount = 0;
+	shader->uniforms = NULL;
+
+	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
+	{
+		shader->textures[i] = NULL;
+		shader->samplers[i].filter = FOSTER_TEXTURE_FILTER_LINEAR;
+		shader->samplers[i].wrapX = FOSTER_TEXTURE_WRAP_CLAMP_TO_EDGE;
+		shader->samplers[i].wrapY = FOSTER_TEXTURE_WRAP_CLAMP_TO_EDGE;
+		shader->samplers[i].mipFilter = FOSTER_TEXTURE_MIP_FILTER_NONE;
+		shader->samplers[i].anisotropy = 0;
+	}
+
+	for (int i = 0; i < FOSTER_MAX_UNIFORM_BUFFERS; i++)
+		shader->uniformBuffers[i] = NULL;
+
+	// try the program binary cache before compiling from source
+	if (fgl.supportsProgramBinary)
+	{
+		const char* vertex = (const char*)data->vertexShader;
+		const char* fragment = (const char*)data->fragmentShader;
+		shader->cacheKey = FosterHash_OpenGL(FOSTER_HASH_SEED, vertex, SDL_strlen(vertex) + 1);
+		shader->cacheKey = FosterHash_OpenGL(shader->cacheKey, fragment, SDL_strlen(fragment));
+		shader->id = FosterProgramCacheLoad_OpenGL(shader->cacheKey);
+	}
+
+	if (shader->id != 0)
+		FosterShaderReflect_OpenGL(shader);
+	else
+		FosterShaderCompileBegin_OpenGL(shader, data);
+
+	return shader;
+}
 
-			// get GL location
-			uniform->glLocation = fgl.glGetUniformLocation(id, uniform->name);
+// Completes a pending shader, blocking until the driver is done with it
+int FosterShaderFinish_OpenGL(FosterShader_OpenGL* shader)
+{
+	if (shader->pending)
+	{
+		shader->pending = 0;
 
-			// if we're a sampler we need a unique sampler name + track what sampler index
-			if (uniform->glType == GL_SAMPLER_2D)
-			{
-				uniform->samplerName = (char*)SDL_malloc(nameLen + 16);
-				SDL_snprintf(uniform->samplerName, nameLen + 16, "%s_sampler", uniform->name);
-				uniform->samplerIndex = shader->samplerCount;
-				shader->samplerCount += uniform->glSize;
-			}
+		if (FosterShaderCompileEnd_OpenGL(shader))
+		{
+			if (fgl.supportsProgramBinary)
+				FosterProgramCacheSave_OpenGL(shader->cacheKey, shader->id);
+			FosterShaderReflect_OpenGL(shader);
+		}
+		else
+		{
+			shader->failed = 1;
 		}
 	}
 
+	return !shader->failed;
+}
+
+FosterShader* FosterShaderCreate_OpenGL(FosterShaderData* data)
+{
+	FosterShader_OpenGL* shader = FosterShaderAlloc_OpenGL(data);
+	if (shader == NULL)
+		return NULL;
+
+	if (!FosterShaderFinish_OpenGL(shader))
+	{
+		SDL_free(shader);
+		return NULL;
+	}
+
 	return (FosterShader*)shader;
 }
 
+FosterShader* FosterShaderCreateAsync_OpenGL(FosterShaderData* data)
+{
+	return (FosterShader*)FosterShaderAlloc_OpenGL(data);
+}
+
+FosterBool FosterShaderIsReady_OpenGL(FosterShader* shader)
+{
+	FosterShader_OpenGL* it = (FosterShader_OpenGL*)shader;
+
+	// without the extension there's no way to check without blocking,
+	// so the shader is simply finished here
+	if (it->pending && fgl.supportsParallelShaderCompile)
+	{
+		GLint complete = 0;
+		fgl.glGetProgramiv(it->id, GL_COMPLETION_STATUS_KHR, &complete);
+		if (!complete)
+			return 0;
+	}
+
+	FosterShaderFinish_OpenGL(it);
+	return 1;
+}
+
+FosterBool FosterShaderWait_OpenGL(FosterShader* shader)
+{
+	return FosterShaderFinish_OpenGL((FosterShader_OpenGL*)shader);
+}
+
 void FosterShaderGetUniforms_OpenGL(FosterShader* shader, FosterUniformInfo* output, int* count, int max)
 {
 	FosterShader_OpenGL* it = (FosterShader_OpenGL*)shader;
+	FosterShaderFinish_OpenGL(it);
 
 	int t = 0;
 
@@ -1438,11 +3016,11 @@ void FosterShaderGetUniforms_OpenGL(FosterShader* shader, FosterUniformInfo* out
 
 		// OpenGL doesn't have separate Sampler's and Texture's...
 		// So we create an "extra" uniform and add a "_sampler" suffix
-		if (uniform->glType == GL_SAMPLER_2D)
+		if (FosterIsSamplerType_OpenGL(uniform->glType))
 		{
 			output[t].index = i;
 			output[t].name = uniform->name;
-			output[t].type = FOSTER_UNIFORM_TYPE_TEXTURE2D;
+			output[t].type = uniform->glType == GL_SAMPLER_2D_ARRAY ? FOSTER_UNIFORM_TYPE_TEXTURE2D_ARRAY : FOSTER_UNIFORM_TYPE_TEXTURE2D;
 			output[t].arrayElements = uniform->glSize;
 			t++;
 
@@ -1452,6 +3030,14 @@ void FosterShaderGetUniforms_OpenGL(FosterShader* shader, FosterUniformInfo* out
 			output[t].arrayElements = uniform->glSize;
 			t++;
 		}
+		else if (uniform->glType == GL_UNIFORM_BUFFER)
+		{
+			output[t].index = i;
+			output[t].name = uniform->name;
+			output[t].type = FOSTER_UNIFORM_TYPE_UNIFORM_BUFFER;
+			output[t].arrayElements = 1;
+			t++;
+		}
 		else
 		{
 			output[t].index = i;
@@ -1515,7 +3101,7 @@ void FosterShaderSetTexture_OpenGL(FosterShader* shader, int index, FosterTextur
 	}
 
 	FosterUniform_OpenGL* uniform = it->uniforms + index;
-	if (uniform->glType != GL_SAMPLER_2D)
+	if (!FosterIsSamplerType_OpenGL(uniform->glType))
 	{
 		FOSTER_LOG_ERROR("Failed to set uniform '%s': not a Texture", uniform->name);
 		return;
@@ -1540,95 +3126,541 @@ void FosterShaderSetSampler_OpenGL(FosterShader* shader, int index, FosterTextur
 	}
 
 	FosterUniform_OpenGL* uniform = it->uniforms + index;
-	if (uniform->glType != GL_SAMPLER_2D)
+	if (!FosterIsSamplerType_OpenGL(uniform->glType))
 	{
 		FOSTER_LOG_ERROR("Failed to set uniform '%s': not a Sampler", uniform->name);
 		return;
 	}
 
-	for (int i = 0; i < uniform->glSize && uniform->samplerIndex + i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
-		it->samplers[uniform->samplerIndex + i] = values[i];
+	for (int i = 0; i < uniform->glSize && uniform->samplerIndex + i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
+		it->samplers[uniform->samplerIndex + i] = values[i];
+}
+
+void FosterUniformBufferReturnReference(FosterUniformBuffer_OpenGL* buffer)
+{
+	if (buffer != NULL)
+	{
+		buffer->refCount--;
+		if (buffer->refCount <= 0)
+		{
+			if (!buffer->disposed)
+				FOSTER_LOG_ERROR("Uniform Buffer is being free'd without deleting its GPU Buffer Data");
+			SDL_free(buffer);
+		}
+	}
+}
+
+FosterUniformBuffer_OpenGL* FosterUniformBufferRequestReference(FosterUniformBuffer_OpenGL* buffer)
+{
+	if (buffer != NULL)
+		buffer->refCount++;
+	return buffer;
+}
+
+void FosterShaderSetUniformBuffer_OpenGL(FosterShader* shader, int index, FosterUniformBuffer* buffer)
+{
+	FosterShader_OpenGL* it = (FosterShader_OpenGL*)shader;
+
+	if (index < 0 || index >= it->uniformCount)
+	{
+		FOSTER_LOG_ERROR("Failed to set uniform '%i': index out of bounds", index);
+		return;
+	}
+
+	FosterUniform_OpenGL* uniform = it->uniforms + index;
+	if (uniform->glType != GL_UNIFORM_BUFFER)
+	{
+		FOSTER_LOG_ERROR("Failed to set uniform '%s': not a Uniform Buffer", uniform->name);
+		return;
+	}
+
+	FosterUniformBufferReturnReference(it->uniformBuffers[uniform->bufferBinding]);
+	it->uniformBuffers[uniform->bufferBinding] = FosterUniformBufferRequestReference((FosterUniformBuffer_OpenGL*)buffer);
+}
+
+void FosterShaderDestroy_OpenGL(FosterShader* shader)
+{
+	FosterShader_OpenGL* it = (FosterShader_OpenGL*)shader;
+	fgl.glDeleteProgram(it->id);
+	fgl.glDeleteShader(it->pendingVertex);
+	fgl.glDeleteShader(it->pendingFragment);
+
+	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
+		FosterTextureReturnReference(it->textures[i]);
+
+	for (int i = 0; i < FOSTER_MAX_UNIFORM_BUFFERS; i++)
+		FosterUniformBufferReturnReference(it->uniformBuffers[i]);
+
+	for (int i = 0; i < it->uniformCount; i++)
+	{
+		SDL_free(it->uniforms[i].name);
+		SDL_free(it->uniforms[i].samplerName);
+	}
+
+	SDL_free(it->uniforms);
+	SDL_free(it);
+}
+
+FosterUniformBuffer* FosterUniformBufferCreate_OpenGL(int size)
+{
+	FosterUniformBuffer_OpenGL result;
+	result.id = 0;
+	result.size = size;
+	result.refCount = 1;
+	result.disposed = 0;
+
+	fgl.glGenBuffers(1, &result.id);
+	if (result.id == 0)
+	{
+		FOSTER_LOG_ERROR("%s", "Failed to create Uniform Buffer");
+		return NULL;
+	}
+
+	fgl.glBindBuffer(GL_UNIFORM_BUFFER, result.id);
+	fgl.glBufferData(GL_UNIFORM_BUFFER, size, NULL, GL_DYNAMIC_DRAW);
+
+	FosterUniformBuffer_OpenGL* buffer = (FosterUniformBuffer_OpenGL*)SDL_malloc(sizeof(FosterUniformBuffer_OpenGL));
+	*buffer = result;
+	return (FosterUniformBuffer*)buffer;
+}
+
+void FosterUniformBufferSetData_OpenGL(FosterUniformBuffer* buffer, void* data, int dataSize, int dataDestOffset)
+{
+	FosterUniformBuffer_OpenGL* it = (FosterUniformBuffer_OpenGL*)buffer;
+
+	if (dataDestOffset < 0 || dataDestOffset + dataSize > it->size)
+	{
+		FOSTER_LOG_ERROR("Failed to set Uniform Buffer data: %i bytes at offset %i is larger than the buffer", dataSize, dataDestOffset);
+		return;
+	}
+
+	fgl.glBindBuffer(GL_UNIFORM_BUFFER, it->id);
+
+	// replacing everything lets the driver hand us new memory instead of
+	// waiting for draws still reading from the old contents
+	if (dataDestOffset == 0 && dataSize == it->size)
+		fgl.glBufferData(GL_UNIFORM_BUFFER, it->size, NULL, GL_DYNAMIC_DRAW);
+
+	fgl.glBufferSubData(GL_UNIFORM_BUFFER, dataDestOffset, dataSize, data);
+	FOSTER_STAT_ADD(bufferBytesUploaded, dataSize);
+}
+
+void FosterUniformBufferDestroy_OpenGL(FosterUniformBuffer* buffer)
+{
+	FosterUniformBuffer_OpenGL* it = (FosterUniformBuffer_OpenGL*)buffer;
+
+	if (!it->disposed)
+	{
+		// make sure this isn't bound anymore
+		for (int i = 0; i < FOSTER_MAX_UNIFORM_BUFFERS; i ++)
+		{
+			if (fgl.stateUniformBuffers[i] == it->id)
+			{
+				fgl.glBindBufferBase(GL_UNIFORM_BUFFER, i, 0);
+				fgl.stateUniformBuffers[i] = 0;
+			}
+		}
+
+		// delete it
+		it->disposed = 1;
+		fgl.glDeleteBuffers(1, &it->id);
+		FosterUniformBufferReturnReference(it);
+	}
+}
+
+FosterMesh* FosterMeshCreateEx_OpenGL(int streaming)
+{
+	FosterMesh_OpenGL result;
+	SDL_memset(&result, 0, sizeof(FosterMesh_OpenGL));
+	result.streaming = streaming;
+
+	if (streaming)
+	{
+		for (int i = 0; i < FOSTER_MESH_STREAM_SLOTS; i++)
+		{
+			fgl.glGenVertexArrays(1, &result.streamSlots[i].id);
+			if (result.streamSlots[i].id == 0)
+			{
+				FOSTER_LOG_ERROR("%s", "Failed to create Mesh");
+				for (int j = 0; j < i; j++)
+					fgl.glDeleteVertexArrays(1, &result.streamSlots[j].id);
+				return NULL;
+			}
+		}
+
+		result.id = result.streamSlots[0].id;
+	}
+	else
+	{
+		fgl.glGenVertexArrays(1, &result.id);
+		if (result.id == 0)
+		{
+			FOSTER_LOG_ERROR("%s", "Failed to create Mesh");
+			return NULL;
+		}
+	}
+
+	FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)SDL_malloc(sizeof(FosterMesh_OpenGL));
+	*mesh = result;
+	return (FosterMesh*)mesh;
+}
+
+FosterMesh* FosterMeshCreate_OpenGL()
+{
+	return FosterMeshCreateEx_OpenGL(0);
+}
+
+FosterMesh* FosterMeshCreateStreaming_OpenGL()
+{
+	return FosterMeshCreateEx_OpenGL(1);
+}
+
+void FosterMeshStreamStore_OpenGL(FosterMesh_OpenGL* it)
+{
+	FosterMeshStreamSlot_OpenGL* slot = it->streamSlots + it->streamSlot;
+	slot->id = it->id;
+	slot->indexBuffer = it->indexBuffer;
+	slot->vertexBuffer = it->vertexBuffer;
+	slot->instanceBuffer = it->instanceBuffer;
+	slot->vertexBufferSize = it->vertexBufferSize;
+	slot->indexBufferSize = it->indexBufferSize;
+	slot->instanceBufferSize = it->instanceBufferSize;
+	slot->instanceStart = it->instanceStart;
+}
+
+void FosterMeshStreamLoad_OpenGL(FosterMesh_OpenGL* it, int index)
+{
+	FosterMeshStreamSlot_OpenGL* slot = it->streamSlots + index;
+	it->streamSlot = index;
+	it->id = slot->id;
+	it->indexBuffer = slot->indexBuffer;
+	it->vertexBuffer = slot->vertexBuffer;
+	it->instanceBuffer = slot->instanceBuffer;
+	it->vertexBufferSize = slot->vertexBufferSize;
+	it->indexBufferSize = slot->indexBufferSize;
+	it->instanceBufferSize = slot->instanceBufferSize;
+	it->instanceStart = slot->instanceStart;
+}
+
+void FosterMeshBufferCopy_OpenGL(GLuint src, GLuint dst, int* dstSize, int size, GLenum usage)
+{
+	// the copy targets don't affect any buffer state we track
+	fgl.glBindBuffer(GL_COPY_READ_BUFFER, src);
+	fgl.glBindBuffer(GL_COPY_WRITE_BUFFER, dst);
+	if (*dstSize < size)
+	{
+		*dstSize = size;
+		fgl.glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, usage);
+	}
+	fgl.glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, size);
+}
+
+void FosterMeshBufferResize_OpenGL(GLenum bufferType, GLuint buffer, int* bufferSize, int size, int preserveSize, GLenum usage)
+{
+	// reallocating discards the buffer contents, so anything before the
+	// write offset is copied out through a temporary buffer and back again
+	if (preserveSize > 0 && fgl.glCopyBufferSubData != NULL)
+	{
+		GLuint temp = 0;
+		int tempSize = 0;
+		fgl.glGenBuffers(1, &temp);
+		FosterMeshBufferCopy_OpenGL(buffer, temp, &tempSize, preserveSize, usage);
+
+		*bufferSize = size;
+		fgl.glBufferData(bufferType, size, NULL, usage);
+		FosterMeshBufferCopy_OpenGL(temp, buffer, bufferSize, preserveSize, usage);
+		fgl.glDeleteBuffers(1, &temp);
+	}
+	else
+	{
+		*bufferSize = size;
+		fgl.glBufferData(bufferType, size, NULL, usage);
+	}
+}
+
+GLbitfield FosterMeshBufferMapAccess_OpenGL(FosterMesh_OpenGL* it, int bufferSize, int dataSize, int dataDestOffset)
+{
+	GLbitfield access = GL_MAP_WRITE_BIT;
+
+	if (dataDestOffset == 0 && dataSize == bufferSize)
+		access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+	else
+		access |= GL_MAP_INVALIDATE_RANGE_BIT;
+
+	// Streaming buffers are guarded by fences, so they can be written to
+	// directly without letting the driver synchronize with the GPU
+	if (it->streaming)
+		access |= GL_MAP_UNSYNCHRONIZED_BIT;
+
+	return access;
+}
+
+void FosterMeshStreamAdvance_OpenGL(FosterMesh_OpenGL* it, FosterMeshBuffer_OpenGL buffer, int preserveSize)
+{
+	// nothing has read from the current slot yet, so it's safe to keep writing to it
+	if (!it->streaming || !it->streamSlotDrawn)
+		return;
+
+	// fence the slot we're leaving so we know when the GPU is done with it
+	FosterMeshStreamStore_OpenGL(it);
+	FosterMeshStreamSlot_OpenGL* prev = it->streamSlots + it->streamSlot;
+	if (fgl.supportsBufferMapping)
+		prev->fence = fgl.glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	// move to the next slot, waiting in the rare case the GPU is still reading from it
+	FosterMeshStreamLoad_OpenGL(it, (it->streamSlot + 1) % FOSTER_MESH_STREAM_SLOTS);
+	it->streamSlotDrawn = 0;
+
+	FosterMeshStreamSlot_OpenGL* slot = it->streamSlots + it->streamSlot;
+	if (slot->fence != NULL)
+	{
+		if (fgl.glClientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED) == GL_WAIT_FAILED)
+			FOSTER_LOG_ERROR("%s", "Failed waiting on Mesh buffer fence");
+		fgl.glDeleteSync(slot->fence);
+		slot->fence = NULL;
+	}
+
+	// Data before the write offset only exists in the previous slot, so carry it over.
+	// The copy happens on the GPU after the previous draws, so it doesn't stall.
+	if (preserveSize > 0 && fgl.glCopyBufferSubData != NULL)
+	{
+		GLenum usage = GL_STREAM_DRAW;
+		if (buffer == FOSTER_MESH_BUFFER_VERTEX && prev->vertexBuffer != 0)
+		{
+			if (it->vertexBuffer == 0)
+				fgl.glGenBuffers(1, &it->vertexBuffer);
+			FosterMeshBufferCopy_OpenGL(prev->vertexBuffer, it->vertexBuffer, &it->vertexBufferSize, preserveSize, usage);
+		}
+		else if (buffer == FOSTER_MESH_BUFFER_INDEX && prev->indexBuffer != 0)
+		{
+			if (it->indexBuffer == 0)
+				fgl.glGenBuffers(1, &it->indexBuffer);
+			FosterMeshBufferCopy_OpenGL(prev->indexBuffer, it->indexBuffer, &it->indexBufferSize, preserveSize, usage);
+		}
+		else if (buffer == FOSTER_MESH_BUFFER_INSTANCE && prev->instanceBuffer != 0)
+		{
+			if (it->instanceBuffer == 0)
+				fgl.glGenBuffers(1, &it->instanceBuffer);
+			FosterMeshBufferCopy_OpenGL(prev->instanceBuffer, it->instanceBuffer, &it->instanceBufferSize, preserveSize, usage);
+		}
+	}
+}
+
+void FosterMeshBindVertexBuffer_OpenGL(FosterMesh_OpenGL* it)
+{
+	FosterBindArray(it->id);
+
+	if (it->vertexBuffer == 0)
+	{
+		fgl.glGenBuffers(1, &(it->vertexBuffer));
+		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->vertexBuffer);
+		fgl.stateArrayBuffer = it->vertexBuffer;
+	}
+	else if (fgl.stateArrayBuffer != it->vertexBuffer)
+	{
+		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->vertexBuffer);
+		fgl.stateArrayBuffer = it->vertexBuffer;
+	}
+}
+
+void FosterMeshBindInstanceBuffer_OpenGL(FosterMesh_OpenGL* it)
+{
+	FosterBindArray(it->id);
+
+	if (it->instanceBuffer == 0)
+	{
+		fgl.glGenBuffers(1, &(it->instanceBuffer));
+		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->instanceBuffer);
+		fgl.stateArrayBuffer = it->instanceBuffer;
+	}
+	else if (fgl.stateArrayBuffer != it->instanceBuffer)
+	{
+		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->instanceBuffer);
+		fgl.stateArrayBuffer = it->instanceBuffer;
+	}
+}
+
+void FosterMeshBindIndexBuffer_OpenGL(FosterMesh_OpenGL* it)
+{
+	FosterBindArray(it->id);
+
+	if (it->indexBuffer == 0)
+	{
+		fgl.glGenBuffers(1, &(it->indexBuffer));
+		fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer);
+		fgl.stateElementBuffer = it->indexBuffer;
+	}
+	else if (fgl.stateElementBuffer != it->indexBuffer)
+	{
+		fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer);
+		fgl.stateElementBuffer = it->indexBuffer;
+	}
+}
+
+void FosterMeshBufferWrite_OpenGL(FosterMesh_OpenGL* it, GLenum bufferType, GLuint buffer, int* bufferSize, void* data, int dataSize, int dataDestOffset)
+{
+	GLenum usage = it->streaming ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW;
+
+	// expand buffer if needed
+	int totalSize = dataDestOffset + dataSize;
+	if (totalSize > *bufferSize)
+		FosterMeshBufferResize_OpenGL(bufferType, buffer, bufferSize, totalSize, dataDestOffset, usage);
+
+	// nothing to fill, the buffer was only being resized
+	if (data == NULL || dataSize <= 0)
+		return;
+
+	FOSTER_STAT_ADD(bufferBytesUploaded, dataSize);
+
+	if (it->streaming && fgl.supportsBufferMapping)
+	{
+		GLbitfield access = FosterMeshBufferMapAccess_OpenGL(it, *bufferSize, dataSize, dataDestOffset);
+		void* dst = fgl.glMapBufferRange(bufferType, dataDestOffset, dataSize, access);
+		if (dst != NULL)
+		{
+			SDL_memcpy(dst, data, dataSize);
+			if (fgl.glUnmapBuffer(bufferType))
+				return;
+		}
+
+		// mapping failed or the buffer contents were lost, so fall back to a regular upload
+	}
+
+	// fill data at the offset
+	fgl.glBufferSubData(bufferType, dataDestOffset, dataSize, data);
 }
 
-void FosterShaderDestroy_OpenGL(FosterShader* shader)
+void* FosterMeshBufferMap_OpenGL(FosterMesh_OpenGL* it, GLenum bufferType, GLuint buffer, int* bufferSize, int dataSize, int dataDestOffset)
 {
-	FosterShader_OpenGL* it = (FosterShader_OpenGL*)shader;
-	fgl.glDeleteProgram(it->id);
+	GLenum usage = it->streaming ? GL_STREAM_DRAW : GL_DYNAMIC_DRAW;
 
-	for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
-		FosterTextureReturnReference(it->textures[i]);
+	// expand buffer if needed
+	int totalSize = dataDestOffset + dataSize;
+	if (totalSize > *bufferSize)
+		FosterMeshBufferResize_OpenGL(bufferType, buffer, bufferSize, totalSize, dataDestOffset, usage);
 
-	for (int i = 0; i < it->uniformCount; i++)
+	GLbitfield access = FosterMeshBufferMapAccess_OpenGL(it, *bufferSize, dataSize, dataDestOffset);
+	FOSTER_STAT_ADD(bufferBytesUploaded, dataSize);
+	return fgl.glMapBufferRange(bufferType, dataDestOffset, dataSize, access);
+}
+
+void FosterMeshSetVertexFormat_OpenGL(FosterMesh* mesh, FosterVertexFormat* format)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+
+	// streaming meshes need the format assigned to every slot
+	int current = it->streamSlot;
+	int count = it->streaming ? FOSTER_MESH_STREAM_SLOTS : 1;
+	if (it->streaming)
+		FosterMeshStreamStore_OpenGL(it);
+
+	for (int i = 0; i < count; i++)
 	{
-		SDL_free(it->uniforms[i].name);
-		SDL_free(it->uniforms[i].samplerName);
+		if (it->streaming)
+			FosterMeshStreamLoad_OpenGL(it, (current + i) % FOSTER_MESH_STREAM_SLOTS);
+
+		FosterBindArray(it->id);
+		if (it->vertexBuffer == 0)
+			fgl.glGenBuffers(1, &(it->vertexBuffer));
+		FosterMeshAssignAttributes_OpenGL(it->vertexBuffer, GL_ARRAY_BUFFER, format, 0, 0);
+
+		if (it->streaming)
+			FosterMeshStreamStore_OpenGL(it);
 	}
 
-	SDL_free(it->uniforms);
-	SDL_free(it);
+	if (it->streaming)
+		FosterMeshStreamLoad_OpenGL(it, current);
 }
 
-FosterMesh* FosterMeshCreate_OpenGL()
+void FosterMeshSetVertexData_OpenGL(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
 {
-	FosterMesh_OpenGL result;
-	result.id = 0;
-	result.indexBuffer = 0;
-	result.vertexBuffer = 0;
-	result.instanceBuffer = 0;
-	result.vertexAttributesEnabled = 0;
-	result.instanceAttributesEnabled = 0;
-	result.vertexBufferSize = 0;
-	result.indexBufferSize = 0;
-
-	fgl.glGenVertexArrays(1, &result.id);
-	if (result.id == 0)
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+	FosterMeshStreamAdvance_OpenGL(it, FOSTER_MESH_BUFFER_VERTEX, dataDestOffset);
+	FosterMeshBindVertexBuffer_OpenGL(it);
+	FosterMeshBufferWrite_OpenGL(it, GL_ARRAY_BUFFER, it->vertexBuffer, &it->vertexBufferSize, data, dataSize, dataDestOffset);
+}
+
+void* FosterMeshMapVertexData_OpenGL(FosterMesh* mesh, int dataSize, int dataDestOffset)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+
+	if (!fgl.supportsBufferMapping || dataSize <= 0)
+		return NULL;
+
+	if (it->vertexMapped)
 	{
-		FOSTER_LOG_ERROR("%s", "Failed to create Mesh");
+		FOSTER_LOG_ERROR("%s", "Mesh Vertex Data is already mapped");
 		return NULL;
 	}
 
-	FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)SDL_malloc(sizeof(FosterMesh_OpenGL));
-	*mesh = result;
-	return (FosterMesh*)mesh;
+	FosterMeshStreamAdvance_OpenGL(it, FOSTER_MESH_BUFFER_VERTEX, dataDestOffset);
+	FosterMeshBindVertexBuffer_OpenGL(it);
+
+	void* result = FosterMeshBufferMap_OpenGL(it, GL_ARRAY_BUFFER, it->vertexBuffer, &it->vertexBufferSize, dataSize, dataDestOffset);
+	it->vertexMapped = (result != NULL);
+	return result;
 }
 
-void FosterMeshSetVertexFormat_OpenGL(FosterMesh* mesh, FosterVertexFormat* format)
+void FosterMeshUnmapVertexData_OpenGL(FosterMesh* mesh)
 {
 	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
-	FosterBindArray(it->id);
 
-	if (it->vertexBuffer == 0)
-		fgl.glGenBuffers(1, &(it->vertexBuffer));
-	FosterMeshAssignAttributes_OpenGL(it->vertexBuffer, GL_ARRAY_BUFFER, format, 0);
+	if (!it->vertexMapped)
+		return;
+
+	FosterMeshBindVertexBuffer_OpenGL(it);
+	if (!fgl.glUnmapBuffer(GL_ARRAY_BUFFER))
+		FOSTER_LOG_ERROR("%s", "Mesh Vertex Data was lost while mapped");
+	it->vertexMapped = 0;
 }
 
-void FosterMeshSetVertexData_OpenGL(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+void FosterMeshSetInstanceFormat_OpenGL(FosterMesh* mesh, FosterVertexFormat* format)
 {
 	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
-	FosterBindArray(it->id);
 
-	if (it->vertexBuffer == 0)
-	{
-		fgl.glGenBuffers(1, &(it->vertexBuffer));
-		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->vertexBuffer);
-		fgl.stateArrayBuffer = it->vertexBuffer;
-	}
-	else if (fgl.stateArrayBuffer != it->vertexBuffer)
+	if (format->elementCount > 32)
 	{
-		fgl.glBindBuffer(GL_ARRAY_BUFFER, it->vertexBuffer);
-		fgl.stateArrayBuffer = it->vertexBuffer;
+		FOSTER_LOG_ERROR("%s", "Mesh Instance Format has too many elements");
+		return;
 	}
 
-	// expand vertex buffer if needed
-	int totalSize = dataDestOffset + dataSize;
-	if (totalSize > it->vertexBufferSize)
+	// keep a copy so the attributes can be re-pointed when drawing
+	SDL_memcpy(it->instanceElements, format->elements, sizeof(FosterVertexFormatElement) * format->elementCount);
+	it->instanceFormat.elements = it->instanceElements;
+	it->instanceFormat.elementCount = format->elementCount;
+	it->instanceFormat.stride = format->stride;
+
+	// streaming meshes need the format assigned to every slot
+	int current = it->streamSlot;
+	int count = it->streaming ? FOSTER_MESH_STREAM_SLOTS : 1;
+	if (it->streaming)
+		FosterMeshStreamStore_OpenGL(it);
+
+	for (int i = 0; i < count; i++)
 	{
-		it->vertexBufferSize = totalSize;
-		fgl.glBufferData(GL_ARRAY_BUFFER, totalSize, NULL, GL_DYNAMIC_DRAW);
+		if (it->streaming)
+			FosterMeshStreamLoad_OpenGL(it, (current + i) % FOSTER_MESH_STREAM_SLOTS);
+
+		FosterBindArray(it->id);
+		if (it->instanceBuffer == 0)
+			fgl.glGenBuffers(1, &(it->instanceBuffer));
+		FosterMeshAssignAttributes_OpenGL(it->instanceBuffer, GL_ARRAY_BUFFER, &it->instanceFormat, 1, 0);
+		it->instanceStart = 0;
+
+		if (it->streaming)
+			FosterMeshStreamStore_OpenGL(it);
 	}
 
-	// fill data at the offset
-	fgl.glBufferSubData(GL_ARRAY_BUFFER, dataDestOffset, dataSize, data);
+	if (it->streaming)
+		FosterMeshStreamLoad_OpenGL(it, current);
+}
+
+void FosterMeshSetInstanceData_OpenGL(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+	FosterMeshStreamAdvance_OpenGL(it, FOSTER_MESH_BUFFER_INSTANCE, dataDestOffset);
+	FosterMeshBindInstanceBuffer_OpenGL(it);
+	FosterMeshBufferWrite_OpenGL(it, GL_ARRAY_BUFFER, it->instanceBuffer, &it->instanceBufferSize, data, dataSize, dataDestOffset);
 }
 
 void FosterMeshSetIndexFormat_OpenGL(FosterMesh* mesh, FosterIndexFormat format)
@@ -1651,38 +3683,140 @@ void FosterMeshSetIndexFormat_OpenGL(FosterMesh* mesh, FosterIndexFormat format)
 	}
 }
 
-void FosterMeshSetIndexData_OpenGL(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+void FosterEnsureQuadIndices_OpenGL(GLuint* buffer, int* capacity, int quadCount, int sixteenBit)
 {
-	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
-	FosterBindArray(it->id);
+	// binds to whichever vertex array is currently bound
+	if (*buffer == 0)
+		fgl.glGenBuffers(1, buffer);
+	fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *buffer);
+	fgl.stateElementBuffer = *buffer;
 
-	if (it->indexBuffer == 0)
+	if (quadCount <= *capacity)
+		return;
+
+	// grow in large steps so this rarely happens, but never past what 16-bit indices can address
+	int next = *capacity > 1024 ? *capacity : 1024;
+	while (next < quadCount)
+		next *= 2;
+	if (sixteenBit && next > FOSTER_MAX_QUADS_SIXTEEN_BIT)
+		next = FOSTER_MAX_QUADS_SIXTEEN_BIT;
+
+	int indexSize = sixteenBit ? 2 : 4;
+	void* data = SDL_malloc(next * 6 * indexSize);
+	for (int i = 0; i < next; i++)
 	{
-		fgl.glGenBuffers(1, &(it->indexBuffer));
-		fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer);
-		fgl.stateElementBuffer = it->indexBuffer;
+		uint32_t v = (uint32_t)i * 4;
+		uint32_t quad[6] = { v + 0, v + 1, v + 2, v + 0, v + 2, v + 3 };
+
+		for (int n = 0; n < 6; n++)
+		{
+			if (sixteenBit)
+				((uint16_t*)data)[i * 6 + n] = (uint16_t)quad[n];
+			else
+				((uint32_t*)data)[i * 6 + n] = quad[n];
+		}
 	}
-	else if (fgl.stateElementBuffer != it->indexBuffer)
+
+	fgl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, next * 6 * indexSize, data, GL_STATIC_DRAW);
+	FOSTER_STAT_ADD(bufferBytesUploaded, (int64_t)next * 6 * indexSize);
+	SDL_free(data);
+	*capacity = next;
+}
+
+void FosterMeshSetQuadIndices_OpenGL(FosterMesh* mesh, int quadCount)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+	int sixteenBit = quadCount <= FOSTER_MAX_QUADS_SIXTEEN_BIT;
+	GLuint* buffer = sixteenBit ? &fgl.quadIndexBuffer16 : &fgl.quadIndexBuffer32;
+	int* capacity = sixteenBit ? &fgl.quadIndexCapacity16 : &fgl.quadIndexCapacity32;
+
+	it->indexFormat = sixteenBit ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+	it->indexSize = sixteenBit ? 2 : 4;
+
+	FosterBindArray(it->id);
+	FosterEnsureQuadIndices_OpenGL(buffer, capacity, quadCount, sixteenBit);
+
+	// streaming meshes need the shared buffer bound to every slot
+	if (it->streaming)
 	{
-		fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer);
-		fgl.stateElementBuffer = it->indexBuffer;
+		for (int i = 0; i < FOSTER_MESH_STREAM_SLOTS; i++)
+		{
+			if (i == it->streamSlot)
+				continue;
+			FosterBindArray(it->streamSlots[i].id);
+			fgl.glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, *buffer);
+		}
+		FosterBindArray(it->id);
 	}
-	// expand buffer if needed
-	int totalSize = dataDestOffset + dataSize;
-	if (totalSize > it->indexBufferSize)
+}
+
+void FosterMeshSetIndexData_OpenGL(FosterMesh* mesh, void* data, int dataSize, int dataDestOffset)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+	FosterMeshStreamAdvance_OpenGL(it, FOSTER_MESH_BUFFER_INDEX, dataDestOffset);
+	FosterMeshBindIndexBuffer_OpenGL(it);
+	FosterMeshBufferWrite_OpenGL(it, GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer, &it->indexBufferSize, data, dataSize, dataDestOffset);
+}
+
+void* FosterMeshMapIndexData_OpenGL(FosterMesh* mesh, int dataSize, int dataDestOffset)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+
+	if (!fgl.supportsBufferMapping || dataSize <= 0)
+		return NULL;
+
+	if (it->indexMapped)
 	{
-		it->indexBufferSize = totalSize;
-		fgl.glBufferData(GL_ELEMENT_ARRAY_BUFFER, totalSize, NULL, GL_DYNAMIC_DRAW);
+		FOSTER_LOG_ERROR("%s", "Mesh Index Data is already mapped");
+		return NULL;
 	}
 
-	// fill data from the offset
-	fgl.glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, dataDestOffset, dataSize, data);
+	FosterMeshStreamAdvance_OpenGL(it, FOSTER_MESH_BUFFER_INDEX, dataDestOffset);
+	FosterMeshBindIndexBuffer_OpenGL(it);
+
+	void* result = FosterMeshBufferMap_OpenGL(it, GL_ELEMENT_ARRAY_BUFFER, it->indexBuffer, &it->indexBufferSize, dataSize, dataDestOffset);
+	it->indexMapped = (result != NULL);
+	return result;
+}
+
+void FosterMeshUnmapIndexData_OpenGL(FosterMesh* mesh)
+{
+	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
+
+	if (!it->indexMapped)
+		return;
+
+	FosterMeshBindIndexBuffer_OpenGL(it);
+	if (!fgl.glUnmapBuffer(GL_ELEMENT_ARRAY_BUFFER))
+		FOSTER_LOG_ERROR("%s", "Mesh Index Data was lost while mapped");
+	it->indexMapped = 0;
 }
 
 void FosterMeshDestroy_OpenGL(FosterMesh* mesh)
 {
 	FosterMesh_OpenGL* it = (FosterMesh_OpenGL*)mesh;
 
+	if (it->streaming)
+	{
+		FosterMeshStreamStore_OpenGL(it);
+		for (int i = 0; i < FOSTER_MESH_STREAM_SLOTS; i++)
+		{
+			FosterMeshStreamSlot_OpenGL* slot = it->streamSlots + i;
+			if (slot->fence != NULL)
+				fgl.glDeleteSync(slot->fence);
+			if (slot->vertexBuffer != 0)
+				fgl.glDeleteBuffers(1, &slot->vertexBuffer);
+			if (slot->indexBuffer != 0)
+				fgl.glDeleteBuffers(1, &slot->indexBuffer);
+			if (slot->instanceBuffer != 0)
+				fgl.glDeleteBuffers(1, &slot->instanceBuffer);
+			if (slot->id != 0)
+				fgl.glDeleteVertexArrays(1, &slot->id);
+		}
+
+		it->vertexBuffer = it->indexBuffer = it->instanceBuffer = it->id = 0;
+	}
+
 	if (it->vertexBuffer != 0)
 		fgl.glDeleteBuffers(1, &it->vertexBuffer);
 	if (it->indexBuffer != 0)
@@ -1695,70 +3829,88 @@ void FosterMeshDestroy_OpenGL(FosterMesh* mesh)
 	SDL_free(it);
 }
 
-void FosterDraw_OpenGL(FosterDrawCommand* command)
+void FosterBindShaderTextures_OpenGL(FosterShader_OpenGL* shader)
 {
-	FosterTarget_OpenGL* target = (FosterTarget_OpenGL*)command->target;
-	FosterShader_OpenGL* shader = (FosterShader_OpenGL*)command->shader;
-	FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)command->mesh;
+	GLuint textureSlots[FOSTER_MAX_UNIFORM_TEXTURES];
 
-	// Set State
-	FosterBindFrameBuffer(target);
-	FosterBindProgram(shader->id);
-	FosterBindArray(mesh->id);
-	FosterSetBlend(&command->blend);
-	FosterSetCompare(command->compare);
-	FosterSetDepthMask(command->depthMask);
-	FosterSetCull(command->cull);
-	FosterSetViewport(command->hasViewport, command->viewport);
-	FosterSetScissor(command->hasScissor, command->scissor);
-
-	// Update Texture Uniforms & Samplers
+	// update samplers, if they're not bound per slot below
+	if (!fgl.supportsSamplerObjects)
 	{
-		GLuint textureSlots[FOSTER_MAX_UNIFORM_TEXTURES];
-
-		// update samplers
 		for (int i = 0; i < FOSTER_MAX_UNIFORM_TEXTURES; i++)
 		{
-			FosterTexture_OpenGL* tex = shader->textures[i];
 			if (shader->textures[i] != NULL)
 				FosterSetTextureSampler(shader->textures[i], shader->samplers[i]);
 		}
+	}
+
+	// bind textures
+	int slot = 0;
+	for (int i = 0; i < shader->uniformCount; i++)
+	{
+		FosterUniform_OpenGL* uniform = shader->uniforms + i;
+		if (!FosterIsSamplerType_OpenGL(uniform->glType))
+			continue;
+
+		// textures that don't match the sampler type are left unbound
+		GLenum target = uniform->glType == GL_SAMPLER_2D_ARRAY ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
 
-		// bind textures
-		int slot = 0;
-		for (int i = 0; i < shader->uniformCount; i++)
+		// bind textures & update sampler state
+		for (int n = 0; n < uniform->glSize && slot < FOSTER_MAX_UNIFORM_TEXTURES; n++)
 		{
-			FosterUniform_OpenGL* uniform = shader->uniforms + i;
-			if (uniform->glType != GL_SAMPLER_2D)
-				continue;
+			FosterTexture_OpenGL* tex = shader->textures[uniform->samplerIndex + n];
 
-			// bind textures & update sampler state
-			for (int n = 0; n < uniform->glSize && slot < FOSTER_MAX_UNIFORM_TEXTURES; n++)
+			if (tex != NULL && !tex->disposed && tex->glTarget == target)
 			{
-				FosterTexture_OpenGL* tex = shader->textures[uniform->samplerIndex + n];
-
-				if (tex != NULL && !tex->disposed)
-				{
-					FosterEnsureTextureSlotIs(slot, tex->id);
-					textureSlots[n] = slot;
-					slot++;
-				}
-				else
-				{
-					textureSlots[n] = 0;
-				}
+				FosterEnsureTextureSlotIs(slot, target, tex->id);
+				if (fgl.supportsSamplerObjects)
+					FosterEnsureSamplerSlotIs(slot, FosterGetSamplerObject(shader->samplers[uniform->samplerIndex + n]));
+				textureSlots[n] = slot;
+				slot++;
 			}
+			else
+			{
+				// still give the sampler a unit of its own, as GL fails the draw if
+				// samplers of different types share one (such as the default, 0)
+				textureSlots[n] = slot;
+				slot++;
+			}
+		}
+
+		// bind texture slots for this uniform
+		fgl.glUniform1iv(uniform->glLocation, (GLint)uniform->glSize, textureSlots);
+	}
+}
+
+void FosterBindShaderUniformBuffers_OpenGL(FosterShader_OpenGL* shader)
+{
+	for (int i = 0; i < shader->uniformBufferCount; i++)
+	{
+		FosterUniformBuffer_OpenGL* buffer = shader->uniformBuffers[i];
+		GLuint id = (buffer != NULL && !buffer->disposed) ? buffer->id : 0;
 
-			// bind texture slots for this uniform
-			fgl.glUniform1iv(uniform->glLocation, (GLint)uniform->glSize, textureSlots);
+		if (fgl.stateUniformBuffers[i] != id)
+		{
+			fgl.glBindBufferBase(GL_UNIFORM_BUFFER, i, id);
+			fgl.stateUniformBuffers[i] = id;
 		}
 	}
+}
+
+void FosterDrawMesh_OpenGL(FosterMesh_OpenGL* mesh, FosterDrawCommand* command, int baseVertex)
+{
+	mesh->streamSlotDrawn = 1;
+	int64_t indexStartPtr = mesh->indexSize * command->indexStart;
 
-	// Draw the Mesh
+	if (command->instanceCount > 0)
 	{
-		int64_t indexStartPtr = mesh->indexSize * command->indexStart;
+		if (mesh->instanceStart != command->instanceStart && mesh->instanceFormat.elementCount > 0)
+		{
+			size_t offset = (size_t)command->instanceStart * mesh->instanceFormat.stride;
+			FosterMeshAssignAttributes_OpenGL(mesh->instanceBuffer, GL_ARRAY_BUFFER, &mesh->instanceFormat, 1, offset);
+			mesh->instanceStart = command->instanceStart;
+		}
 
-		if (command->instanceCount > 0)
+		if (baseVertex == 0)
 		{
 			fgl.glDrawElementsInstanced(
 				GL_TRIANGLES,
@@ -1767,15 +3919,246 @@ void FosterDraw_OpenGL(FosterDrawCommand* command)
 				(void*)indexStartPtr,
 				(GLint)command->instanceCount);
 		}
+		else if (fgl.glDrawElementsInstancedBaseVertex != NULL)
+		{
+			fgl.glDrawElementsInstancedBaseVertex(
+				GL_TRIANGLES,
+				(GLsizei)(command->indexCount),
+				mesh->indexFormat,
+				(void*)indexStartPtr,
+				(GLsizei)command->instanceCount,
+				(GLint)baseVertex);
+		}
 		else
+		{
+			FOSTER_LOG_ERROR("%s", "Instanced Draw Range Base Vertices are not supported by the current OpenGL context");
+			return;
+		}
+	}
+	else
+	{
+		fgl.glDrawElements(
+			GL_TRIANGLES,
+			(GLint)(command->indexCount),
+			mesh->indexFormat,
+			(void*)indexStartPtr);
+	}
+
+	FOSTER_STAT_ADD(drawCalls, 1);
+}
+
+FosterPipeline* FosterPipelineCreate_OpenGL(FosterPipelineData* data)
+{
+	FosterPipeline_OpenGL* pipeline = (FosterPipeline_OpenGL*)SDL_malloc(sizeof(FosterPipeline_OpenGL));
+	FosterPipelineStateInit(&pipeline->state, data);
+	return (FosterPipeline*)pipeline;
+}
+
+void FosterPipelineDestroy_OpenGL(FosterPipeline* pipeline)
+{
+	SDL_free(pipeline);
+}
+
+void FosterSetDrawState_OpenGL(FosterDrawCommand* last, FosterDrawCommand* command)
+{
+	FosterTarget_OpenGL* target = (FosterTarget_OpenGL*)command->target;
+	FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)command->mesh;
+
+	// Set State, only touching what changed since the previous command.
+	if (last == NULL || last->target != command->target)
+		FosterBindFrameBuffer(target);
+	if (last == NULL || last->mesh != command->mesh)
+		FosterBindArray(mesh->id);
+
+	// Commands drawn with the same Pipeline share all of its state.
+	// Shader uniform values can't change in the middle of a batch, so textures
+	// and uniform buffers only need to be re-bound when the shader itself changes.
+	if (last == NULL || command->pipeline == NULL || last->pipeline != command->pipeline)
+	{
+		FosterPipelineState state, prev;
+		FosterDrawCommandGetState(command, &state);
+		if (last != NULL)
+			FosterDrawCommandGetState(last, &prev);
+
+		FosterShader_OpenGL* shader = (FosterShader_OpenGL*)state.shader;
+		if (last == NULL || prev.shader != state.shader)
+		{
+			FosterShaderFinish_OpenGL(shader);
+			FosterBindProgram(shader->id);
+			FosterBindShaderTextures_OpenGL(shader);
+			FosterBindShaderUniformBuffers_OpenGL(shader);
+		}
+		if (last == NULL || SDL_memcmp(&prev.blend, &state.blend, sizeof(FosterBlend)) != 0)
+			FosterSetBlend(&state.blend);
+		if (last == NULL || prev.compare != state.compare)
+			FosterSetCompare(state.compare);
+		if (last == NULL || prev.depthMask != state.depthMask)
+			FosterSetDepthMask(state.depthMask);
+		if (last == NULL || prev.cull != state.cull)
+			FosterSetCull(state.cull);
+	}
+
+	if (last == NULL || last->target != command->target ||
+		last->hasViewport != command->hasViewport ||
+		(command->hasViewport && !FOSTER_RECT_EQUAL(last->viewport, command->viewport)))
+		FosterSetViewport(command->hasViewport, command->viewport);
+	if (last == NULL || last->target != command->target ||
+		last->hasScissor != command->hasScissor ||
+		(command->hasScissor && !FOSTER_RECT_EQUAL(last->scissor, command->scissor)))
+		FosterSetScissor(command->hasScissor, command->scissor);
+}
+
+int FosterDrawStateEqual_OpenGL(FosterDrawCommand* a, FosterDrawCommand* b)
+{
+	return
+		a->target == b->target &&
+		a->mesh == b->mesh &&
+		a->hasViewport == b->hasViewport &&
+		(!a->hasViewport || FOSTER_RECT_EQUAL(a->viewport, b->viewport)) &&
+		a->hasScissor == b->hasScissor &&
+		(!a->hasScissor || FOSTER_RECT_EQUAL(a->scissor, b->scissor)) &&
+		FosterDrawCommandStateEqual(a, b);
+}
+
+void FosterEnsureDrawRanges_OpenGL(int count)
+{
+	if (count <= fgl.drawRangeCapacity)
+		return;
+
+	int capacity = fgl.drawRangeCapacity > 0 ? fgl.drawRangeCapacity : 64;
+	while (capacity < count)
+		capacity *= 2;
+
+	fgl.drawRanges = (FosterDrawRange*)SDL_realloc(fgl.drawRanges, sizeof(FosterDrawRange) * capacity);
+	fgl.drawCounts = (GLsizei*)SDL_realloc(fgl.drawCounts, sizeof(GLsizei) * capacity);
+	fgl.drawOffsets = (void**)SDL_realloc(fgl.drawOffsets, sizeof(void*) * capacity);
+	fgl.drawBaseVertices = (GLint*)SDL_realloc(fgl.drawBaseVertices, sizeof(GLint) * capacity);
+	fgl.drawRangeCapacity = capacity;
+}
+
+void FosterDrawMeshRanges_OpenGL(FosterMesh_OpenGL* mesh, FosterDrawRange* ranges, int count)
+{
+	mesh->streamSlotDrawn = 1;
+
+	// submit every range with a single driver call where possible
+	if (count > 1 && fgl.glMultiDrawElementsBaseVertex != NULL)
+	{
+		FosterEnsureDrawRanges_OpenGL(count);
+
+		for (int i = 0; i < count; i++)
+		{
+			fgl.drawCounts[i] = (GLsizei)ranges[i].indexCount;
+			fgl.drawOffsets[i] = (void*)((int64_t)mesh->indexSize * ranges[i].indexStart);
+			fgl.drawBaseVertices[i] = (GLint)ranges[i].baseVertex;
+		}
+
+		fgl.glMultiDrawElementsBaseVertex(
+			GL_TRIANGLES,
+			fgl.drawCounts,
+			mesh->indexFormat,
+			(const void* const*)fgl.drawOffsets,
+			(GLsizei)count,
+			fgl.drawBaseVertices);
+		FOSTER_STAT_ADD(drawCalls, 1);
+		return;
+	}
+
+	for (int i = 0; i < count; i++)
+	{
+		int64_t indexStartPtr = mesh->indexSize * ranges[i].indexStart;
+
+		if (ranges[i].baseVertex == 0)
 		{
 			fgl.glDrawElements(
 				GL_TRIANGLES,
-				(GLint)(command->indexCount),
+				(GLint)(ranges[i].indexCount),
 				mesh->indexFormat,
 				(void*)indexStartPtr);
+			FOSTER_STAT_ADD(drawCalls, 1);
+		}
+		else if (fgl.glDrawElementsBaseVertex != NULL)
+		{
+			fgl.glDrawElementsBaseVertex(
+				GL_TRIANGLES,
+				(GLsizei)(ranges[i].indexCount),
+				mesh->indexFormat,
+				(void*)indexStartPtr,
+				(GLint)ranges[i].baseVertex);
+			FOSTER_STAT_ADD(drawCalls, 1);
+		}
+		else
+		{
+			FOSTER_LOG_ERROR("%s", "Draw Range Base Vertices are not supported by the current OpenGL context");
+		}
+	}
+}
+
+void FosterDrawBatch_OpenGL(FosterDrawCommand* commands, int count)
+{
+	FosterDrawCommand* last = NULL;
+
+	for (int i = 0; i < count;)
+	{
+		FosterDrawCommand* command = commands + i;
+		FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)command->mesh;
+		FosterSetDrawState_OpenGL(last, command);
+
+		// following commands that only differ by their index range are drawn together
+		int run = 1;
+		if (command->instanceCount <= 0)
+		{
+			while (i + run < count &&
+				commands[i + run].instanceCount <= 0 &&
+				FosterDrawStateEqual_OpenGL(command, commands + i + run))
+				run++;
+		}
+
+		// Draw the Mesh
+		if (run > 1)
+		{
+			FosterEnsureDrawRanges_OpenGL(run);
+			for (int n = 0; n < run; n++)
+			{
+				fgl.drawRanges[n].indexStart = commands[i + n].indexStart;
+				fgl.drawRanges[n].indexCount = commands[i + n].indexCount;
+				fgl.drawRanges[n].baseVertex = 0;
+			}
+			FosterDrawMeshRanges_OpenGL(mesh, fgl.drawRanges, run);
+		}
+		else
+		{
+			FosterDrawMesh_OpenGL(mesh, command, 0);
 		}
+
+		last = commands + i + run - 1;
+		i += run;
+	}
+}
+
+void FosterDrawList_OpenGL(FosterDrawCommand* command, FosterDrawRange* ranges, int rangeCount)
+{
+	FosterMesh_OpenGL* mesh = (FosterMesh_OpenGL*)command->mesh;
+	FosterSetDrawState_OpenGL(NULL, command);
+
+	// instanced draws have no multi-draw equivalent, so they're drawn one range at a time
+	if (command->instanceCount > 0)
+	{
+		FosterDrawCommand range = *command;
+		for (int i = 0; i < rangeCount; i++)
+		{
+			range.indexStart = ranges[i].indexStart;
+			range.indexCount = ranges[i].indexCount;
+			FosterDrawMesh_OpenGL(mesh, &range, ranges[i].baseVertex);
+		}
+		return;
 	}
+
+	FosterDrawMeshRanges_OpenGL(mesh, ranges, rangeCount);
+}
+
+void FosterDraw_OpenGL(FosterDrawCommand* command)
+{
+	FosterDrawBatch_OpenGL(command, 1);
 }
 
 void FosterClear_OpenGL(FosterClearCommand* command)
@@ -1820,27 +4203,65 @@ bool FosterGetDevice_OpenGL(FosterRenderDevice* device)
 	device->shutdown = FosterShutdown_OpenGL;
 	device->frameBegin = FosterFrameBegin_OpenGL;
 	device->frameEnd = FosterFrameEnd_OpenGL;
+	device->textureFormatSupported = FosterTextureFormatSupported_OpenGL;
 	device->textureCreate = FosterTextureCreate_OpenGL;
 	device->textureSetData = FosterTextureSetData_OpenGL;
+	device->textureCreateArray = FosterTextureCreateArray_OpenGL;
+	device->textureSetLayerData = FosterTextureSetLayerData_OpenGL;
+	device->textureSetLevelData = FosterTextureSetLevelData_OpenGL;
+	device->textureGenerateMipmaps = FosterTextureGenerateMipmaps_OpenGL;
+	device->textureSetSubData = FosterTextureSetSubData_OpenGL;
+	device->textureUploadBegin = FosterTextureUploadBegin_OpenGL;
+	device->textureUploadGetData = FosterTextureUploadGetData_OpenGL;
+	device->textureUploadSubmit = FosterTextureUploadSubmit_OpenGL;
+	device->textureUploadCancel = FosterTextureUploadCancel_OpenGL;
 	device->textureGetData = FosterTextureGetData_OpenGL;
+	device->textureReadAsync = FosterTextureReadAsync_OpenGL;
+	device->readbackPoll = FosterReadbackPoll_OpenGL;
+	device->readbackGet = FosterReadbackGet_OpenGL;
+	device->readbackDestroy = FosterReadbackDestroy_OpenGL;
 	device->textureDestroy = FosterTextureDestroy_OpenGL;
 	device->targetCreate = FosterTargetCreate_OpenGL;
 	device->targetGetAttachment = FosterTargetGetAttachment_OpenGL;
 	device->targetDestroy = FosterTargetDestroy_OpenGL;
+	device->targetDiscard = FosterTargetDiscard_OpenGL;
 	device->shaderCreate = FosterShaderCreate_OpenGL;
+	device->shaderCreateAsync = FosterShaderCreateAsync_OpenGL;
+	device->shaderIsReady = FosterShaderIsReady_OpenGL;
+	device->shaderWait = FosterShaderWait_OpenGL;
 	device->shaderSetUniform = FosterShaderSetUniform_OpenGL;
 	device->shaderSetTexture = FosterShaderSetTexture_OpenGL;
 	device->shaderSetSampler = FosterShaderSetSampler_OpenGL;
+	device->shaderSetUniformBuffer = FosterShaderSetUniformBuffer_OpenGL;
 	device->shaderGetUniforms = FosterShaderGetUniforms_OpenGL;
 	device->shaderDestroy = FosterShaderDestroy_OpenGL;
+	device->uniformBufferCreate = FosterUniformBufferCreate_OpenGL;
+	device->uniformBufferSetData = FosterUniformBufferSetData_OpenGL;
+	device->uniformBufferDestroy = FosterUniformBufferDestroy_OpenGL;
 	device->meshCreate = FosterMeshCreate_OpenGL;
+	device->meshCreateStreaming = FosterMeshCreateStreaming_OpenGL;
 	device->meshSetVertexFormat = FosterMeshSetVertexFormat_OpenGL;
 	device->meshSetVertexData = FosterMeshSetVertexData_OpenGL;
+	device->meshMapVertexData = FosterMeshMapVertexData_OpenGL;
+	device->meshUnmapVertexData = FosterMeshUnmapVertexData_OpenGL;
+	device->meshSetInstanceFormat = FosterMeshSetInstanceFormat_OpenGL;
+	device->meshSetInstanceData = FosterMeshSetInstanceData_OpenGL;
 	device->meshSetIndexFormat = FosterMeshSetIndexFormat_OpenGL;
 	device->meshSetIndexData = FosterMeshSetIndexData_OpenGL;
+	device->meshSetQuadIndices = FosterMeshSetQuadIndices_OpenGL;
+	device->meshMapIndexData = FosterMeshMapIndexData_OpenGL;
+	device->meshUnmapIndexData = FosterMeshUnmapIndexData_OpenGL;
 	device->meshDestroy = FosterMeshDestroy_OpenGL;
+	device->pipelineCreate = FosterPipelineCreate_OpenGL;
+	device->pipelineDestroy = FosterPipelineDestroy_OpenGL;
 	device->draw = FosterDraw_OpenGL;
+	device->drawBatch = FosterDrawBatch_OpenGL;
+	device->drawList = FosterDrawList_OpenGL;
 	device->clear = FosterClear_OpenGL;
+	device->gpuFrameTime = FosterGpuFrameTime_OpenGL;
+	device->gpuScopeBegin = FosterGpuScopeBegin_OpenGL;
+	device->gpuScopeEnd = FosterGpuScopeEnd_OpenGL;
+	device->gpuScopes = FosterGpuScopes_OpenGL;
 	return true;
 }
 
@@ -0,0 +1,269 @@
+#include "foster_platform.h"
+#include "foster_internal.h"
+#include "foster_trace.h"
+
+#define FOSTER_TRACE_MAX_DEPTH 64
+
+#if defined(_MSC_VER)
+#define FOSTER_THREAD_LOCAL __declspec(thread)
+#else
+#define FOSTER_THREAD_LOCAL _Thread_local
+#endif
+
+#if defined(FOSTER_TRACE_ENABLED) && defined(FOSTER_TRACE_TRACY)
+
+// zones begun through the public API, which Tracy needs to end in order
+typedef struct FosterTraceStack
+{
+	TracyCZoneCtx zones[FOSTER_TRACE_MAX_DEPTH];
+	int depth;
+} FosterTraceStack;
+
+static FOSTER_THREAD_LOCAL FosterTraceStack ftraceStack;
+
+FosterBool FosterTraceEnabled()
+{
+	return 1;
+}
+
+void FosterTraceBegin(const char* name)
+{
+	// zones past the limit are still counted, so that they end in the right place
+	if (ftraceStack.depth < FOSTER_TRACE_MAX_DEPTH)
+	{
+		TracyCZone(zone, 1);
+		if (name != NULL)
+			TracyCZoneName(zone, name, SDL_strlen(name));
+		ftraceStack.zones[ftraceStack.depth] = zone;
+	}
+	ftraceStack.depth++;
+}
+
+void FosterTraceEnd()
+{
+	if (ftraceStack.depth <= 0)
+		return;
+
+	ftraceStack.depth--;
+	if (ftraceStack.depth < FOSTER_TRACE_MAX_DEPTH)
+		TracyCZoneEnd(ftraceStack.zones[ftraceStack.depth]);
+}
+
+void FosterTraceFlush(FosterWriteFn func, void* context)
+{
+	// Tracy streams zones to its profiler as they're recorded
+}
+
+#elif defined(FOSTER_TRACE_ENABLED)
+
+#define FOSTER_TRACE_CHUNK_EVENTS 4096
+#define FOSTER_TRACE_NAME_LENGTH 48
+#define FOSTER_TRACE_WRITE_BUFFER 16384
+
+typedef struct FosterTraceEvent
+{
+	char name[FOSTER_TRACE_NAME_LENGTH];
+	Uint64 start;
+	Uint64 end;
+} FosterTraceEvent;
+
+// Events are only ever appended by the thread that owns the chunk, which
+// publishes them by incrementing the count, so recording never takes a lock
+typedef struct FosterTraceChunk
+{
+	FosterTraceEvent events[FOSTER_TRACE_CHUNK_EVENTS];
+	SDL_atomic_t count;
+	void* next;
+} FosterTraceChunk;
+
+typedef struct FosterTraceThread
+{
+	SDL_threadID id;
+
+	// the chunk being written to, owned by the recording thread
+	FosterTraceChunk* last;
+
+	// the oldest chunk that hasn't been flushed, owned by FosterTraceFlush
+	FosterTraceChunk* first;
+	int flushed;
+
+	// zones begun through the public API
+	char stackNames[FOSTER_TRACE_MAX_DEPTH][FOSTER_TRACE_NAME_LENGTH];
+	Uint64 stackStarts[FOSTER_TRACE_MAX_DEPTH];
+	int depth;
+
+	struct FosterTraceThread* next;
+} FosterTraceThread;
+
+// every thread that has recorded a zone, pushed without locking
+static void* ftraceThreads = NULL;
+static FOSTER_THREAD_LOCAL FosterTraceThread* ftraceThread = NULL;
+
+void FosterTraceCopyName(char* dst, const char* src)
+{
+	// names are written into JSON strings as-is, so anything that would need escaping is replaced
+	int i = 0;
+	if (src != NULL)
+	{
+		for (; i < FOSTER_TRACE_NAME_LENGTH - 1 && src[i] != '\0'; i ++)
+		{
+			char c = src[i];
+			dst[i] = (c == '"' || c == '\\' || (unsigned char)c < 0x20) ? '_' : c;
+		}
+	}
+	dst[i] = '\0';
+}
+
+FosterTraceThread* FosterTraceGetThread()
+{
+	if (ftraceThread != NULL)
+		return ftraceThread;
+
+	FosterTraceThread* it = (FosterTraceThread*)SDL_malloc(sizeof(FosterTraceThread));
+	SDL_memset(it, 0, sizeof(FosterTraceThread));
+	it->id = SDL_ThreadID();
+	it->last = it->first = (FosterTraceChunk*)SDL_malloc(sizeof(FosterTraceChunk));
+	SDL_memset(it->first, 0, sizeof(FosterTraceChunk));
+
+	do
+	{
+		it->next = (FosterTraceThread*)SDL_AtomicGetPtr(&ftraceThreads);
+	}
+	while (!SDL_AtomicCASPtr(&ftraceThreads, it->next, it));
+
+	ftraceThread = it;
+	return it;
+}
+
+void FosterTraceRecord(const char* name, Uint64 start, Uint64 end)
+{
+	FosterTraceThread* thread = FosterTraceGetThread();
+	FosterTraceChunk* chunk = thread->last;
+	int index = SDL_AtomicGet(&chunk->count);
+
+	if (index >= FOSTER_TRACE_CHUNK_EVENTS)
+	{
+		FosterTraceChunk* next = (FosterTraceChunk*)SDL_malloc(sizeof(FosterTraceChunk));
+		SDL_memset(next, 0, sizeof(FosterTraceChunk));
+		SDL_AtomicSetPtr(&chunk->next, next);
+		thread->last = chunk = next;
+		index = 0;
+	}
+
+	FosterTraceEvent* ev = &chunk->events[index];
+	FosterTraceCopyName(ev->name, name);
+	ev->start = start;
+	ev->end = end;
+	SDL_AtomicSet(&chunk->count, index + 1);
+}
+
+FosterBool FosterTraceEnabled()
+{
+	return 1;
+}
+
+void FosterTraceBegin(const char* name)
+{
+	FosterTraceThread* thread = FosterTraceGetThread();
+
+	// zones past the limit are still counted, so that they end in the right place
+	if (thread->depth < FOSTER_TRACE_MAX_DEPTH)
+	{
+		FosterTraceCopyName(thread->stackNames[thread->depth], name);
+		thread->stackStarts[thread->depth] = SDL_GetPerformanceCounter();
+	}
+	thread->depth++;
+}
+
+void FosterTraceEnd()
+{
+	FosterTraceThread* thread = FosterTraceGetThread();
+	if (thread->depth <= 0)
+		return;
+
+	thread->depth--;
+	if (thread->depth < FOSTER_TRACE_MAX_DEPTH)
+	{
+		FosterTraceRecord(
+			thread->stackNames[thread->depth],
+			thread->stackStarts[thread->depth],
+			SDL_GetPerformanceCounter());
+	}
+}
+
+void FosterTraceFlush(FosterWriteFn func, void* context)
+{
+	char buffer[FOSTER_TRACE_WRITE_BUFFER];
+	int length = 0;
+	double toMicroseconds = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+
+	length += SDL_snprintf(buffer + length, FOSTER_TRACE_WRITE_BUFFER - length, "[\n");
+
+	// only the events that had been published when they were reached are written,
+	// and fully flushed chunks are released once their thread has moved past them
+	FosterTraceThread* thread = (FosterTraceThread*)SDL_AtomicGetPtr(&ftraceThreads);
+	for (; thread != NULL; thread = thread->next)
+	{
+		while (1)
+		{
+			FosterTraceChunk* chunk = thread->first;
+			int count = SDL_AtomicGet(&chunk->count);
+
+			for (int i = thread->flushed; i < count; i ++)
+			{
+				FosterTraceEvent* ev = &chunk->events[i];
+
+				if (length > FOSTER_TRACE_WRITE_BUFFER - 256)
+				{
+					func(context, buffer, length);
+					length = 0;
+				}
+
+				length += SDL_snprintf(buffer + length, FOSTER_TRACE_WRITE_BUFFER - length,
+					"{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,\"ts\":%.3f,\"dur\":%.3f},\n",
+					ev->name,
+					(unsigned long)thread->id,
+					ev->start * toMicroseconds,
+					(ev->end - ev->start) * toMicroseconds);
+			}
+			thread->flushed = count;
+
+			FosterTraceChunk* next = (FosterTraceChunk*)SDL_AtomicGetPtr(&chunk->next);
+			if (count < FOSTER_TRACE_CHUNK_EVENTS || next == NULL)
+				break;
+
+			thread->first = next;
+			thread->flushed = 0;
+			SDL_free(chunk);
+		}
+	}
+
+	// events are all followed by a comma, so the array ends with metadata
+	length += SDL_snprintf(buffer + length, FOSTER_TRACE_WRITE_BUFFER - length,
+		"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Foster\"}}\n]\n");
+	func(context, buffer, length);
+}
+
+#else // FOSTER_TRACE_ENABLED
+
+FosterBool FosterTraceEnabled()
+{
+	return 0;
+}
+
+void FosterTraceBegin(const char* name)
+{
+
+}
+
+void FosterTraceEnd()
+{
+
+}
+
+void FosterTraceFlush(FosterWriteFn func, void* context)
+{
+
+}
+
+#endif
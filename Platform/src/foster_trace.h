@@ -0,0 +1,39 @@
+#ifndef FOSTER_TRACE_H
+#define FOSTER_TRACE_H
+
+// Tracing zones are compiled out entirely unless the Platform is built with
+// the FOSTER_TRACE CMake option. Zones are recorded either to Tracy, or to
+// per-thread buffers that are written out as Chrome Trace JSON with FosterTraceFlush.
+// Each zone needs its own block, as it declares a variable for the zone.
+
+#if defined(FOSTER_TRACE_ENABLED) && defined(FOSTER_TRACE_TRACY)
+
+#include <tracy/TracyC.h>
+
+#define FOSTER_TRACE_ZONE(name) TracyCZoneN(fosterTraceZone, name, 1)
+#define FOSTER_TRACE_ZONE_END() TracyCZoneEnd(fosterTraceZone)
+
+#elif defined(FOSTER_TRACE_ENABLED)
+
+#include <SDL.h>
+
+typedef struct FosterTraceZone
+{
+	const char* name;
+	Uint64 start;
+} FosterTraceZone;
+
+// records a zone that has ended to the calling thread's buffer
+void FosterTraceRecord(const char* name, Uint64 start, Uint64 end);
+
+#define FOSTER_TRACE_ZONE(name) FosterTraceZone fosterTraceZone = { name, SDL_GetPerformanceCounter() }
+#define FOSTER_TRACE_ZONE_END() FosterTraceRecord(fosterTraceZone.name, fosterTraceZone.start, SDL_GetPerformanceCounter())
+
+#else
+
+#define FOSTER_TRACE_ZONE(name)
+#define FOSTER_TRACE_ZONE_END()
+
+#endif
+
+#endif
@@ -0,0 +1,129 @@
+using Foster.Benchmarks;
+using Foster.Framework;
+
+namespace Foster.Tests;
+
+public static class AsepriteTests
+{
+	public static readonly (string Name, Action Test)[] All =
+	[
+		("Aseprite.LazyCelsMatchEagerCels", LazyCelsMatchEagerCels),
+		("Aseprite.DisposeAfterDecodeKeepsImages", DisposeAfterDecodeKeepsImages),
+		("Aseprite.DisposeBeforeLoadThrows", DisposeBeforeLoadThrows),
+		("Aseprite.DisposeDuringDecode", DisposeDuringDecode),
+	];
+
+	private const int Frames = 8;
+	private const int Layers = 4;
+	private static readonly byte[] data = SyntheticAssets.Aseprite(256, 256, Frames, Layers);
+	private static readonly Lazy<string> path = new(() =>
+	{
+		var path = Path.Combine(Path.GetTempPath(), $"foster-tests-{Environment.ProcessId}.ase");
+		File.WriteAllBytes(path, data);
+		AppDomain.CurrentDomain.ProcessExit += (_, _) => File.Delete(path);
+		return path;
+	});
+
+	/// <summary>
+	/// Opens from a real file, as its mapping is unmapped when disposed,
+	/// and so reading it after that is an access violation rather than stale memory
+	/// </summary>
+	private static Aseprite OpenLazy()
+		=> Aseprite.Open(path.Value);
+
+	private static void AssertSameImage(Image expected, Image actual, string what)
+	{
+		Assert.Equal(expected.Size, actual.Size, $"{what} size");
+		Assert.True(expected.Data.SequenceEqual(actual.Data), $"{what} pixels differ");
+	}
+
+	private static void LazyCelsMatchEagerCels()
+	{
+		var eager = new Aseprite(new MemoryStream(data));
+		using var lazy = OpenLazy();
+
+		Assert.Equal(Frames, lazy.Frames.Length, "Frame count");
+		for (int f = 0; f < Frames; f++)
+		{
+			Assert.Equal(Layers, lazy.Frames[f].Cels.Count, "Cel count");
+			for (int c = 0; c < Layers; c++)
+			{
+				Assert.True(!lazy.Frames[f].Cels[c].IsLoaded, "Cel was loaded before it was requested");
+				AssertSameImage(eager.Frames[f].Cels[c].Image!, lazy.Frames[f].Cels[c].Image!, $"Cel {f}:{c}");
+			}
+		}
+	}
+
+	private static void DisposeAfterDecodeKeepsImages()
+	{
+		var eager = new Aseprite(new MemoryStream(data));
+		var lazy = OpenLazy();
+		lazy.DecodeAsync().Wait();
+		lazy.Dispose();
+
+		for (int f = 0; f < Frames; f++)
+			for (int c = 0; c < Layers; c++)
+				AssertSameImage(eager.Frames[f].Cels[c].Image!, lazy.Frames[f].Cels[c].Image!, $"Cel {f}:{c}");
+	}
+
+	private static void DisposeBeforeLoadThrows()
+	{
+		var lazy = OpenLazy();
+		lazy.Dispose();
+
+		try
+		{
+			_ = lazy.Frames[0].Cels[0].Image;
+		}
+		catch (ObjectDisposedException)
+		{
+			return;
+		}
+
+		throw new AssertException("Loading a Cel after Dispose should throw ObjectDisposedException");
+	}
+
+	/// <summary>
+	/// Disposing while Cels are being decoded on other threads must let them finish reading
+	/// the mapped file, so each Cel either has its correct pixels or reports that it was disposed
+	/// </summary>
+	private static void DisposeDuringDecode()
+	{
+		var eager = new Aseprite(new MemoryStream(data));
+
+		for (int run = 0; run < 50; run++)
+		{
+			var lazy = OpenLazy();
+			var decode = lazy.DecodeAsync();
+			Thread.SpinWait(run * 20000);
+			lazy.Dispose();
+
+			try
+			{
+				decode.Wait();
+			}
+			catch (AggregateException e)
+			{
+				foreach (var inner in e.Flatten().InnerExceptions)
+					Assert.True(inner is ObjectDisposedException, $"Unexpected {inner.GetType().Name}: {inner.Message}");
+			}
+
+			for (int f = 0; f < Frames; f++)
+			for (int c = 0; c < Layers; c++)
+			{
+				var cel = lazy.Frames[f].Cels[c];
+				Image? image;
+				try
+				{
+					image = cel.Image;
+				}
+				catch (ObjectDisposedException)
+				{
+					continue;
+				}
+
+				AssertSameImage(eager.Frames[f].Cels[c].Image!, image!, $"Cel {f}:{c}");
+			}
+		}
+	}
+}
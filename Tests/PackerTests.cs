@@ -0,0 +1,102 @@
+using Foster.Framework;
+
+namespace Foster.Tests;
+
+public static class PackerTests
+{
+	public static readonly (string Name, Action Test)[] All =
+	[
+		("Packer.SkylineSourceAtMaxSizeThrows", SkylineSourceAtMaxSizeThrows),
+		("Packer.TreeSourceAtMaxSizeThrows", TreeSourceAtMaxSizeThrows),
+		("Packer.SkylineSourceFillingMaxSizePacks", SkylineSourceFillingMaxSizePacks),
+		("Packer.SkylineOverflowMakesPages", SkylineOverflowMakesPages),
+		("Packer.DifferentShapesAreNotDuplicates", DifferentShapesAreNotDuplicates),
+		("Packer.SamePixelsAreDuplicates", SamePixelsAreDuplicates),
+	];
+
+	private static Image Solid(int width, int height, Color color)
+		=> new(width, height, color);
+
+	/// <summary>
+	/// A source exactly MaxSize wide doesn't fit once its padding is added,
+	/// which used to make the Skyline method add empty pages forever
+	/// </summary>
+	private static void SkylineSourceAtMaxSizeThrows()
+	{
+		var packer = new Packer { Method = Packer.PackingMethod.Skyline, MaxSize = 64, Padding = 1 };
+		packer.Add("wide", Solid(64, 8, Color.Red));
+		Assert.Throws(() => packer.Pack(), "Packing a source as wide as MaxSize with padding should throw");
+
+		packer.Clear();
+		packer.Add("tall", Solid(8, 64, Color.Red));
+		Assert.Throws(() => packer.Pack(), "Packing a source as tall as MaxSize with padding should throw");
+	}
+
+	private static void TreeSourceAtMaxSizeThrows()
+	{
+		var packer = new Packer { Method = Packer.PackingMethod.Tree, MaxSize = 64, Padding = 1 };
+		packer.Add("wide", Solid(64, 8, Color.Red));
+		Assert.Throws(() => packer.Pack(), "Packing a source as wide as MaxSize with padding should throw");
+	}
+
+	private static void SkylineSourceFillingMaxSizePacks()
+	{
+		var packer = new Packer { Method = Packer.PackingMethod.Skyline, MaxSize = 64, Padding = 1 };
+		packer.Add("full", Solid(63, 63, Color.Red));
+		packer.Add("small", Solid(8, 8, Color.Blue));
+
+		var output = packer.Pack();
+		Assert.Equal(2, output.Pages.Count, "Page count");
+		Assert.Equal(2, output.Entries.Count, "Entry count");
+		foreach (var page in output.Pages)
+			Assert.True(page.Width <= 64 && page.Height <= 64, $"Page {page.Width}x{page.Height} is larger than MaxSize");
+	}
+
+	private static void SkylineOverflowMakesPages()
+	{
+		var packer = new Packer { Method = Packer.PackingMethod.Skyline, MaxSize = 64, Padding = 0 };
+		for (int i = 0; i < 20; i++)
+			packer.Add($"sprite{i}", Solid(32, 32, new Color((byte)i, 0, 0, 255)));
+
+		var output = packer.Pack();
+		Assert.Equal(5, output.Pages.Count, "Page count");
+		Assert.Equal(20, output.Entries.Count, "Entry count");
+	}
+
+	/// <summary>
+	/// Solid images of the same color used to hash the same regardless of their shape
+	/// </summary>
+	private static void DifferentShapesAreNotDuplicates()
+	{
+		foreach (var method in Enum.GetValues<Packer.PackingMethod>())
+		{
+			var packer = new Packer { Method = method, CombineDuplicates = true };
+			packer.Add("a", Solid(2, 8, Color.Red));
+			packer.Add("b", Solid(4, 4, Color.Red));
+			packer.Add("c", Solid(8, 2, Color.Red));
+
+			var output = packer.Pack();
+			Assert.Equal(3, output.Entries.Count, "Entry count");
+			foreach (var entry in output.Entries)
+			{
+				var expected = entry.Name switch { "a" => new Point2(2, 8), "b" => new Point2(4, 4), _ => new Point2(8, 2) };
+				Assert.Equal(expected, entry.Source.Size, $"Size of '{entry.Name}'");
+			}
+		}
+	}
+
+	private static void SamePixelsAreDuplicates()
+	{
+		var packer = new Packer { CombineDuplicates = true };
+		packer.Add("a", Solid(4, 4, Color.Red));
+		packer.Add("b", Solid(4, 4, Color.Red));
+		packer.Add("c", Solid(4, 4, Color.Blue));
+
+		var output = packer.Pack();
+		var a = output.Entries.First(it => it.Name == "a");
+		var b = output.Entries.First(it => it.Name == "b");
+		var c = output.Entries.First(it => it.Name == "c");
+		Assert.Equal(a.Source, b.Source, "Source of the duplicate");
+		Assert.True(a.Source != c.Source, "Different pixels should have their own Source");
+	}
+}
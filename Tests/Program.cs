@@ -0,0 +1,94 @@
+namespace Foster.Tests;
+
+/// <summary>
+/// Runs the Foster Tests, which don't need a window or renderer.
+/// Exits with a non-zero code if any of them fail.
+/// Usage: Foster.Tests [filter]
+/// </summary>
+public static class Program
+{
+	/// <summary>
+	/// How long a single Test may run before it's considered to have hung
+	/// </summary>
+	public static readonly TimeSpan Timeout = TimeSpan.FromSeconds(10);
+
+	public static int Main(string[] args)
+	{
+		var filter = args.Length > 0 ? args[0] : null;
+		int passed = 0, failed = 0;
+
+		foreach (var (name, test) in PackerTests.All.Concat(AsepriteTests.All))
+		{
+			if (filter != null && !name.Contains(filter, StringComparison.OrdinalIgnoreCase))
+				continue;
+
+			var task = Task.Run(test);
+			string? error = null;
+
+			try
+			{
+				if (!task.Wait(Timeout))
+					error = $"timed out after {Timeout.TotalSeconds}s";
+			}
+			catch (AggregateException e)
+			{
+				error = e.InnerException?.Message ?? e.Message;
+			}
+
+			if (error == null)
+			{
+				Console.WriteLine($"PASS {name}");
+				passed++;
+			}
+			else
+			{
+				Console.WriteLine($"FAIL {name}: {error}");
+				failed++;
+			}
+		}
+
+		Console.WriteLine($"{passed} passed, {failed} failed");
+
+		// a hung Test is still running, so don't wait for it to exit
+		Environment.Exit(failed > 0 ? 1 : 0);
+		return 0;
+	}
+}
+
+/// <summary>
+/// Thrown by a Test when what it checks doesn't hold
+/// </summary>
+public class AssertException(string message) : Exception(message) { }
+
+public static class Assert
+{
+	public static void True(bool condition, string message)
+	{
+		if (!condition)
+			throw new AssertException(message);
+	}
+
+	public static void Equal<T>(T expected, T actual, string what)
+	{
+		if (!EqualityComparer<T>.Default.Equals(expected, actual))
+			throw new AssertException($"{what}: expected {expected}, got {actual}");
+	}
+
+	public static void Throws(Action action, string message)
+	{
+		try
+		{
+			action();
+		}
+		catch (AssertException)
+		{
+			throw;
+		}
+		catch
+		{
+			return;
+		}
+
+		throw new AssertException(message);
+	}
+}